@@ -0,0 +1,335 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <regex>
+#include <thread>
+
+#include "scl/util/measurement.h"
+
+using namespace scl;
+
+namespace {
+
+std::atomic<std::size_t> g_allocation_count{0};
+std::atomic<std::size_t> g_allocation_bytes{0};
+
+void countAllocation(std::size_t size) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  g_allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+#if defined(__GLIBC__)
+
+// Interpose the C allocation functions so that every allocation is counted,
+// regardless of whether it goes through operator new, GMP or plain malloc. The
+// aligned variants are needed as well, since std::pmr::new_delete_resource
+// (used by the containers in scl::math by default) allocates with aligned new.
+
+extern "C" {
+
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t n, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void __libc_free(void* ptr);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+
+void* malloc(std::size_t size) noexcept {
+  countAllocation(size);
+  return __libc_malloc(size);
+}
+
+void* calloc(std::size_t n, std::size_t size) noexcept {
+  countAllocation(n * size);
+  return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, std::size_t size) noexcept {
+  countAllocation(size);
+  return __libc_realloc(ptr, size);
+}
+
+void* memalign(std::size_t alignment, std::size_t size) noexcept {
+  countAllocation(size);
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+  countAllocation(size);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr,
+                   std::size_t alignment,
+                   std::size_t size) noexcept {
+  countAllocation(size);
+  *ptr = __libc_memalign(alignment, size);
+  return *ptr == nullptr ? ENOMEM : 0;
+}
+
+void free(void* ptr) noexcept {
+  __libc_free(ptr);
+}
+
+}  // extern "C"
+
+#endif  // defined(__GLIBC__)
+
+std::size_t bench::allocationCount() {
+  return g_allocation_count.load(std::memory_order_relaxed);
+}
+
+std::size_t bench::allocationBytes() {
+  return g_allocation_bytes.load(std::memory_order_relaxed);
+}
+
+std::vector<bench::Benchmark>& bench::registry() {
+  static std::vector<bench::Benchmark> benchmarks;
+  return benchmarks;
+}
+
+bool bench::registerBenchmark(const std::string& name,
+                              const std::vector<std::int64_t>& args,
+                              const std::function<void(State&)>& body) {
+  registry().emplace_back(Benchmark{name, args, body});
+  return true;
+}
+
+namespace {
+
+// Find a number of iterations such that a single run takes at least min_time.
+std::size_t calibrate(const bench::Benchmark& benchmark,
+                      std::int64_t arg,
+                      std::chrono::nanoseconds min_time) {
+  constexpr std::size_t max_iterations = 1000000000;
+
+  std::size_t iterations = 1;
+  while (true) {
+    bench::State state(arg, iterations);
+    benchmark.body(state);
+    const auto elapsed = state.elapsed();
+
+    if (elapsed >= min_time || iterations >= max_iterations) {
+      return iterations;
+    }
+
+    // aim a bit higher than min_time, but grow at most 10x per step since
+    // timings of short runs are unreliable.
+    const long double ratio =
+        elapsed.count() > 0
+            ? 1.4L * min_time.count() / static_cast<long double>(elapsed.count())
+            : 10.0L;
+    const auto next = static_cast<std::size_t>(
+        iterations * std::clamp(ratio, 2.0L, 10.0L));
+    iterations = std::min(next, max_iterations);
+  }
+}
+
+std::string fullName(const bench::Benchmark& benchmark, std::int64_t arg) {
+  std::string name = benchmark.name;
+  if (!benchmark.args.empty()) {
+    name.append("/");
+    name.append(std::to_string(arg));
+  }
+  return name;
+}
+
+bench::Result runBenchmark(const bench::Benchmark& benchmark,
+                           std::int64_t arg,
+                           const bench::RunOptions& options) {
+  bench::Result result;
+  result.name = fullName(benchmark, arg);
+  result.arg = arg;
+  result.iterations = calibrate(benchmark, arg, options.min_time);
+
+  std::size_t allocations = 0;
+  std::size_t allocated_bytes = 0;
+  const auto repetitions = std::max<std::size_t>(options.repetitions, 1);
+
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    bench::State state(arg, result.iterations);
+    benchmark.body(state);
+
+    const long double ns = state.elapsed().count();
+    result.ns_per_op.emplace_back(ns / result.iterations);
+    result.bytes_per_op = state.bytesPerOp();
+    result.items_per_op = state.itemsPerOp();
+    allocations += state.allocations();
+    allocated_bytes += state.allocatedBytes();
+  }
+
+  const long double ops = result.iterations * repetitions;
+  result.allocs_per_op = allocations / ops;
+  result.alloc_bytes_per_op = allocated_bytes / ops;
+  return result;
+}
+
+util::Measurement<long double> toMeasurement(const bench::Result& result) {
+  util::Measurement<long double> m;
+  for (const auto v : result.ns_per_op) {
+    m.addSample(v);
+  }
+  return m;
+}
+
+// operations per second, as computed from the median time per op.
+long double perSecond(long double ns_per_op, std::size_t per_op) {
+  if (ns_per_op <= 0) {
+    return 0;
+  }
+  return per_op * 1e9L / ns_per_op;
+}
+
+std::string cpuModel() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.starts_with("model name")) {
+      const auto colon = line.find(':');
+      if (colon != std::string::npos && colon + 2 <= line.size()) {
+        return line.substr(colon + 2);
+      }
+    }
+  }
+  return "unknown";
+}
+
+std::string hostName() {
+  char buf[256] = {0};
+  if (gethostname(buf, sizeof(buf) - 1) != 0) {
+    return "unknown";
+  }
+  return buf;
+}
+
+// benchmark names and host information are the only free form strings we
+// output. Escape them, just in case.
+std::string jsonEscape(const std::string& str) {
+  std::string out;
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+    }
+    out += c;
+  }
+  return out;
+}
+
+}  // namespace
+
+std::vector<bench::Result> bench::runBenchmarks(
+    const RunOptions& options,
+    const std::function<void(const Result&)>& on_result) {
+  const std::regex filter(options.filter);
+  std::vector<Result> results;
+
+  for (const auto& benchmark : registry()) {
+    std::vector<std::int64_t> args = benchmark.args;
+    if (args.empty()) {
+      args.emplace_back(0);
+    }
+
+    for (const auto arg : args) {
+      if (!std::regex_search(fullName(benchmark, arg), filter)) {
+        continue;
+      }
+
+      results.emplace_back(runBenchmark(benchmark, arg, options));
+      on_result(results.back());
+    }
+  }
+
+  return results;
+}
+
+void bench::writeText(std::ostream& stream, const Result& result) {
+  const auto m = toMeasurement(result);
+  const auto median = m.median();
+
+  stream << std::left << std::setw(40) << result.name << std::right
+         << std::fixed << std::setprecision(1) << std::setw(14) << median
+         << " ns/op" << std::setw(10) << m.stddev() << " sd";
+
+  if (result.bytes_per_op > 0) {
+    const auto mbps = perSecond(median, result.bytes_per_op) / (1 << 20);
+    stream << std::setw(12) << mbps << " MiB/s";
+  }
+  if (result.items_per_op > 0) {
+    const auto ips = perSecond(median, result.items_per_op);
+    stream << std::setw(14) << std::setprecision(0) << ips << " items/s";
+  }
+
+  stream << std::setprecision(2) << std::setw(10) << result.allocs_per_op
+         << " allocs/op" << std::defaultfloat << "\n";
+}
+
+void bench::writeJsonContext(std::ostream& stream) {
+  stream << "{"
+         << "\"host\": \"" << jsonEscape(hostName()) << "\", "
+         << "\"cpu\": \"" << jsonEscape(cpuModel()) << "\", "
+         << "\"num_cpus\": " << std::thread::hardware_concurrency() << "}";
+}
+
+void bench::writeJson(std::ostream& stream, const std::vector<Result>& results) {
+  stream << std::setprecision(std::numeric_limits<double>::max_digits10);
+  stream << "{\n"
+         << "  \"context\": ";
+  writeJsonContext(stream);
+  stream << ",\n"
+         << "  \"benchmarks\": [";
+
+  bool first = true;
+  for (const auto& result : results) {
+    const auto m = toMeasurement(result);
+    const auto median = m.median();
+
+    stream << (first ? "\n" : ",\n") << "    {"
+           << "\"name\": \"" << jsonEscape(result.name) << "\", "
+           << "\"arg\": " << result.arg << ", "
+           << "\"iterations\": " << result.iterations << ", "
+           << "\"ns_per_op\": {"
+           << "\"median\": " << median << ", "
+           << "\"mean\": " << m.mean() << ", "
+           << "\"min\": " << *std::min_element(m.begin(), m.end()) << ", "
+           << "\"std_dev\": " << m.stddev() << ", "
+           << "\"samples\": [";
+    for (std::size_t i = 0; i < result.ns_per_op.size(); ++i) {
+      stream << (i ? ", " : "") << result.ns_per_op[i];
+    }
+    stream << "]}, "
+           << "\"bytes_per_second\": "
+           << perSecond(median, result.bytes_per_op) << ", "
+           << "\"items_per_second\": "
+           << perSecond(median, result.items_per_op) << ", "
+           << "\"allocs_per_op\": " << result.allocs_per_op << ", "
+           << "\"alloc_bytes_per_op\": " << result.alloc_bytes_per_op << "}";
+    first = false;
+  }
+
+  stream << "\n  ]\n}\n";
+}
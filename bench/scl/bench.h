@@ -0,0 +1,340 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCH_SCL_BENCH_H
+#define BENCH_SCL_BENCH_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace scl::bench {
+
+/**
+ * @brief Number of heap allocations performed by the process so far.
+ *
+ * Allocations are counted by interposing the allocation functions of the C
+ * library, so this includes allocations made through <code>new</code>, GMP
+ * and Packet. On platforms where this is not possible the count is always 0.
+ */
+std::size_t allocationCount();
+
+/**
+ * @brief Number of bytes requested through heap allocations so far.
+ */
+std::size_t allocationBytes();
+
+/**
+ * @brief State of a single benchmark run.
+ *
+ * A benchmark body sets up its inputs and then runs the code it wants to
+ * measure in a loop controlled by the state:
+ *
+ * @code
+ * SCL_BENCHMARK("Thing/op", 16, 64) {
+ *   auto input = makeInput(state.arg());
+ *   while (state.run()) {
+ *     bench::doNotOptimize(op(input));
+ *   }
+ *   state.setBytesPerOp(input.size());
+ * }
+ * @endcode
+ *
+ * Only the time spent inside the loop is measured. Likewise for allocations.
+ */
+class State {
+ public:
+  /**
+   * @brief Create a new benchmark state.
+   * @param arg the argument of the benchmark.
+   * @param iterations the number of iterations to run.
+   */
+  State(std::int64_t arg, std::size_t iterations)
+      : m_arg(arg), m_iterations(iterations), m_remaining(iterations) {}
+
+  /**
+   * @brief The argument the benchmark is run with.
+   */
+  std::int64_t arg() const {
+    return m_arg;
+  }
+
+  /**
+   * @brief The number of iterations of the benchmark loop.
+   */
+  std::size_t iterations() const {
+    return m_iterations;
+  }
+
+  /**
+   * @brief Advance the benchmark loop.
+   * @return true if another iteration should be run, false otherwise.
+   */
+  bool run() {
+    if (m_remaining == m_iterations) {
+      start();
+    }
+    if (m_remaining == 0) {
+      stop();
+      return false;
+    }
+    --m_remaining;
+    return true;
+  }
+
+  /**
+   * @brief Set the number of bytes processed by a single operation.
+   *
+   * Setting this causes a throughput in bytes per second to be reported.
+   */
+  void setBytesPerOp(std::size_t bytes) {
+    m_bytes_per_op = bytes;
+  }
+
+  /**
+   * @brief Set the number of items processed by a single operation.
+   *
+   * Setting this causes a throughput in items per second to be reported.
+   */
+  void setItemsPerOp(std::size_t items) {
+    m_items_per_op = items;
+  }
+
+  /**
+   * @brief Time spent in the benchmark loop.
+   */
+  std::chrono::nanoseconds elapsed() const {
+    return m_elapsed;
+  }
+
+  /**
+   * @brief Number of allocations performed in the benchmark loop.
+   */
+  std::size_t allocations() const {
+    return m_allocations;
+  }
+
+  /**
+   * @brief Number of bytes allocated in the benchmark loop.
+   */
+  std::size_t allocatedBytes() const {
+    return m_allocated_bytes;
+  }
+
+  /**
+   * @brief Bytes processed per operation, or 0 if not set.
+   */
+  std::size_t bytesPerOp() const {
+    return m_bytes_per_op;
+  }
+
+  /**
+   * @brief Items processed per operation, or 0 if not set.
+   */
+  std::size_t itemsPerOp() const {
+    return m_items_per_op;
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  void start() {
+    m_allocations = allocationCount();
+    m_allocated_bytes = allocationBytes();
+    m_start = Clock::now();
+  }
+
+  void stop() {
+    const auto end = Clock::now();
+    m_elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_start);
+    m_allocations = allocationCount() - m_allocations;
+    m_allocated_bytes = allocationBytes() - m_allocated_bytes;
+  }
+
+  std::int64_t m_arg;
+  std::size_t m_iterations;
+  std::size_t m_remaining;
+
+  std::size_t m_bytes_per_op = 0;
+  std::size_t m_items_per_op = 0;
+
+  Clock::time_point m_start;
+  std::chrono::nanoseconds m_elapsed{0};
+  std::size_t m_allocations = 0;
+  std::size_t m_allocated_bytes = 0;
+};
+
+/**
+ * @brief Prevent the compiler from optimizing away a value.
+ */
+template <typename T>
+void doNotOptimize(const T& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+/**
+ * @brief A registered benchmark.
+ */
+struct Benchmark {
+  /**
+   * @brief The name of the benchmark.
+   */
+  std::string name;
+
+  /**
+   * @brief The arguments the benchmark should be run with.
+   *
+   * If empty, the benchmark is run once with an argument of 0.
+   */
+  std::vector<std::int64_t> args;
+
+  /**
+   * @brief The benchmark body.
+   */
+  std::function<void(State&)> body;
+};
+
+/**
+ * @brief Get all registered benchmarks.
+ */
+std::vector<Benchmark>& registry();
+
+/**
+ * @brief Register a benchmark.
+ * @return always true. Used to register benchmarks at static init time.
+ */
+bool registerBenchmark(const std::string& name,
+                       const std::vector<std::int64_t>& args,
+                       const std::function<void(State&)>& body);
+
+/**
+ * @brief Options controlling how benchmarks are run.
+ */
+struct RunOptions {
+  /**
+   * @brief Regular expression that benchmark names must match.
+   */
+  std::string filter = "";
+
+  /**
+   * @brief Minimum time each repetition should run for.
+   */
+  std::chrono::milliseconds min_time{100};
+
+  /**
+   * @brief The number of repetitions of each benchmark.
+   */
+  std::size_t repetitions = 5;
+};
+
+/**
+ * @brief The result of running a benchmark with a particular argument.
+ */
+struct Result {
+  /**
+   * @brief Name of the benchmark, including the argument if any.
+   */
+  std::string name;
+
+  /**
+   * @brief The argument of the benchmark.
+   */
+  std::int64_t arg;
+
+  /**
+   * @brief Number of iterations per repetition.
+   */
+  std::size_t iterations;
+
+  /**
+   * @brief Nanoseconds per operation of each repetition.
+   */
+  std::vector<long double> ns_per_op;
+
+  /**
+   * @brief Bytes processed per operation, or 0.
+   */
+  std::size_t bytes_per_op;
+
+  /**
+   * @brief Items processed per operation, or 0.
+   */
+  std::size_t items_per_op;
+
+  /**
+   * @brief Average number of allocations per operation.
+   */
+  long double allocs_per_op;
+
+  /**
+   * @brief Average number of bytes allocated per operation.
+   */
+  long double alloc_bytes_per_op;
+};
+
+/**
+ * @brief Run all registered benchmarks matching the options.
+ * @param options the options.
+ * @param on_result callback invoked after each benchmark finishes.
+ * @return the results.
+ */
+std::vector<Result> runBenchmarks(
+    const RunOptions& options,
+    const std::function<void(const Result&)>& on_result);
+
+/**
+ * @brief Write a result in a human readable format.
+ */
+void writeText(std::ostream& stream, const Result& result);
+
+/**
+ * @brief Write information about the machine running the benchmarks as JSON.
+ */
+void writeJsonContext(std::ostream& stream);
+
+/**
+ * @brief Write a list of results as JSON.
+ */
+void writeJson(std::ostream& stream, const std::vector<Result>& results);
+
+}  // namespace scl::bench
+
+#define SCL_BENCH_CONCAT_(a, b) a##b
+#define SCL_BENCH_CONCAT(a, b) SCL_BENCH_CONCAT_(a, b)
+
+#define SCL_BENCH_REGISTER(fn, name, ...)                                   \
+  static void fn(scl::bench::State&);                                       \
+  [[maybe_unused]] static const bool SCL_BENCH_CONCAT(fn, _registered) =    \
+      scl::bench::registerBenchmark(name, {__VA_ARGS__}, fn);               \
+  static void fn([[maybe_unused]] scl::bench::State& state)
+
+/**
+ * @brief Define a benchmark.
+ *
+ * The first argument is the name of the benchmark. Any remaining arguments
+ * are integer arguments the benchmark is run with, available through
+ * <code>state.arg()</code>.
+ */
+#define SCL_BENCHMARK(name, ...) \
+  SCL_BENCH_REGISTER(SCL_BENCH_CONCAT(scl_bench_, __LINE__), name, __VA_ARGS__)
+
+#endif  // BENCH_SCL_BENCH_H
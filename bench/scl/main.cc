@@ -0,0 +1,82 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include "bench.h"
+#include "scl/util/cmdline.h"
+
+using namespace scl;
+
+int main(int argc, char* argv[]) {
+  const auto opts =
+      util::ProgramOptions::Parser("Microbenchmarks for SCL.")
+          .add(util::ProgramArg::optional("filter",
+                                          "regex",
+                                          "",
+                                          "only run benchmarks matching regex"))
+          .add(util::ProgramArg::optional("min_time",
+                                          "ms",
+                                          "100",
+                                          "minimum time per repetition"))
+          .add(util::ProgramArg::optional("repetitions",
+                                          "int",
+                                          "5",
+                                          "repetitions of each benchmark"))
+          .add(util::ProgramArg::optional("json",
+                                          "file",
+                                          "",
+                                          "write results as JSON to file"))
+          .add(util::ProgramFlag("list", "list benchmarks and exit"))
+          .parse(argc, argv);
+
+  if (opts.flagSet("list")) {
+    for (const auto& benchmark : bench::registry()) {
+      std::cout << benchmark.name;
+      for (const auto arg : benchmark.args) {
+        std::cout << " " << arg;
+      }
+      std::cout << "\n";
+    }
+    return 0;
+  }
+
+  bench::RunOptions options;
+  options.filter = opts.get("filter");
+  options.min_time = std::chrono::milliseconds(opts.get<int>("min_time"));
+  options.repetitions = opts.get<std::size_t>("repetitions");
+
+  const auto results =
+      bench::runBenchmarks(options, [](const bench::Result& result) {
+        bench::writeText(std::cerr, result);
+      });
+
+  const auto json = opts.get("json");
+  if (json.empty()) {
+    return 0;
+  }
+
+  if (json == "-") {
+    bench::writeJson(std::cout, results);
+  } else {
+    std::ofstream file{std::string(json)};
+    bench::writeJson(file, results);
+  }
+
+  return 0;
+}
@@ -0,0 +1,75 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+#include "scl/math/array.h"
+#include "scl/math/array_vector.h"
+#include "scl/math/fp.h"
+#include "scl/math/vector.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+using FF = math::Fp<61>;
+using AoS = math::Vector<math::Array<FF, 2>>;
+using SoA = math::ArrayVector<FF, 2>;
+
+}  // namespace
+
+SCL_BENCHMARK("ArrayVector/add/aos", 1024, 1 << 16) {
+  auto prg = util::PRG::create("bench array vector add");
+  auto x = AoS::random(state.arg(), prg);
+  const auto y = AoS::random(state.arg(), prg);
+  while (state.run()) {
+    bench::doNotOptimize(x.addInPlace(y));
+  }
+  state.setItemsPerOp(state.arg());
+}
+
+SCL_BENCHMARK("ArrayVector/add/soa", 1024, 1 << 16) {
+  auto prg = util::PRG::create("bench array vector add");
+  auto x = SoA::random(state.arg(), prg);
+  const auto y = SoA::random(state.arg(), prg);
+  while (state.run()) {
+    bench::doNotOptimize(x.addInPlace(y));
+  }
+  state.setItemsPerOp(state.arg());
+}
+
+SCL_BENCHMARK("ArrayVector/first_entries/aos", 1024, 1 << 16) {
+  auto prg = util::PRG::create("bench array vector entries");
+  const auto x = AoS::random(state.arg(), prg);
+  while (state.run()) {
+    math::Vector<FF> entries(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      entries[i] = x[i][0];
+    }
+    bench::doNotOptimize(entries.sum());
+  }
+  state.setItemsPerOp(state.arg());
+}
+
+SCL_BENCHMARK("ArrayVector/first_entries/soa", 1024, 1 << 16) {
+  auto prg = util::PRG::create("bench array vector entries");
+  const auto x = SoA::random(state.arg(), prg);
+  while (state.run()) {
+    bench::doNotOptimize(x.lane(0).sum());
+  }
+  state.setItemsPerOp(state.arg());
+}
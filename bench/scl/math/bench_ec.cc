@@ -0,0 +1,153 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+#include "scl/math/affine_point.h"
+#include "scl/math/curves/secp256k1.h"
+#include "scl/math/ec.h"
+#include "scl/math/number.h"
+#include "scl/math/vector.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+using Curve = math::EC<math::ec::Secp256k1>;
+using Scalar = Curve::ScalarField;
+using Affine = math::AffinePoint<math::ec::Secp256k1>;
+
+}  // namespace
+
+SCL_BENCHMARK("EC/Secp256k1/add") {
+  auto prg = util::PRG::create("bench ec add");
+  auto a = Curve::generator() * Scalar::random(prg);
+  const auto b = Curve::generator() * Scalar::random(prg);
+  while (state.run()) {
+    a += b;
+    bench::doNotOptimize(a);
+  }
+  state.setItemsPerOp(1);
+}
+
+SCL_BENCHMARK("EC/Secp256k1/double") {
+  auto prg = util::PRG::create("bench ec double");
+  auto a = Curve::generator() * Scalar::random(prg);
+  while (state.run()) {
+    a += a;
+    bench::doNotOptimize(a);
+  }
+  state.setItemsPerOp(1);
+}
+
+SCL_BENCHMARK("EC/Secp256k1/scalar_multiply") {
+  auto prg = util::PRG::create("bench ec scalar multiply");
+  const auto p = Curve::generator() * Scalar::random(prg);
+  const auto s = Scalar::random(prg);
+  while (state.run()) {
+    bench::doNotOptimize(p * s);
+  }
+  state.setItemsPerOp(1);
+}
+
+SCL_BENCHMARK("EC/Secp256k1/scalar_multiply_number") {
+  auto prg = util::PRG::create("bench ec scalar multiply number");
+  const auto p = Curve::generator() * Scalar::random(prg);
+  const auto s = math::Number::random(Scalar::bitSize(), prg);
+  while (state.run()) {
+    bench::doNotOptimize(p * s);
+  }
+  state.setItemsPerOp(1);
+}
+
+SCL_BENCHMARK("EC/Secp256k1/scalar_multiply_affine") {
+  auto prg = util::PRG::create("bench ec scalar multiply affine");
+  auto p = Curve::generator() * Scalar::random(prg);
+  p.normalize();
+  const auto s = Scalar::random(prg);
+  while (state.run()) {
+    bench::doNotOptimize(p * s);
+  }
+  state.setItemsPerOp(1);
+}
+
+SCL_BENCHMARK("EC/Secp256k1/sum", 1024) {
+  auto prg = util::PRG::create("bench ec sum");
+  math::Vector<Curve> points(state.arg());
+  for (auto& p : points) {
+    p = Curve::generator() * Scalar::random(prg);
+  }
+  while (state.run()) {
+    Curve sum;
+    for (const auto& p : points) {
+      sum += p;
+    }
+    bench::doNotOptimize(sum);
+  }
+  state.setItemsPerOp(state.arg());
+}
+
+SCL_BENCHMARK("EC/Secp256k1/sum_affine", 1024) {
+  auto prg = util::PRG::create("bench ec sum");
+  math::Vector<Curve> points(state.arg());
+  for (auto& p : points) {
+    p = Curve::generator() * Scalar::random(prg);
+  }
+  const auto affine = Affine::normalize(points);
+  while (state.run()) {
+    Curve sum;
+    for (const auto& p : affine) {
+      sum += p;
+    }
+    bench::doNotOptimize(sum);
+  }
+  state.setItemsPerOp(state.arg());
+}
+
+SCL_BENCHMARK("EC/Secp256k1/normalize", 1024) {
+  auto prg = util::PRG::create("bench ec normalize");
+  math::Vector<Curve> points(state.arg());
+  for (auto& p : points) {
+    p = Curve::generator() * Scalar::random(prg);
+  }
+  while (state.run()) {
+    bench::doNotOptimize(Affine::normalize(points));
+  }
+  state.setItemsPerOp(state.arg());
+}
+
+SCL_BENCHMARK("EC/Secp256k1/write_compressed") {
+  auto prg = util::PRG::create("bench ec write");
+  const auto p = Curve::generator() * Scalar::random(prg);
+  std::vector<unsigned char> buf(Curve::byteSize(true));
+  while (state.run()) {
+    p.write(buf.data(), true);
+    bench::doNotOptimize(buf);
+  }
+  state.setBytesPerOp(buf.size());
+}
+
+SCL_BENCHMARK("EC/Secp256k1/read_compressed") {
+  auto prg = util::PRG::create("bench ec read");
+  const auto p = Curve::generator() * Scalar::random(prg);
+  std::vector<unsigned char> buf(Curve::byteSize(true));
+  p.write(buf.data(), true);
+  while (state.run()) {
+    bench::doNotOptimize(Curve::read(buf.data()));
+  }
+  state.setBytesPerOp(buf.size());
+}
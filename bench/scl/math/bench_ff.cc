@@ -0,0 +1,158 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+#include "scl/math/fields/secp256k1_field.h"
+#include "scl/math/fields/secp256k1_scalar.h"
+#include "scl/math/fp.h"
+#include "scl/math/vector.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+using Mersenne61 = math::Fp<61>;
+using Mersenne127 = math::Fp<127>;
+using Secp256k1Field = math::FF<math::ff::Secp256k1Field>;
+using Secp256k1Scalar = math::FF<math::ff::Secp256k1Scalar>;
+
+template <typename FF>
+void add(bench::State& state) {
+  auto prg = util::PRG::create("bench ff add");
+  auto a = FF::random(prg);
+  const auto b = FF::random(prg);
+  while (state.run()) {
+    a += b;
+    bench::doNotOptimize(a);
+  }
+  state.setItemsPerOp(1);
+}
+
+template <typename FF>
+void multiply(bench::State& state) {
+  auto prg = util::PRG::create("bench ff multiply");
+  auto a = FF::random(prg);
+  const auto b = FF::random(prg);
+  while (state.run()) {
+    a *= b;
+    bench::doNotOptimize(a);
+  }
+  state.setItemsPerOp(1);
+}
+
+template <typename FF>
+void inverse(bench::State& state) {
+  auto prg = util::PRG::create("bench ff inverse");
+  auto a = FF::random(prg);
+  while (state.run()) {
+    a = a.inverse();
+    bench::doNotOptimize(a);
+  }
+  state.setItemsPerOp(1);
+}
+
+template <typename FF>
+void dot(bench::State& state) {
+  auto prg = util::PRG::create("bench ff dot");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto x = math::Vector<FF>::random(n, prg);
+  const auto y = math::Vector<FF>::random(n, prg);
+  while (state.run()) {
+    bench::doNotOptimize(x.dot(y));
+  }
+  state.setItemsPerOp(n);
+  state.setBytesPerOp(2 * n * FF::byteSize());
+}
+
+template <typename FF>
+void serialize(bench::State& state) {
+  auto prg = util::PRG::create("bench ff serialize");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto x = math::Vector<FF>::random(n, prg);
+  std::vector<unsigned char> buf(n * FF::byteSize());
+  while (state.run()) {
+    for (std::size_t i = 0; i < n; ++i) {
+      x[i].write(buf.data() + i * FF::byteSize());
+    }
+    bench::doNotOptimize(buf);
+  }
+  state.setItemsPerOp(n);
+  state.setBytesPerOp(buf.size());
+}
+
+}  // namespace
+
+SCL_BENCHMARK("FF/Mersenne61/add") {
+  add<Mersenne61>(state);
+}
+
+SCL_BENCHMARK("FF/Mersenne61/multiply") {
+  multiply<Mersenne61>(state);
+}
+
+SCL_BENCHMARK("FF/Mersenne61/inverse") {
+  inverse<Mersenne61>(state);
+}
+
+SCL_BENCHMARK("FF/Mersenne61/dot", 16, 1024, 65536) {
+  dot<Mersenne61>(state);
+}
+
+SCL_BENCHMARK("FF/Mersenne61/write", 1024) {
+  serialize<Mersenne61>(state);
+}
+
+SCL_BENCHMARK("FF/Mersenne127/add") {
+  add<Mersenne127>(state);
+}
+
+SCL_BENCHMARK("FF/Mersenne127/multiply") {
+  multiply<Mersenne127>(state);
+}
+
+SCL_BENCHMARK("FF/Mersenne127/inverse") {
+  inverse<Mersenne127>(state);
+}
+
+SCL_BENCHMARK("FF/Mersenne127/dot", 16, 1024, 65536) {
+  dot<Mersenne127>(state);
+}
+
+SCL_BENCHMARK("FF/Secp256k1Field/add") {
+  add<Secp256k1Field>(state);
+}
+
+SCL_BENCHMARK("FF/Secp256k1Field/multiply") {
+  multiply<Secp256k1Field>(state);
+}
+
+SCL_BENCHMARK("FF/Secp256k1Field/inverse") {
+  inverse<Secp256k1Field>(state);
+}
+
+SCL_BENCHMARK("FF/Secp256k1Scalar/add") {
+  add<Secp256k1Scalar>(state);
+}
+
+SCL_BENCHMARK("FF/Secp256k1Scalar/multiply") {
+  multiply<Secp256k1Scalar>(state);
+}
+
+SCL_BENCHMARK("FF/Secp256k1Scalar/inverse") {
+  inverse<Secp256k1Scalar>(state);
+}
@@ -0,0 +1,153 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+#include "scl/math/fp.h"
+#include "scl/math/matrix.h"
+#include "scl/math/vector.h"
+#include "scl/util/arena.h"
+#include "scl/util/parallel.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+using FF = math::Fp<61>;
+
+}  // namespace
+
+SCL_BENCHMARK("Matrix/multiply", 8, 32, 128) {
+  auto prg = util::PRG::create("bench matrix multiply");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto a = math::Matrix<FF>::random(n, n, prg);
+  const auto b = math::Matrix<FF>::random(n, n, prg);
+  while (state.run()) {
+    bench::doNotOptimize(a.multiply(b));
+  }
+  state.setItemsPerOp(n * n * n);
+}
+
+SCL_BENCHMARK("Matrix/multiply_vector", 32, 256, 1024) {
+  auto prg = util::PRG::create("bench matrix multiply vector");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto a = math::Matrix<FF>::random(n, n, prg);
+  const auto v = math::Vector<FF>::random(n, prg);
+  while (state.run()) {
+    bench::doNotOptimize(a.multiply(v));
+  }
+  state.setItemsPerOp(n * n);
+}
+
+SCL_BENCHMARK("Matrix/multiply_vector/par", 256, 1024, 4096) {
+  auto prg = util::PRG::create("bench matrix multiply vector");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto a = math::Matrix<FF>::random(n, n, prg);
+  const auto v = math::Vector<FF>::random(n, prg);
+  while (state.run()) {
+    bench::doNotOptimize(a.multiply(v, util::par));
+  }
+  state.setItemsPerOp(n * n);
+}
+
+SCL_BENCHMARK("Matrix/hyper_invertible", 8, 32) {
+  const auto n = static_cast<std::size_t>(state.arg());
+  while (state.run()) {
+    bench::doNotOptimize(math::Matrix<FF>::hyperInvertible(n, n));
+  }
+}
+
+SCL_BENCHMARK("Vector/add", 1024, 65536) {
+  auto prg = util::PRG::create("bench vector add");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto x = math::Vector<FF>::random(n, prg);
+  const auto y = math::Vector<FF>::random(n, prg);
+  while (state.run()) {
+    bench::doNotOptimize(x.add(y));
+  }
+  state.setItemsPerOp(n);
+  state.setBytesPerOp(2 * n * FF::byteSize());
+}
+
+SCL_BENCHMARK("Vector/add/par", 65536, 1 << 22) {
+  auto prg = util::PRG::create("bench vector add");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto x = math::Vector<FF>::random(n, prg);
+  const auto y = math::Vector<FF>::random(n, prg);
+  while (state.run()) {
+    bench::doNotOptimize(x.add(y, util::par));
+  }
+  state.setItemsPerOp(n);
+  state.setBytesPerOp(2 * n * FF::byteSize());
+}
+
+SCL_BENCHMARK("Vector/dot", 65536, 1 << 22) {
+  auto prg = util::PRG::create("bench vector dot");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto x = math::Vector<FF>::random(n, prg);
+  const auto y = math::Vector<FF>::random(n, prg);
+  while (state.run()) {
+    bench::doNotOptimize(x.dot(y));
+  }
+  state.setItemsPerOp(n);
+}
+
+SCL_BENCHMARK("Vector/dot/par", 65536, 1 << 22) {
+  auto prg = util::PRG::create("bench vector dot");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto x = math::Vector<FF>::random(n, prg);
+  const auto y = math::Vector<FF>::random(n, prg);
+  while (state.run()) {
+    bench::doNotOptimize(x.dot(y, util::par));
+  }
+  state.setItemsPerOp(n);
+}
+
+SCL_BENCHMARK("Vector/random/par", 65536, 1 << 22) {
+  auto prg = util::PRG::create("bench vector random");
+  const auto n = static_cast<std::size_t>(state.arg());
+  while (state.run()) {
+    bench::doNotOptimize(math::Vector<FF>::random(n, prg, util::par));
+  }
+  state.setItemsPerOp(n);
+}
+
+// a few operations on temporaries, like in a round of a protocol.
+SCL_BENCHMARK("Vector/round", 1024, 65536) {
+  auto prg = util::PRG::create("bench vector round");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto x = math::Vector<FF>::random(n, prg);
+  const auto y = math::Vector<FF>::random(n, prg);
+  while (state.run()) {
+    bench::doNotOptimize(x.add(y).multiplyEntryWise(y).subtract(x));
+  }
+  state.setItemsPerOp(n);
+}
+
+SCL_BENCHMARK("Vector/round_arena", 1024, 65536) {
+  auto prg = util::PRG::create("bench vector round");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto x = math::Vector<FF>::random(n, prg);
+  const auto y = math::Vector<FF>::random(n, prg);
+  util::Arena arena;
+  while (state.run()) {
+    const math::Vector<FF> xa(x, &arena);
+    bench::doNotOptimize(xa.add(y).multiplyEntryWise(y).subtract(x));
+    arena.reset();
+  }
+  state.setItemsPerOp(n);
+}
@@ -0,0 +1,76 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+#include "scl/math/number.h"
+#include "scl/math/prime.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+SCL_BENCHMARK("Number/mul_mod", 512, 2048) {
+  auto prg = util::PRG::create("bench number mul mod");
+  const auto bits = static_cast<std::size_t>(state.arg());
+  const auto m = math::Number::randomPrime(bits, prg);
+  const auto a = math::Number::random(bits, prg) % m;
+  auto x = math::Number::random(bits, prg) % m;
+  while (state.run()) {
+    x = (x * a) % m;
+  }
+  bench::doNotOptimize(x);
+}
+
+SCL_BENCHMARK("Number/mul_mod_inplace", 512, 2048) {
+  auto prg = util::PRG::create("bench number mul mod");
+  const auto bits = static_cast<std::size_t>(state.arg());
+  const auto m = math::Number::randomPrime(bits, prg);
+  const auto a = math::Number::random(bits, prg) % m;
+  auto x = math::Number::random(bits, prg) % m;
+  x.reserve(2 * bits);
+  while (state.run()) {
+    math::mulMod(x, x, a, m);
+  }
+  bench::doNotOptimize(x);
+}
+
+SCL_BENCHMARK("Number/mod_exp", 1024, 2048) {
+  auto prg = util::PRG::create("bench number mod exp");
+  const auto bits = static_cast<std::size_t>(state.arg());
+  const auto m = math::Number::random(bits, prg) | math::Number(1);
+  const auto e = math::Number::random(bits, prg);
+  auto x = math::Number::random(bits, prg) % m;
+  while (state.run()) {
+    math::modExp(x, x, e, m);
+  }
+  bench::doNotOptimize(x);
+}
+
+SCL_BENCHMARK("Number/next_prime", 1024) {
+  auto prg = util::PRG::create("bench number next prime");
+  const auto bits = static_cast<std::size_t>(state.arg());
+  while (state.run()) {
+    bench::doNotOptimize(math::Number::randomPrime(bits, prg));
+  }
+}
+
+SCL_BENCHMARK("Number/generate_prime", 1024) {
+  auto prg = util::PRG::create("bench number generate prime");
+  const auto bits = static_cast<std::size_t>(state.arg());
+  while (state.run()) {
+    bench::doNotOptimize(math::generatePrime(bits, prg, 1));
+  }
+}
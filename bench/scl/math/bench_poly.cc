@@ -0,0 +1,112 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+#include "scl/math/fp.h"
+#include "scl/math/lagrange.h"
+#include "scl/math/poly.h"
+#include "scl/math/vector.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+using FF = math::Fp<61>;
+using Poly = math::Polynomial<FF>;
+
+Poly randomPolynomial(std::size_t degree, util::PRG& prg) {
+  return Poly::create(math::Vector<FF>::random(degree + 1, prg));
+}
+
+}  // namespace
+
+SCL_BENCHMARK("Polynomial/evaluate", 16, 256, 4096) {
+  auto prg = util::PRG::create("bench poly evaluate");
+  const auto p = randomPolynomial(state.arg(), prg);
+  const auto x = FF::random(prg);
+  while (state.run()) {
+    bench::doNotOptimize(p.evaluate(x));
+  }
+  state.setItemsPerOp(p.degree() + 1);
+}
+
+SCL_BENCHMARK("Polynomial/add", 16, 256, 4096) {
+  auto prg = util::PRG::create("bench poly add");
+  const auto p = randomPolynomial(state.arg(), prg);
+  const auto q = randomPolynomial(state.arg(), prg);
+  while (state.run()) {
+    bench::doNotOptimize(p.add(q));
+  }
+  state.setItemsPerOp(p.degree() + 1);
+}
+
+SCL_BENCHMARK("Polynomial/add_in_place", 16, 256, 4096) {
+  auto prg = util::PRG::create("bench poly add in place");
+  auto p = randomPolynomial(state.arg(), prg);
+  const auto q = randomPolynomial(state.arg(), prg);
+  while (state.run()) {
+    bench::doNotOptimize(p.addInPlace(q));
+  }
+  state.setItemsPerOp(p.degree() + 1);
+}
+
+SCL_BENCHMARK("Polynomial/multiply", 16, 256, 1024) {
+  auto prg = util::PRG::create("bench poly multiply");
+  const auto p = randomPolynomial(state.arg(), prg);
+  const auto q = randomPolynomial(state.arg(), prg);
+  while (state.run()) {
+    bench::doNotOptimize(p.multiply(q));
+  }
+}
+
+SCL_BENCHMARK("Polynomial/multiply_into", 16, 256, 1024) {
+  auto prg = util::PRG::create("bench poly multiply into");
+  const auto p = randomPolynomial(state.arg(), prg);
+  const auto q = randomPolynomial(state.arg(), prg);
+  Poly out;
+  while (state.run()) {
+    bench::doNotOptimize(p.multiplyInto(out, q));
+  }
+}
+
+SCL_BENCHMARK("Polynomial/divide", 16, 64, 256, 1024) {
+  auto prg = util::PRG::create("bench poly divide");
+  const auto p = randomPolynomial(2 * state.arg(), prg);
+  const auto q = randomPolynomial(state.arg(), prg);
+  while (state.run()) {
+    bench::doNotOptimize(p.divide(q));
+  }
+}
+
+SCL_BENCHMARK("Polynomial/divide_precomputed", 16, 64, 256, 1024) {
+  auto prg = util::PRG::create("bench poly divide precomputed");
+  const auto p = randomPolynomial(2 * state.arg(), prg);
+  const auto q = randomPolynomial(state.arg(), prg);
+  const math::PolynomialDivisor<FF> divisor(q, p.degree());
+  while (state.run()) {
+    bench::doNotOptimize(divisor.divide(p));
+  }
+}
+
+SCL_BENCHMARK("Polynomial/lagrange_basis", 8, 64, 256) {
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto nodes = math::Vector<FF>::range(1, n + 1);
+  while (state.run()) {
+    bench::doNotOptimize(math::computeLagrangeBasis(nodes, 0));
+  }
+}
@@ -0,0 +1,85 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+#include "scl/math/vector.h"
+#include "scl/math/z2k.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+template <typename RING>
+void add(bench::State& state) {
+  auto prg = util::PRG::create("bench z2k add");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto x = math::Vector<RING>::random(n, prg);
+  const auto y = math::Vector<RING>::random(n, prg);
+  while (state.run()) {
+    bench::doNotOptimize(x.add(y));
+  }
+  state.setItemsPerOp(n);
+  state.setBytesPerOp(n * sizeof(RING));
+}
+
+template <typename RING>
+void multiply(bench::State& state) {
+  auto prg = util::PRG::create("bench z2k multiply");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto x = math::Vector<RING>::random(n, prg);
+  const auto y = math::Vector<RING>::random(n, prg);
+  while (state.run()) {
+    bench::doNotOptimize(x.multiplyEntryWise(y));
+  }
+  state.setItemsPerOp(n);
+  state.setBytesPerOp(n * sizeof(RING));
+}
+
+}  // namespace
+
+SCL_BENCHMARK("Z2k/8/add", 65536) {
+  add<math::Z2k<8>>(state);
+}
+
+SCL_BENCHMARK("Z2k/8/multiply", 65536) {
+  multiply<math::Z2k<8>>(state);
+}
+
+SCL_BENCHMARK("Z2k/16/add", 65536) {
+  add<math::Z2k<16>>(state);
+}
+
+SCL_BENCHMARK("Z2k/16/multiply", 65536) {
+  multiply<math::Z2k<16>>(state);
+}
+
+SCL_BENCHMARK("Z2k/32/add", 65536) {
+  add<math::Z2k<32>>(state);
+}
+
+SCL_BENCHMARK("Z2k/32/multiply", 65536) {
+  multiply<math::Z2k<32>>(state);
+}
+
+SCL_BENCHMARK("Z2k/64/add", 65536) {
+  add<math::Z2k<64>>(state);
+}
+
+SCL_BENCHMARK("Z2k/64/multiply", 65536) {
+  multiply<math::Z2k<64>>(state);
+}
@@ -0,0 +1,99 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include "bench.h"
+#include "scl/math/fp.h"
+#include "scl/math/vector.h"
+#include "scl/net/packet.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+using FF = math::Fp<61>;
+
+}  // namespace
+
+SCL_BENCHMARK("Packet/write_u64", 16, 1024, 65536) {
+  const auto n = static_cast<std::size_t>(state.arg());
+  while (state.run()) {
+    net::Packet packet;
+    for (std::size_t i = 0; i < n; ++i) {
+      packet << static_cast<std::uint64_t>(i);
+    }
+    bench::doNotOptimize(packet);
+  }
+  state.setItemsPerOp(n);
+  state.setBytesPerOp(n * sizeof(std::uint64_t));
+}
+
+SCL_BENCHMARK("Packet/read_u64", 16, 1024, 65536) {
+  const auto n = static_cast<std::size_t>(state.arg());
+  net::Packet packet;
+  for (std::size_t i = 0; i < n; ++i) {
+    packet << static_cast<std::uint64_t>(i);
+  }
+  while (state.run()) {
+    packet.resetReadPtr();
+    for (std::size_t i = 0; i < n; ++i) {
+      bench::doNotOptimize(packet.read<std::uint64_t>());
+    }
+  }
+  state.setItemsPerOp(n);
+  state.setBytesPerOp(n * sizeof(std::uint64_t));
+}
+
+SCL_BENCHMARK("Packet/write_vector", 16, 1024, 65536) {
+  auto prg = util::PRG::create("bench packet write vector");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto v = math::Vector<FF>::random(n, prg);
+  while (state.run()) {
+    net::Packet packet;
+    packet << v;
+    bench::doNotOptimize(packet);
+  }
+  state.setItemsPerOp(n);
+  state.setBytesPerOp(n * FF::byteSize());
+}
+
+SCL_BENCHMARK("Packet/read_vector", 16, 1024, 65536) {
+  auto prg = util::PRG::create("bench packet read vector");
+  const auto n = static_cast<std::size_t>(state.arg());
+  net::Packet packet;
+  packet << math::Vector<FF>::random(n, prg);
+  while (state.run()) {
+    packet.resetReadPtr();
+    bench::doNotOptimize(packet.read<math::Vector<FF>>());
+  }
+  state.setItemsPerOp(n);
+  state.setBytesPerOp(n * FF::byteSize());
+}
+
+SCL_BENCHMARK("Packet/copy", 1024, 65536, 1048576) {
+  const auto n = static_cast<std::size_t>(state.arg());
+  net::Packet packet(n);
+  std::memset(packet.get(), 0, n);
+  packet.setWritePtr(n);
+  while (state.run()) {
+    net::Packet copy(packet);
+    bench::doNotOptimize(copy);
+  }
+  state.setBytesPerOp(n);
+}
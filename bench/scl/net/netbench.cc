@@ -0,0 +1,378 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <time.h>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "scl/coro/runtime.h"
+#include "scl/coro/task.h"
+#include "scl/net/config.h"
+#include "scl/net/network.h"
+#include "scl/net/packet.h"
+#include "scl/util/cmdline.h"
+#include "scl/util/measurement.h"
+#include "scl/util/time.h"
+
+using namespace scl;
+
+namespace {
+
+// CPU time consumed by the calling thread.
+std::chrono::nanoseconds threadCpuTime() {
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+long double toSeconds(std::chrono::nanoseconds ns) {
+  return ns.count() / 1e9L;
+}
+
+long double toMicros(util::Time::Duration d) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() /
+         1e3L;
+}
+
+// Resources used by a single party while running an experiment. Connection
+// setup is not included.
+struct PartyUsage {
+  std::chrono::nanoseconds wall;
+  std::chrono::nanoseconds cpu;
+};
+
+using PartyBody = std::function<coro::Task<void>(net::Network&)>;
+
+// Run an experiment with n parties connected over localhost TCP. Each party
+// runs in its own thread with its own runtime.
+std::vector<PartyUsage> runParties(std::size_t n,
+                                   std::size_t port_base,
+                                   const PartyBody& body) {
+  std::vector<PartyUsage> usage(n);
+  std::vector<std::exception_ptr> errors(n);
+  std::vector<std::thread> threads;
+
+  for (std::size_t id = 0; id < n; ++id) {
+    threads.emplace_back([&, id]() {
+      try {
+        auto rt = coro::DefaultRuntime::create();
+        const auto config = net::NetworkConfig::localhost(id, n, port_base);
+        auto network = rt->run(net::Network::create(config));
+
+        const auto cpu_start = threadCpuTime();
+        const auto wall_start = util::Time::now();
+        rt->run(body(network));
+        usage[id].wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            util::Time::now() - wall_start);
+        usage[id].cpu = threadCpuTime() - cpu_start;
+
+        network.close();
+      } catch (...) {
+        errors[id] = std::current_exception();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  return usage;
+}
+
+net::Packet makePacket(std::size_t size) {
+  net::Packet packet(size);
+  std::memset(packet.get(), 0xAB, size);
+  packet.setWritePtr(size);
+  return packet;
+}
+
+// Party 0 sends a packet to party 1, which echoes it back.
+coro::Task<void> pingPong(net::Network& network,
+                          std::size_t size,
+                          std::size_t warmup,
+                          std::size_t rounds,
+                          util::StreamingTimeMeasurement* latencies) {
+  const auto packet = makePacket(size);
+  auto* channel = network.other();
+
+  for (std::size_t i = 0; i < warmup + rounds; ++i) {
+    if (network.myId() == 0) {
+      const auto start = util::Time::now();
+      co_await channel->send(packet);
+      co_await channel->recv();
+      if (i >= warmup) {
+        latencies->addSample(util::Time::now() - start);
+      }
+    } else {
+      auto echo = co_await channel->recv();
+      co_await channel->send(std::move(echo));
+    }
+  }
+}
+
+// Party 0 streams a number of packets to party 1, which acknowledges once all
+// packets have been received.
+coro::Task<void> stream(net::Network& network,
+                        std::size_t size,
+                        std::size_t count,
+                        util::Time::Duration* elapsed) {
+  auto* channel = network.other();
+
+  if (network.myId() == 0) {
+    const auto packet = makePacket(size);
+    const auto start = util::Time::now();
+    for (std::size_t i = 0; i < count; ++i) {
+      co_await channel->send(packet);
+    }
+    co_await channel->recv();
+    *elapsed = util::Time::now() - start;
+  } else {
+    for (std::size_t i = 0; i < count; ++i) {
+      co_await channel->recv();
+    }
+    co_await channel->send(makePacket(1));
+  }
+}
+
+// Every party sends a packet to every other party and then waits for packets
+// from everyone.
+coro::Task<void> allToAll(net::Network& network,
+                          std::size_t size,
+                          std::size_t warmup,
+                          std::size_t rounds,
+                          util::StreamingTimeMeasurement* latencies) {
+  const auto packet = makePacket(size);
+
+  for (std::size_t i = 0; i < warmup + rounds; ++i) {
+    const auto start = util::Time::now();
+    co_await network.send(packet);
+    co_await network.recv();
+    if (i >= warmup) {
+      latencies->addSample(util::Time::now() - start);
+    }
+  }
+}
+
+void writeUsage(std::ostream& stream, const std::vector<PartyUsage>& usage) {
+  stream << "[";
+  for (std::size_t i = 0; i < usage.size(); ++i) {
+    const auto wall = toSeconds(usage[i].wall);
+    const auto cpu = toSeconds(usage[i].cpu);
+    stream << (i ? ", " : "") << "{"
+           << "\"id\": " << i << ", "
+           << "\"wall_s\": " << wall << ", "
+           << "\"cpu_s\": " << cpu << ", "
+           << "\"cpu_utilization\": " << (wall > 0 ? cpu / wall : 0) << "}";
+  }
+  stream << "]";
+}
+
+long double averageUtilization(const std::vector<PartyUsage>& usage) {
+  long double sum = 0;
+  for (const auto& u : usage) {
+    sum += toSeconds(u.cpu) / std::max(toSeconds(u.wall), 1e-9L);
+  }
+  return sum / usage.size();
+}
+
+std::string formatSize(std::size_t size) {
+  std::stringstream ss;
+  if (size >= (1 << 20)) {
+    ss << (size >> 20) << " MiB";
+  } else if (size >= (1 << 10)) {
+    ss << (size >> 10) << " KiB";
+  } else {
+    ss << size << " B";
+  }
+  return ss.str();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const auto opts =
+      util::ProgramOptions::Parser(
+          "Network benchmarks for SCL over localhost TCP.")
+          .add(util::ProgramArg::optional("port",
+                                          "int",
+                                          "19900",
+                                          "first port to use"))
+          .add(util::ProgramArg::optional("max_parties",
+                                          "int",
+                                          "8",
+                                          "largest network size for all-to-all"))
+          .add(util::ProgramArg::optional("rounds",
+                                          "int",
+                                          "1000",
+                                          "rounds for latency measurements"))
+          .add(util::ProgramArg::optional("stream_bytes",
+                                          "int",
+                                          "268435456",
+                                          "bytes streamed per packet size"))
+          .add(util::ProgramArg::optional("max_size",
+                                          "int",
+                                          "67108864",
+                                          "largest packet size to stream"))
+          .add(util::ProgramArg::optional("json",
+                                          "file",
+                                          "",
+                                          "write results as JSON to file"))
+          .parse(argc, argv);
+
+  auto port = opts.get<std::size_t>("port");
+  const auto max_parties = opts.get<std::size_t>("max_parties");
+  const auto rounds = opts.get<std::size_t>("rounds");
+  const auto stream_bytes = opts.get<std::size_t>("stream_bytes");
+  const auto max_size = opts.get<std::size_t>("max_size");
+  const auto warmup = std::max<std::size_t>(rounds / 10, 1);
+
+  std::stringstream json;
+  json << std::setprecision(std::numeric_limits<double>::max_digits10);
+  json << "{\n  \"context\": ";
+  bench::writeJsonContext(json);
+  json << ",\n";
+
+  // Ping-pong latency between two parties.
+  json << "  \"ping_pong\": [";
+  std::cerr << "# ping-pong latency (2 parties, " << rounds << " rounds)\n";
+  for (const std::size_t size : {8, 1024, 65536}) {
+    util::StreamingTimeMeasurement latencies;
+    const auto usage = runParties(2, port, [&](net::Network& network) {
+      return pingPong(network, size, warmup, rounds, &latencies);
+    });
+    port += 2;
+
+    json << (size == 8 ? "\n" : ",\n") << "    {"
+         << "\"size\": " << size << ", "
+         << "\"rounds\": " << rounds << ", "
+         << "\"latency\": " << latencies << ", "
+         << "\"parties\": ";
+    writeUsage(json, usage);
+    json << "}";
+
+    std::cerr << std::left << std::setw(10) << formatSize(size) << std::right
+              << std::fixed << std::setprecision(1)
+              << " p50=" << toMicros(latencies.percentile(50)) << "us"
+              << " p99=" << toMicros(latencies.percentile(99)) << "us"
+              << " p999=" << toMicros(latencies.percentile(99.9)) << "us"
+              << " cpu=" << std::setprecision(2) << averageUtilization(usage)
+              << std::defaultfloat << "\n";
+  }
+  json << "\n  ],\n";
+
+  // Streaming throughput from party 0 to party 1.
+  json << "  \"stream\": [";
+  std::cerr << "# streaming throughput (2 parties)\n";
+  bool first = true;
+  for (std::size_t size = 8; size <= max_size; size *= 8) {
+    const auto count = std::clamp<std::size_t>(stream_bytes / size, 8, 100000);
+    util::Time::Duration elapsed;
+    const auto usage = runParties(2, port, [&](net::Network& network) {
+      return stream(network, size, count, &elapsed);
+    });
+    port += 2;
+
+    const auto seconds = toMicros(elapsed) / 1e6L;
+    const auto mib_s = size * count / seconds / (1 << 20);
+
+    json << (first ? "\n" : ",\n") << "    {"
+         << "\"size\": " << size << ", "
+         << "\"count\": " << count << ", "
+         << "\"seconds\": " << seconds << ", "
+         << "\"mib_per_second\": " << mib_s << ", "
+         << "\"packets_per_second\": " << count / seconds << ", "
+         << "\"parties\": ";
+    writeUsage(json, usage);
+    json << "}";
+    first = false;
+
+    std::cerr << std::left << std::setw(10) << formatSize(size) << std::right
+              << std::fixed << std::setprecision(1) << std::setw(12) << mib_s
+              << " MiB/s" << std::setw(12) << std::setprecision(0)
+              << count / seconds << " packets/s"
+              << " cpu=" << std::setprecision(2) << averageUtilization(usage)
+              << std::defaultfloat << "\n";
+
+    // make sure the largest size is always included.
+    if (size < max_size && size * 8 > max_size) {
+      size = max_size / 8;
+    }
+  }
+  json << "\n  ],\n";
+
+  // All-to-all rounds for increasing network sizes.
+  json << "  \"all_to_all\": [";
+  std::cerr << "# all-to-all round latency (" << rounds << " rounds)\n";
+  for (std::size_t n = 2; n <= max_parties; ++n) {
+    std::vector<util::StreamingTimeMeasurement> latencies(n);
+    const auto usage = runParties(n, port, [&](net::Network& network) {
+      const auto id = network.myId();
+      return allToAll(network, 8, warmup, rounds, &latencies[id]);
+    });
+    port += n;
+
+    // round latencies as observed by any party.
+    util::StreamingTimeMeasurement round_latencies;
+    for (const auto& party_latencies : latencies) {
+      round_latencies.merge(party_latencies);
+    }
+
+    json << (n == 2 ? "\n" : ",\n") << "    {"
+         << "\"parties\": " << n << ", "
+         << "\"rounds\": " << rounds << ", "
+         << "\"latency\": " << round_latencies << ", "
+         << "\"usage\": ";
+    writeUsage(json, usage);
+    json << "}";
+
+    std::cerr << "n=" << std::left << std::setw(8) << n << std::right
+              << std::fixed << std::setprecision(1)
+              << " p50=" << toMicros(round_latencies.percentile(50)) << "us"
+              << " p99=" << toMicros(round_latencies.percentile(99)) << "us"
+              << " cpu=" << std::setprecision(2) << averageUtilization(usage)
+              << std::defaultfloat << "\n";
+  }
+  json << "\n  ]\n}\n";
+
+  const auto json_file = opts.get("json");
+  if (json_file == "-") {
+    std::cout << json.str();
+  } else if (!json_file.empty()) {
+    std::ofstream file{std::string(json_file)};
+    file << json.str();
+  }
+
+  return 0;
+}
@@ -0,0 +1,87 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include "bench.h"
+#include "scl/coro/batch.h"
+#include "scl/coro/runtime.h"
+#include "scl/net/loopback.h"
+#include "scl/ot/iknp.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+coro::Task<void> both(coro::Task<void> sender, coro::Task<void> receiver) {
+  std::vector<coro::Task<void>> tasks;
+  tasks.emplace_back(std::move(sender));
+  tasks.emplace_back(std::move(receiver));
+  co_await coro::batch(std::move(tasks));
+}
+
+coro::Task<void> sendRandom(ot::IknpSender& sender,
+                            net::Channel& channel,
+                            std::size_t n) {
+  bench::doNotOptimize(co_await sender.sendRandom(channel, n));
+}
+
+coro::Task<void> receiveRandom(ot::IknpReceiver& receiver,
+                               net::Channel& channel,
+                               const util::Bitmap& choices) {
+  bench::doNotOptimize(co_await receiver.receiveRandom(channel, choices));
+}
+
+}  // namespace
+
+// Both parties run on the same core, so this measures the total cost of an OT.
+SCL_BENCHMARK("OT/iknp_random", 1 << 16, 1 << 20) {
+  auto rt = coro::DefaultRuntime::create();
+  auto channels = net::LoopbackChannel::createPaired();
+  ot::IknpSender sender;
+  ot::IknpReceiver receiver;
+  auto prg0 = util::PRG::create("bench iknp sender");
+  auto prg1 = util::PRG::create("bench iknp receiver");
+  rt->run(both(sender.setup(*channels[0], prg0),
+               receiver.setup(*channels[1], prg1)));
+
+  const auto n = static_cast<std::size_t>(state.arg());
+  util::Bitmap choices(n);
+  for (std::size_t i = 0; i < n; i += 3) {
+    choices.set(i, true);
+  }
+
+  while (state.run()) {
+    rt->run(both(sendRandom(sender, *channels[0], n),
+                 receiveRandom(receiver, *channels[1], choices)));
+  }
+  state.setItemsPerOp(n);
+}
+
+SCL_BENCHMARK("OT/base_ot_setup") {
+  auto rt = coro::DefaultRuntime::create();
+  auto channels = net::LoopbackChannel::createPaired();
+  auto prg0 = util::PRG::create("bench iknp sender");
+  auto prg1 = util::PRG::create("bench iknp receiver");
+  while (state.run()) {
+    ot::IknpSender sender;
+    ot::IknpReceiver receiver;
+    rt->run(both(sender.setup(*channels[0], prg0),
+                 receiver.setup(*channels[1], prg1)));
+  }
+}
@@ -0,0 +1,327 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "harness.h"
+
+#include <algorithm>
+#include <barrier>
+#include <exception>
+#include <thread>
+
+#include "scl/coro/batch.h"
+#include "scl/coro/runtime.h"
+#include "scl/net/config.h"
+#include "scl/net/loopback.h"
+#include "scl/net/network.h"
+#include "scl/protocol/env.h"
+#include "scl/protocol/eval.h"
+#include "scl/simulation/event.h"
+#include "scl/simulation/manager.h"
+#include "scl/simulation/simulator.h"
+
+using namespace scl;
+
+namespace {
+
+// Counts the communication of a single party.
+struct PartyCounters {
+  std::size_t bytes = 0;
+  std::size_t messages = 0;
+  std::size_t rounds = 0;
+  bool sending = false;
+
+  void onSend(std::size_t nbytes) {
+    bytes += nbytes;
+    messages++;
+    if (!sending) {
+      rounds++;
+      sending = true;
+    }
+  }
+
+  void onRecv() {
+    sending = false;
+  }
+};
+
+std::size_t wireSize(const net::Packet& packet) {
+  return packet.size() + sizeof(net::Packet::SizeType);
+}
+
+// Channel which forwards to another channel while counting what is sent.
+class CountingChannel final : public net::Channel {
+ public:
+  CountingChannel(net::Channel* channel, PartyCounters* counters)
+      : m_channel(channel), m_counters(counters) {}
+
+  void close() override {
+    m_channel->close();
+  }
+
+  coro::Task<void> send(net::Packet&& packet) override {
+    m_counters->onSend(wireSize(packet));
+    co_await m_channel->send(std::move(packet));
+  }
+
+  coro::Task<void> send(const net::Packet& packet) override {
+    m_counters->onSend(wireSize(packet));
+    co_await m_channel->send(packet);
+  }
+
+  coro::Task<net::Packet> recv() override {
+    auto packet = co_await m_channel->recv();
+    m_counters->onRecv();
+    co_return packet;
+  }
+
+  coro::Task<bool> hasData() override {
+    co_return co_await m_channel->hasData();
+  }
+
+ private:
+  net::Channel* m_channel;
+  PartyCounters* m_counters;
+};
+
+// Wrap the channels of a network so that all communication with other parties
+// is counted. The channels of the returned network refer to the channels of
+// the original network, which must therefore outlive it.
+net::Network countingNetwork(net::Network& network, PartyCounters* counters) {
+  const auto id = network.myId();
+  std::vector<std::shared_ptr<net::Channel>> channels;
+  for (std::size_t i = 0; i < network.size(); ++i) {
+    auto* channel = network.party(i);
+    if (i == id) {
+      channels.emplace_back(std::shared_ptr<net::Channel>(
+          std::shared_ptr<net::Channel>{},
+          channel));
+    } else {
+      channels.emplace_back(
+          std::make_shared<CountingChannel>(channel, counters));
+    }
+  }
+  return net::Network(channels, id);
+}
+
+bench::ProtocolCost totalCost(const std::vector<PartyCounters>& counters,
+                              util::Time::Duration latency) {
+  bench::ProtocolCost cost{latency, 0, 0, 0};
+  for (const auto& c : counters) {
+    cost.bytes += c.bytes;
+    cost.messages += c.messages;
+    cost.rounds = std::max(cost.rounds, c.rounds);
+  }
+  return cost;
+}
+
+struct FixedNetworkConfig final : public sim::NetworkConfig {
+  FixedNetworkConfig(const sim::ChannelConfig& config) : config(config) {}
+
+  sim::ChannelConfig get(sim::ChannelId channel_id) override {
+    if (channel_id.local == channel_id.remote) {
+      return sim::ChannelConfig::loopback();
+    }
+    return config;
+  }
+
+  sim::ChannelConfig config;
+};
+
+class HarnessManager final : public sim::Manager {
+ public:
+  HarnessManager(const bench::ProtocolFactory& factory,
+                 const sim::ChannelConfig& config,
+                 std::vector<sim::SimulationTrace>& traces)
+      : m_factory(factory), m_config(config), m_traces(traces) {}
+
+  std::vector<std::unique_ptr<proto::Protocol>> protocol() override {
+    auto protocols = m_factory();
+    m_traces.resize(protocols.size());
+    return protocols;
+  }
+
+  void handleSimulatorOutput(std::size_t party_id,
+                             const sim::SimulationTrace& trace) override {
+    m_traces[party_id] = trace;
+  }
+
+  std::unique_ptr<sim::NetworkConfig> networkConfiguration() const override {
+    return std::make_unique<FixedNetworkConfig>(m_config);
+  }
+
+ private:
+  const bench::ProtocolFactory& m_factory;
+  sim::ChannelConfig m_config;
+  std::vector<sim::SimulationTrace>& m_traces;
+};
+
+}  // namespace
+
+bench::ProtocolCost bench::simulateProtocol(const ProtocolFactory& factory,
+                                            const sim::ChannelConfig& config) {
+  std::vector<sim::SimulationTrace> traces;
+  sim::simulate(std::make_unique<HarnessManager>(factory, config, traces));
+
+  std::vector<PartyCounters> counters(traces.size());
+  util::Time::Duration latency{0};
+
+  for (std::size_t i = 0; i < traces.size(); ++i) {
+    for (const auto& event : traces[i]) {
+      latency = std::max(latency, event->timestamp);
+
+      if (event->type != sim::EventType::SEND &&
+          event->type != sim::EventType::RECV) {
+        continue;
+      }
+
+      const auto* data_event =
+          dynamic_cast<const sim::ChannelDataEvent*>(event.get());
+      if (data_event->channel_id.local == data_event->channel_id.remote) {
+        continue;
+      }
+
+      if (event->type == sim::EventType::SEND) {
+        counters[i].onSend(data_event->amount);
+      } else {
+        counters[i].onRecv();
+      }
+    }
+  }
+
+  return totalCost(counters, latency);
+}
+
+namespace {
+
+coro::Task<void> runParty(std::unique_ptr<proto::Protocol> protocol,
+                          proto::Env& env,
+                          util::Time::TimePoint start,
+                          util::Time::Duration* finished) {
+  co_await proto::evaluate<void>(std::move(protocol), env);
+  *finished = util::Time::now() - start;
+}
+
+coro::Task<void> runAll(std::vector<coro::Task<void>> parties) {
+  co_await coro::batch(std::move(parties));
+}
+
+}  // namespace
+
+bench::ProtocolCost bench::runProtocolInProcess(
+    const ProtocolFactory& factory) {
+  auto protocols = factory();
+  const auto n = protocols.size();
+
+  // channels[i][j] is the channel party i uses to talk to party j.
+  std::vector<std::vector<std::shared_ptr<net::Channel>>> channels(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    channels[i].resize(n);
+    channels[i][i] = net::LoopbackChannel::create();
+    for (std::size_t j = 0; j < i; ++j) {
+      auto paired = net::LoopbackChannel::createPaired();
+      channels[j][i] = paired[0];
+      channels[i][j] = paired[1];
+    }
+  }
+
+  std::vector<PartyCounters> counters(n);
+  std::vector<net::Network> networks;
+  std::vector<proto::Env> envs;
+  for (std::size_t i = 0; i < n; ++i) {
+    networks.emplace_back(channels[i], i);
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    envs.emplace_back(
+        proto::createDefaultEnv(countingNetwork(networks[i], &counters[i])));
+  }
+
+  std::vector<util::Time::Duration> finished(n);
+  auto rt = coro::DefaultRuntime::create();
+  const auto start = util::Time::now();
+
+  std::vector<coro::Task<void>> parties;
+  for (std::size_t i = 0; i < n; ++i) {
+    parties.emplace_back(
+        runParty(std::move(protocols[i]), envs[i], start, &finished[i]));
+  }
+  rt->run(runAll(std::move(parties)));
+
+  return totalCost(counters,
+                   *std::max_element(finished.begin(), finished.end()));
+}
+
+bench::ProtocolCost bench::runProtocolTcp(const ProtocolFactory& factory,
+                                          std::size_t port_base) {
+  auto protocols = factory();
+  const auto n = protocols.size();
+
+  std::vector<PartyCounters> counters(n);
+  std::vector<util::Time::Duration> finished(n);
+  std::vector<std::exception_ptr> errors(n);
+  std::vector<std::thread> threads;
+
+  // all parties start the clock once everyone is connected.
+  std::barrier connected(n);
+
+  for (std::size_t id = 0; id < n; ++id) {
+    threads.emplace_back([&, id]() {
+      bool arrived = false;
+      try {
+        auto rt = coro::DefaultRuntime::create();
+        const auto config = net::NetworkConfig::localhost(id, n, port_base);
+        auto network = rt->run(net::Network::create(config));
+        auto env =
+            proto::createDefaultEnv(countingNetwork(network, &counters[id]));
+
+        arrived = true;
+        connected.arrive_and_wait();
+        const auto start = util::Time::now();
+        rt->run(runParty(std::move(protocols[id]), env, start, &finished[id]));
+        network.close();
+      } catch (...) {
+        // don't leave the other parties waiting for us.
+        if (!arrived) {
+          connected.arrive_and_drop();
+        }
+        errors[id] = std::current_exception();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  return totalCost(counters,
+                   *std::max_element(finished.begin(), finished.end()));
+}
+
+std::ostream& bench::operator<<(std::ostream& stream,
+                                const ProtocolCost& cost) {
+  return stream << "{"
+                << "\"latency_ms\": " << util::timeToMillis(cost.latency)
+                << ", "
+                << "\"bytes\": " << cost.bytes << ", "
+                << "\"messages\": " << cost.messages << ", "
+                << "\"rounds\": " << cost.rounds << "}";
+}
@@ -0,0 +1,111 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCH_SCL_PROTOCOL_HARNESS_H
+#define BENCH_SCL_PROTOCOL_HARNESS_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "scl/protocol/base.h"
+#include "scl/simulation/config.h"
+#include "scl/util/time.h"
+
+namespace scl::bench {
+
+/**
+ * @brief Function producing the protocols run by each party.
+ *
+ * The i'th protocol in the returned list is run by party i. The factory is
+ * called once for each backend a protocol is run on.
+ */
+using ProtocolFactory =
+    std::function<std::vector<std::unique_ptr<proto::Protocol>>()>;
+
+/**
+ * @brief Cost of running a protocol, as measured or predicted by a backend.
+ *
+ * Data sent by a party to itself is not counted, and the size of a message
+ * includes the size prefix written by TcpChannel.
+ */
+struct ProtocolCost {
+  /**
+   * @brief Time until the last party finished.
+   */
+  util::Time::Duration latency;
+
+  /**
+   * @brief Total number of bytes sent by all parties.
+   */
+  std::size_t bytes;
+
+  /**
+   * @brief Total number of messages sent by all parties.
+   */
+  std::size_t messages;
+
+  /**
+   * @brief Largest number of rounds of any party.
+   *
+   * A round is a maximal sequence of sends that is not interrupted by a
+   * receive.
+   */
+  std::size_t rounds;
+};
+
+/**
+ * @brief Run a protocol in the simulator.
+ * @param factory the protocol factory.
+ * @param config the configuration used for all channels between two
+ * different parties.
+ * @return the cost as predicted by the simulator.
+ */
+ProtocolCost simulateProtocol(const ProtocolFactory& factory,
+                              const sim::ChannelConfig& config);
+
+/**
+ * @brief Run a protocol with all parties in the same thread.
+ * @param factory the protocol factory.
+ * @return the measured cost.
+ *
+ * Parties are connected with loopback channels and run in the same coroutine
+ * runtime.
+ */
+ProtocolCost runProtocolInProcess(const ProtocolFactory& factory);
+
+/**
+ * @brief Run a protocol with parties connected over localhost TCP.
+ * @param factory the protocol factory.
+ * @param port_base the port of party 0. Party i uses port_base + i.
+ * @return the measured cost.
+ *
+ * Each party runs in its own thread. Connection setup is not measured.
+ */
+ProtocolCost runProtocolTcp(const ProtocolFactory& factory,
+                            std::size_t port_base);
+
+/**
+ * @brief Write a protocol cost as JSON.
+ */
+std::ostream& operator<<(std::ostream& stream, const ProtocolCost& cost);
+
+}  // namespace scl::bench
+
+#endif  // BENCH_SCL_PROTOCOL_HARNESS_H
@@ -0,0 +1,321 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "harness.h"
+#include "protocol/beaver.h"
+#include "protocol/triple.h"
+#include "scl/coro/runtime.h"
+#include "scl/math/fp.h"
+#include "scl/protocol/double_sharing.h"
+#include "scl/ss/additive.h"
+#include "scl/util/cmdline.h"
+#include "scl/util/prg.h"
+#include "scl/util/trace.h"
+
+using namespace scl;
+
+namespace {
+
+using FF = math::Fp<61>;
+
+// Protocol where all parties exchange a message with everyone else in a
+// number of rounds.
+class Exchange final : public proto::Protocol {
+ public:
+  Exchange(std::size_t rounds, std::size_t size)
+      : m_rounds(rounds), m_size(size) {}
+
+  coro::Task<proto::ProtocolResult> run(proto::Env& env) const override {
+    net::Packet packet(m_size);
+    for (std::size_t i = 0; i < m_size; ++i) {
+      packet << static_cast<unsigned char>(i);
+    }
+
+    const auto n = env.network.size();
+    const auto id = env.network.myId();
+
+    for (std::size_t r = 0; r < m_rounds; ++r) {
+      for (std::size_t j = 0; j < n; ++j) {
+        if (j != id) {
+          co_await env.network.party(j)->send(packet);
+        }
+      }
+      for (std::size_t j = 0; j < n; ++j) {
+        if (j != id) {
+          co_await env.network.party(j)->recv();
+        }
+      }
+    }
+
+    co_return proto::ProtocolResult::done();
+  }
+
+  std::string name() const override {
+    return "Exchange";
+  }
+
+ private:
+  std::size_t m_rounds;
+  std::size_t m_size;
+};
+
+// Protocol generating a batch of random double sharings.
+class DoubleSharing final : public proto::Protocol {
+ public:
+  DoubleSharing(std::size_t t, std::size_t count) : m_t(t), m_count(count) {}
+
+  coro::Task<proto::ProtocolResult> run(proto::Env& env) const override {
+    auto prg = util::PRG::create(std::to_string(env.network.myId()));
+    proto::DoubleSharingGenerator<FF> gen(env.network.size(), m_t);
+    co_await gen.generate(env.network, m_count, prg);
+    co_return proto::ProtocolResult::done();
+  }
+
+  std::string name() const override {
+    return "DoubleSharing";
+  }
+
+ private:
+  std::size_t m_t;
+  std::size_t m_count;
+};
+
+struct NamedFactory {
+  std::string name;
+  bench::ProtocolFactory factory;
+};
+
+std::vector<NamedFactory> protocols() {
+  std::vector<NamedFactory> factories;
+
+  factories.emplace_back("beaver_mul", []() {
+    auto prg = util::PRG::create("protobench beaver");
+    const auto xs = ss::additiveShare(FF::random(prg), 2, prg);
+    const auto ys = ss::additiveShare(FF::random(prg), 2, prg);
+    const auto ts = test::randomTriple2<FF>(prg);
+
+    std::vector<std::unique_ptr<proto::Protocol>> ps;
+    for (std::size_t i = 0; i < 2; ++i) {
+      ps.emplace_back(std::make_unique<test::BeaverMul<FF>>(xs[i], ys[i], ts[i]));
+    }
+    return ps;
+  });
+
+  for (const std::size_t n : {2, 4, 8}) {
+    for (const std::size_t rounds : {1, 10}) {
+      for (const std::size_t size : {8, 65536}) {
+        std::stringstream name;
+        name << "exchange/n=" << n << "/rounds=" << rounds << "/size=" << size;
+        factories.emplace_back(name.str(), [n, rounds, size]() {
+          std::vector<std::unique_ptr<proto::Protocol>> ps;
+          for (std::size_t i = 0; i < n; ++i) {
+            ps.emplace_back(std::make_unique<Exchange>(rounds, size));
+          }
+          return ps;
+        });
+      }
+    }
+  }
+
+  for (const std::size_t n : {4, 7}) {
+    for (const std::size_t count : {1000, 100000}) {
+      std::stringstream name;
+      name << "double_sharing/n=" << n << "/count=" << count;
+      factories.emplace_back(name.str(), [n, count]() {
+        std::vector<std::unique_ptr<proto::Protocol>> ps;
+        for (std::size_t i = 0; i < n; ++i) {
+          ps.emplace_back(std::make_unique<DoubleSharing>((n - 1) / 2, count));
+        }
+        return ps;
+      });
+    }
+  }
+
+  return factories;
+}
+
+std::vector<std::size_t> parseList(std::string_view list) {
+  std::vector<std::size_t> values;
+  std::stringstream ss{std::string(list)};
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    values.emplace_back(std::stoull(item));
+  }
+  return values;
+}
+
+// run a measurement a number of times and keep the one with median latency.
+template <typename F>
+bench::ProtocolCost medianOf(std::size_t repetitions, F measure) {
+  std::vector<bench::ProtocolCost> costs;
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    costs.emplace_back(measure());
+  }
+  std::sort(costs.begin(), costs.end(), [](const auto& a, const auto& b) {
+    return a.latency < b.latency;
+  });
+  return costs[costs.size() / 2];
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const auto opts =
+      util::ProgramOptions::Parser(
+          "Protocol benchmarks comparing the simulator with real networks.")
+          .add(util::ProgramArg::optional("filter",
+                                          "regex",
+                                          "",
+                                          "only run protocols matching regex"))
+          .add(util::ProgramArg::optional("rtt",
+                                          "list",
+                                          "0,1",
+                                          "simulated RTTs in ms"))
+          .add(util::ProgramArg::optional("bandwidth",
+                                          "list",
+                                          "10000000000",
+                                          "simulated bandwidths in bits/s"))
+          .add(util::ProgramArg::optional("repetitions",
+                                          "int",
+                                          "5",
+                                          "repetitions of real runs"))
+          .add(util::ProgramArg::optional("port",
+                                          "int",
+                                          "29900",
+                                          "first port to use"))
+          .add(util::ProgramArg::optional("json",
+                                          "file",
+                                          "",
+                                          "write results as JSON to file"))
+          .add(util::ProgramArg::optional(
+              "trace",
+              "file",
+              "",
+              "write a Chrome trace to file (needs SCL_ENABLE_TRACING)"))
+          .add(util::ProgramFlag("instant", "simulate instant channels"))
+          .add(util::ProgramFlag("no_tcp", "skip runs over localhost TCP"))
+          .parse(argc, argv);
+
+  const std::regex filter{std::string(opts.get("filter"))};
+  const auto rtts = parseList(opts.get("rtt"));
+  const auto bandwidths = parseList(opts.get("bandwidth"));
+  const auto repetitions = opts.get<std::size_t>("repetitions");
+  auto port = opts.get<std::size_t>("port");
+
+  std::vector<sim::ChannelConfig> configs;
+  if (opts.flagSet("instant")) {
+    configs.emplace_back(sim::ChannelConfig::Builder{}
+                             .type(sim::ChannelConfig::NetworkType::INSTANT)
+                             .build());
+  } else {
+    for (const auto rtt : rtts) {
+      for (const auto bandwidth : bandwidths) {
+        configs.emplace_back(
+            sim::ChannelConfig::Builder{}.RTT(rtt).bandwidth(bandwidth).build());
+      }
+    }
+  }
+
+  std::stringstream json;
+  json << std::setprecision(std::numeric_limits<double>::max_digits10);
+  json << "{\n  \"context\": ";
+  bench::writeJsonContext(json);
+  json << ",\n  \"results\": [";
+
+  bool first = true;
+  for (const auto& [name, factory] : protocols()) {
+    if (!std::regex_search(name, filter)) {
+      continue;
+    }
+
+    const auto in_process = medianOf(repetitions, [&factory]() {
+      return bench::runProtocolInProcess(factory);
+    });
+
+    std::optional<bench::ProtocolCost> tcp;
+    if (!opts.flagSet("no_tcp")) {
+      tcp = medianOf(repetitions, [&]() {
+        const auto n = factory().size();
+        const auto cost = bench::runProtocolTcp(factory, port);
+        port += n;
+        return cost;
+      });
+    }
+
+    std::cerr << name << "\n"
+              << "  in-process: " << in_process << "\n";
+    if (tcp) {
+      std::cerr << "  tcp:        " << *tcp << "\n";
+    }
+
+    json << (first ? "\n" : ",\n") << "    {"
+         << "\"protocol\": \"" << name << "\", "
+         << "\"measured\": {\"in_process\": " << in_process;
+    if (tcp) {
+      json << ", \"tcp\": " << *tcp;
+    }
+    json << "}, \"simulated\": [";
+
+    for (std::size_t i = 0; i < configs.size(); ++i) {
+      const auto& config = configs[i];
+      const auto simulated = bench::simulateProtocol(factory, config);
+
+      std::cerr << "  simulated:  " << simulated << " " << config << "\n";
+
+      json << (i ? ", " : "") << "{"
+           << "\"rtt_ms\": " << config.RTT() << ", "
+           << "\"bandwidth\": " << config.bandwidth() << ", "
+           << "\"instant\": "
+           << (config.type() == sim::ChannelConfig::NetworkType::INSTANT
+                   ? "true"
+                   : "false")
+           << ", "
+           << "\"cost\": " << simulated << "}";
+    }
+
+    json << "]}";
+    first = false;
+  }
+
+  json << "\n  ]\n}\n";
+
+  const auto json_file = opts.get("json");
+  if (json_file == "-") {
+    std::cout << json.str();
+  } else if (!json_file.empty()) {
+    std::ofstream file{std::string(json_file)};
+    file << json.str();
+  }
+
+  const auto trace_file = opts.get("trace");
+  if (!trace_file.empty()) {
+    std::ofstream file{std::string(trace_file)};
+    util::trace::writeChromeTrace(file);
+  }
+
+  return 0;
+}
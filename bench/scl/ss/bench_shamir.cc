@@ -0,0 +1,75 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+#include "scl/math/fp.h"
+#include "scl/math/vector.h"
+#include "scl/ss/shamir.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+using FF = math::Fp<61>;
+
+}  // namespace
+
+// the argument is the number of shares. The threshold is always (n - 1) / 3,
+// which is the setting where error detection and correction makes sense.
+
+SCL_BENCHMARK("Shamir/share", 4, 16, 64, 256) {
+  auto prg = util::PRG::create("bench shamir share");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto t = (n - 1) / 3;
+  const auto secret = FF::random(prg);
+  while (state.run()) {
+    bench::doNotOptimize(ss::shamirSecretShare(secret, t, n, prg));
+  }
+  state.setItemsPerOp(n);
+}
+
+SCL_BENCHMARK("Shamir/recover_passive", 4, 16, 64, 256) {
+  auto prg = util::PRG::create("bench shamir recover passive");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto t = (n - 1) / 3;
+  const auto shares = ss::shamirSecretShare(FF::random(prg), t, n, prg);
+  const auto subset = shares.subVector(t + 1);
+  while (state.run()) {
+    bench::doNotOptimize(ss::shamirRecoverP(subset));
+  }
+}
+
+SCL_BENCHMARK("Shamir/recover_detect", 4, 16, 64) {
+  auto prg = util::PRG::create("bench shamir recover detect");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto t = (n - 1) / 3;
+  const auto shares = ss::shamirSecretShare(FF::random(prg), t, n, prg);
+  while (state.run()) {
+    bench::doNotOptimize(ss::shamirRecoverD(shares, t));
+  }
+}
+
+SCL_BENCHMARK("Shamir/recover_correct", 4, 16, 64) {
+  auto prg = util::PRG::create("bench shamir recover correct");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto t = (n - 1) / 3;
+  const auto shares = ss::shamirSecretShare(FF::random(prg), t, n, prg);
+  while (state.run()) {
+    bench::doNotOptimize(ss::shamirRecoverC(shares));
+  }
+}
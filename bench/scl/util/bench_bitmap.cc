@@ -0,0 +1,68 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+#include "scl/util/bitmap.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+util::Bitmap randomBitmap(std::size_t n, util::PRG& prg) {
+  util::Bitmap bm(n);
+  const auto bytes = prg.next(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    bm.set(i, bytes[i] & 1);
+  }
+  return bm;
+}
+
+}  // namespace
+
+SCL_BENCHMARK("Bitmap/count", 64, 4096, 1 << 20) {
+  auto prg = util::PRG::create("bench bitmap count");
+  const auto bm = randomBitmap(state.arg(), prg);
+  while (state.run()) {
+    bench::doNotOptimize(bm.count());
+  }
+  state.setBytesPerOp(state.arg() / 8);
+}
+
+SCL_BENCHMARK("Bitmap/xor", 64, 4096, 1 << 20) {
+  auto prg = util::PRG::create("bench bitmap xor");
+  auto bm0 = randomBitmap(state.arg(), prg);
+  const auto bm1 = randomBitmap(state.arg(), prg);
+  while (state.run()) {
+    bm0 ^= bm1;
+    bench::doNotOptimize(bm0);
+  }
+  state.setBytesPerOp(state.arg() / 8);
+}
+
+SCL_BENCHMARK("Bitmap/iterate", 64, 4096, 1 << 20) {
+  auto prg = util::PRG::create("bench bitmap iterate");
+  const auto bm = randomBitmap(state.arg(), prg);
+  while (state.run()) {
+    std::size_t sum = 0;
+    for (auto i = bm.findNextSet(0); i < bm.size(); i = bm.findNextSet(i + 1)) {
+      sum += i;
+    }
+    bench::doNotOptimize(sum);
+  }
+  state.setItemsPerOp(bm.count());
+}
@@ -0,0 +1,55 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+#include "scl/util/prg.h"
+#include "scl/util/sha256.h"
+#include "scl/util/sha3.h"
+
+using namespace scl;
+
+namespace {
+
+template <typename HASH>
+void hash(bench::State& state) {
+  auto prg = util::PRG::create("bench hash");
+  const auto data = prg.next(static_cast<std::size_t>(state.arg()));
+  while (state.run()) {
+    HASH hash;
+    hash.update(data);
+    bench::doNotOptimize(hash.finalize());
+  }
+  state.setBytesPerOp(data.size());
+}
+
+}  // namespace
+
+SCL_BENCHMARK("Sha3/256", 32, 1024, 65536) {
+  hash<util::Sha3<256>>(state);
+}
+
+SCL_BENCHMARK("Sha3/384", 32, 1024, 65536) {
+  hash<util::Sha3<384>>(state);
+}
+
+SCL_BENCHMARK("Sha3/512", 32, 1024, 65536) {
+  hash<util::Sha3<512>>(state);
+}
+
+SCL_BENCHMARK("Sha256", 32, 1024, 65536) {
+  hash<util::Sha256>(state);
+}
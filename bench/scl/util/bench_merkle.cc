@@ -0,0 +1,67 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+#include "scl/util/merkle.h"
+#include "scl/util/prg.h"
+#include "scl/util/sha3.h"
+
+using namespace scl;
+
+namespace {
+
+using Leaf = std::vector<unsigned char>;
+using Tree = util::MerkleTree<util::Sha3<256>, Leaf>;
+
+std::vector<Leaf> randomLeafs(std::size_t n, util::PRG& prg) {
+  std::vector<Leaf> leafs;
+  leafs.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    leafs.emplace_back(prg.next(32));
+  }
+  return leafs;
+}
+
+}  // namespace
+
+SCL_BENCHMARK("MerkleTree/hash", 16, 1024, 16384) {
+  auto prg = util::PRG::create("bench merkle hash");
+  const auto leafs = randomLeafs(state.arg(), prg);
+  while (state.run()) {
+    bench::doNotOptimize(Tree::hash(leafs));
+  }
+  state.setItemsPerOp(leafs.size());
+}
+
+SCL_BENCHMARK("MerkleTree/prove", 16, 1024, 16384) {
+  auto prg = util::PRG::create("bench merkle prove");
+  const auto leafs = randomLeafs(state.arg(), prg);
+  while (state.run()) {
+    bench::doNotOptimize(Tree::prove(leafs, leafs.size() / 2));
+  }
+}
+
+SCL_BENCHMARK("MerkleTree/verify", 16, 1024, 16384) {
+  auto prg = util::PRG::create("bench merkle verify");
+  const auto leafs = randomLeafs(state.arg(), prg);
+  const auto idx = leafs.size() / 2;
+  const auto root = Tree::hash(leafs);
+  const auto proof = Tree::prove(leafs, idx);
+  while (state.run()) {
+    bench::doNotOptimize(Tree::verify(leafs[idx], root, proof));
+  }
+}
@@ -0,0 +1,103 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <vector>
+
+#include "bench.h"
+#include "scl/util/cache.h"
+#include "scl/util/paillier.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+const util::Paillier::SecretKey& benchKey() {
+  static const auto sk = [] {
+    auto prg = util::PRG::create("bench paillier key");
+    return util::Paillier::generate(2048, prg);
+  }();
+  return sk;
+}
+
+}  // namespace
+
+SCL_BENCHMARK("Paillier/encrypt") {
+  auto prg = util::PRG::create("bench paillier encrypt");
+  const auto& pk = benchKey().publicKey();
+  const auto m = math::Number::random(1000, prg);
+  while (state.run()) {
+    bench::doNotOptimize(util::Paillier::encrypt(pk, m, prg));
+  }
+}
+
+SCL_BENCHMARK("Paillier/encrypt_precomputed") {
+  auto prg = util::PRG::create("bench paillier encrypt");
+  auto pk = benchKey().publicKey();
+  pk.precompute();
+  const auto m = math::Number::random(1000, prg);
+  while (state.run()) {
+    bench::doNotOptimize(util::Paillier::encrypt(pk, m, prg));
+  }
+}
+
+SCL_BENCHMARK("Paillier/precompute") {
+  while (state.run()) {
+    auto pk = benchKey().publicKey();
+    pk.precompute();
+    bench::doNotOptimize(pk);
+  }
+}
+
+SCL_BENCHMARK("Paillier/precompute_cached") {
+  const auto dir =
+      std::filesystem::temp_directory_path() / "scl_bench_paillier_cache";
+  util::PrecomputationCache cache(dir);
+  while (state.run()) {
+    auto pk = benchKey().publicKey();
+    pk.precompute(cache);
+    bench::doNotOptimize(pk);
+  }
+  std::filesystem::remove_all(dir);
+}
+
+SCL_BENCHMARK("Paillier/decrypt") {
+  auto prg = util::PRG::create("bench paillier decrypt");
+  const auto& sk = benchKey();
+  const auto c = util::Paillier::encrypt(sk.publicKey(),
+                                         math::Number::random(1000, prg),
+                                         prg);
+  while (state.run()) {
+    bench::doNotOptimize(util::Paillier::decrypt(sk, c));
+  }
+}
+
+SCL_BENCHMARK("Paillier/decrypt_batch", 64) {
+  auto prg = util::PRG::create("bench paillier decrypt batch");
+  const auto& sk = benchKey();
+  const auto n = static_cast<std::size_t>(state.arg());
+  std::vector<math::Number> ms;
+  for (std::size_t i = 0; i < n; ++i) {
+    ms.emplace_back(math::Number::random(1000, prg));
+  }
+  const auto cs = util::Paillier::encrypt(sk.publicKey(), ms, prg);
+  while (state.run()) {
+    bench::doNotOptimize(util::Paillier::decrypt(sk, cs));
+  }
+  state.setItemsPerOp(n);
+}
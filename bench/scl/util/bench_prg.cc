@@ -0,0 +1,39 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bench.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+SCL_BENCHMARK("PRG/next", 16, 1024, 65536, 1048576) {
+  auto prg = util::PRG::create("bench prg");
+  const auto n = static_cast<std::size_t>(state.arg());
+  std::vector<unsigned char> buf(n);
+  while (state.run()) {
+    prg.next(buf);
+    bench::doNotOptimize(buf);
+  }
+  state.setBytesPerOp(n);
+}
+
+SCL_BENCHMARK("PRG/create") {
+  const std::string seed = "bench prg create";
+  while (state.run()) {
+    bench::doNotOptimize(util::PRG::create(seed));
+  }
+}
@@ -0,0 +1,70 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include "bench.h"
+#include "scl/util/cpu.h"
+#include "scl/util/prg.h"
+#include "scl/util/transpose.h"
+
+using namespace scl;
+
+namespace {
+
+// Transpose a random 128 x cols matrix, as done by OT extension, with or
+// without AVX2.
+void transpose128(bench::State& state, bool avx2) {
+  const auto detected = util::cpu::detect();
+  auto f = detected;
+  f.avx2 = avx2 && detected.avx2;
+  util::cpu::restrict(f);
+
+  auto prg = util::PRG::create("bench transpose");
+  const auto cols = static_cast<std::size_t>(state.arg());
+  const auto in = prg.next(128 * cols / 8);
+  std::vector<unsigned char> out(in.size());
+  while (state.run()) {
+    util::transposeBits(in.data(), cols / 8, out.data(), 16, 128, cols);
+    bench::doNotOptimize(out);
+  }
+  state.setBytesPerOp(in.size());
+
+  util::cpu::restrict(detected);
+}
+
+}  // namespace
+
+SCL_BENCHMARK("Transpose/128xN/sse2", 4096, 1 << 16) {
+  transpose128(state, false);
+}
+
+SCL_BENCHMARK("Transpose/128xN/avx2", 4096, 1 << 16) {
+  transpose128(state, true);
+}
+
+SCL_BENCHMARK("Transpose/NxN", 1024, 8192) {
+  auto prg = util::PRG::create("bench transpose square");
+  const auto n = static_cast<std::size_t>(state.arg());
+  const auto in = prg.next(n * n / 8);
+  std::vector<unsigned char> out(in.size());
+  while (state.run()) {
+    util::transposeBits(in.data(), n / 8, out.data(), n / 8, n, n);
+    bench::doNotOptimize(out);
+  }
+  state.setBytesPerOp(in.size());
+}
@@ -0,0 +1,284 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_MATH_AFFINE_POINT_H
+#define SCL_MATH_AFFINE_POINT_H
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "scl/math/curves/ec_ops.h"
+#include "scl/math/ec.h"
+#include "scl/math/vector.h"
+#include "scl/serialization/serializer.h"
+
+namespace scl {
+namespace math {
+
+/**
+ * @brief Elliptic curve point stored in affine coordinates.
+ * @tparam CURVE elliptic curve definition
+ *
+ * <p>An AffinePoint stores only the two affine coordinates of a point, and so
+ * takes up two thirds of the memory of an EC point with three projective
+ * coordinates. It is meant for points which are stored or sent and then used
+ * as the second operand of additions, such as commitments. Adding an
+ * AffinePoint to an EC point uses a cheaper mixed addition, and writing an
+ * AffinePoint does not need an inversion.</p>
+ *
+ * <p>An AffinePoint is not meant for arithmetic. Points are normalized once,
+ * preferably in batches with normalize(), which uses a single inversion for
+ * the whole batch.</p>
+ *
+ * <p>The point-at-infinity is stored as \f$(0, 0)\f$, which is not on any
+ * curve \f$y^2 = x^3 + ax + b\f$ with \f$b \neq 0\f$.</p>
+ */
+template <typename CURVE>
+class AffinePoint final {
+ public:
+  friend class EC<CURVE>;
+
+  /**
+   * @brief The projective point type.
+   */
+  using Point = EC<CURVE>;
+
+  /**
+   * @brief Field that this curve is defined over.
+   */
+  using Field = typename Point::Field;
+
+  /**
+   * @brief Size of an affine point in bytes.
+   *
+   * Affine points are written in the uncompressed format of EC::write().
+   */
+  constexpr static std::size_t byteSize() {
+    return Point::byteSize(false);
+  }
+
+  /**
+   * @brief Reads an affine point from bytes.
+   */
+  static AffinePoint read(const unsigned char* src) {
+    return AffinePoint(Point::read(src));
+  }
+
+  /**
+   * @brief Creates a point from a pair of affine coordinates.
+   * @throws std::invalid_argument if (x, y) is not on the curve.
+   */
+  static AffinePoint fromAffine(const Field& x, const Field& y) {
+    return AffinePoint(Point::fromAffine(x, y));
+  }
+
+  /**
+   * @brief Convert a batch of points to affine coordinates.
+   * @param points the points to convert.
+   * @return the points in affine coordinates.
+   *
+   * Uses Montgomery's trick, so that only a single inversion is needed
+   * regardless of the number of points.
+   */
+  static Vector<AffinePoint> normalize(const Vector<Point>& points);
+
+  /**
+   * @brief Create a new point equal to the point at infinity.
+   */
+  AffinePoint() : m_value{Field::zero(), Field::zero()} {}
+
+  /**
+   * @brief Convert a point to affine coordinates.
+   *
+   * Converting a point takes an inversion, unless it was already normalized.
+   */
+  explicit AffinePoint(const Point& point) : AffinePoint() {
+    if (!point.isPointAtInfinity()) {
+      m_value = point.toAffine();
+    }
+  }
+
+  /**
+   * @brief Convert this point to projective coordinates.
+   */
+  Point toPoint() const {
+    Point point;
+    return point.addMixed(*this);
+  }
+
+  /**
+   * @brief The x coordinate of this point.
+   */
+  const Field& x() const {
+    return m_value[0];
+  }
+
+  /**
+   * @brief The y coordinate of this point.
+   */
+  const Field& y() const {
+    return m_value[1];
+  }
+
+  /**
+   * @brief Check if this point is equal to the point at infinity.
+   */
+  bool isPointAtInfinity() const {
+    return m_value[0] == Field::zero() && m_value[1] == Field::zero();
+  }
+
+  /**
+   * @brief Add an affine point to a point.
+   */
+  friend Point& operator+=(Point& lhs, const AffinePoint& rhs) {
+    return lhs.addMixed(rhs);
+  }
+
+  /**
+   * @brief Add an affine point to a point.
+   */
+  friend Point operator+(const Point& lhs, const AffinePoint& rhs) {
+    Point tmp(lhs);
+    return tmp.addMixed(rhs);
+  }
+
+  /**
+   * @brief Operator == for affine points.
+   */
+  friend bool operator==(const AffinePoint& lhs, const AffinePoint& rhs) {
+    return lhs.m_value[0] == rhs.m_value[0] && lhs.m_value[1] == rhs.m_value[1];
+  }
+
+  /**
+   * @brief Operator != for affine points.
+   */
+  friend bool operator!=(const AffinePoint& lhs, const AffinePoint& rhs) {
+    return !(lhs == rhs);
+  }
+
+  /**
+   * @brief Output this point as a string.
+   */
+  std::string toString() const {
+    return toPoint().toString();
+  }
+
+  /**
+   * @brief Operator << for printing an affine point.
+   */
+  friend std::ostream& operator<<(std::ostream& os, const AffinePoint& p) {
+    return os << p.toString();
+  }
+
+  /**
+   * @brief Write this point to a buffer.
+   *
+   * The output is the same as that of EC::write(), but is computed without an
+   * inversion.
+   */
+  void write(unsigned char* dest, bool compress) const {
+    toPoint().write(dest, compress);
+  }
+
+ private:
+  std::array<Field, 2> m_value;
+};
+
+template <typename CURVE>
+EC<CURVE>& EC<CURVE>::addMixed(const AffinePoint<CURVE>& other) {
+  if (!other.isPointAtInfinity()) {
+    ec::addMixed<CURVE>(m_value, other.m_value);
+  }
+  return *this;
+}
+
+template <typename CURVE>
+Vector<AffinePoint<CURVE>> AffinePoint<CURVE>::normalize(
+    const Vector<Point>& points) {
+  const auto n = points.size();
+  Vector<AffinePoint> affine(n);
+
+  // prefix[i] is the product of the denominators of the first i points,
+  // skipping the point-at-infinity.
+  std::vector<Field> prefix(n);
+  auto product = Field::one();
+  for (std::size_t i = 0; i < n; ++i) {
+    prefix[i] = product;
+    const auto d = ec::denominator<CURVE>(points[i].m_value);
+    if (d != Field::zero()) {
+      product *= d;
+    }
+  }
+
+  auto inverse = product.inverse();
+  for (std::size_t i = n; i-- > 0;) {
+    const auto d = ec::denominator<CURVE>(points[i].m_value);
+    if (d != Field::zero()) {
+      affine[i].m_value =
+          ec::toAffine<CURVE>(points[i].m_value, inverse * prefix[i]);
+      inverse *= d;
+    }
+  }
+  return affine;
+}
+
+}  // namespace math
+
+namespace seri {
+
+/**
+ * @brief Serializer for affine points.
+ *
+ * Affine points are serialized like EC points, i.e., uncompressed.
+ */
+template <typename CURVE>
+struct Serializer<math::AffinePoint<CURVE>> {
+  /**
+   * @brief Get the size of a serialized affine point.
+   */
+  static constexpr std::size_t sizeOf(
+      const math::AffinePoint<CURVE>& /* ignored */) {
+    return math::AffinePoint<CURVE>::byteSize();
+  }
+
+  /**
+   * @brief Write an affine point to a buffer.
+   */
+  static std::size_t write(const math::AffinePoint<CURVE>& point,
+                           unsigned char* buf) {
+    point.write(buf, false);
+    return sizeOf(point);
+  }
+
+  /**
+   * @brief Read an affine point from a buffer.
+   */
+  static std::size_t read(math::AffinePoint<CURVE>& point,
+                          const unsigned char* buf) {
+    point = math::AffinePoint<CURVE>::read(buf);
+    return sizeOf(point);
+  }
+};
+
+}  // namespace seri
+
+}  // namespace scl
+
+#endif  // SCL_MATH_AFFINE_POINT_H
@@ -0,0 +1,644 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_MATH_ARRAY_VECTOR_H
+#define SCL_MATH_ARRAY_VECTOR_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "scl/math/array.h"
+#include "scl/math/vector.h"
+#include "scl/serialization/serializer.h"
+#include "scl/util/prg.h"
+
+namespace scl {
+namespace math {
+
+/**
+ * @brief Vector of Arrays stored as a structure of arrays.
+ * @tparam T the type of the entries of each Array.
+ * @tparam N the number of entries in each Array.
+ *
+ * <p>ArrayVector behaves like <code>Vector<Array<T, N>></code>, but stores
+ * entry \f$k\f$ of every Array contiguously in a <code>Vector<T></code>,
+ * called lane \f$k\f$. Arithmetic is applied one lane at a time, so each loop
+ * runs over contiguous elements of a single type, and a single component of
+ * all elements, e.g., the secrets of a vector of Pedersen shares, is available
+ * through lane() without copying.</p>
+ *
+ * <p>Elements are accessed through a Reference proxy, which converts to and
+ * can be assigned from <code>Array<T, N></code>. ArrayVector is serialized in
+ * the same format as <code>Vector<Array<T, N>></code>, so the two can be used
+ * interchangeably on the wire.</p>
+ *
+ * @code
+ * auto shares = math::ArrayVector<FF, 2>::random(n, prg);
+ * shares.addInPlace(other);
+ * const math::Vector<FF>& secrets = shares.lane(0);
+ * @endcode
+ */
+template <typename T, std::size_t N>
+class ArrayVector final {
+  static_assert(N > 0, "ArrayVector must have at least one lane");
+
+ public:
+  friend struct seri::Serializer<ArrayVector<T, N>>;
+
+  /**
+   * @brief The type of vector elements.
+   */
+  using ValueType = Array<T, N>;
+
+  /**
+   * @brief The type of a lane.
+   */
+  using LaneType = Vector<T>;
+
+  /**
+   * @brief The type of a vector size.
+   */
+  using SizeType = typename Vector<T>::SizeType;
+
+  /**
+   * @brief Mutable reference to an element of an ArrayVector.
+   */
+  class Reference {
+   public:
+    /**
+     * @brief Mutable access to an entry of the element.
+     */
+    T& operator[](std::size_t k) {
+      return m_lanes[k][m_index];
+    }
+
+    /**
+     * @brief Read only access to an entry of the element.
+     */
+    T operator[](std::size_t k) const {
+      return m_lanes[k][m_index];
+    }
+
+    /**
+     * @brief Get the element.
+     */
+    ValueType get() const {
+      ValueType value;
+      for (std::size_t k = 0; k < N; ++k) {
+        value[k] = m_lanes[k][m_index];
+      }
+      return value;
+    }
+
+    /**
+     * @brief Convert to an Array.
+     */
+    operator ValueType() const {
+      return get();
+    }
+
+    /**
+     * @brief Assign an Array to the element.
+     */
+    Reference& operator=(const ValueType& value) {
+      for (std::size_t k = 0; k < N; ++k) {
+        m_lanes[k][m_index] = value[k];
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Assign the element referenced by another Reference.
+     */
+    Reference& operator=(const Reference& other) {
+      return *this = other.get();
+    }
+
+    /**
+     * @brief Add an Array to the element.
+     */
+    Reference& operator+=(const ValueType& value) {
+      for (std::size_t k = 0; k < N; ++k) {
+        m_lanes[k][m_index] += value[k];
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Subtract an Array from the element.
+     */
+    Reference& operator-=(const ValueType& value) {
+      for (std::size_t k = 0; k < N; ++k) {
+        m_lanes[k][m_index] -= value[k];
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Compare the element with an Array.
+     */
+    friend bool operator==(const Reference& lhs, const ValueType& rhs) {
+      return lhs.get() == rhs;
+    }
+
+   private:
+    Reference(std::array<LaneType, N>& lanes, std::size_t index)
+        : m_lanes(lanes), m_index(index) {}
+
+    std::array<LaneType, N>& m_lanes;
+    std::size_t m_index;
+
+    friend class ArrayVector;
+  };
+
+  /**
+   * @brief Create an ArrayVector with random elements.
+   * @param n the size of the vector.
+   * @param prg a PRG used to generate random elements.
+   * @param resource the memory resource to allocate lanes from.
+   *
+   * Uses the PRG in the same way as <code>Vector<Array<T, N>>::random</code>,
+   * so the two produce the same elements.
+   */
+  static ArrayVector random(
+      std::size_t n,
+      util::PRG& prg,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  /**
+   * @brief Create an empty ArrayVector.
+   */
+  ArrayVector() {}
+
+  /**
+   * @brief Create an ArrayVector of some size.
+   * @param n the size.
+   * @param resource the memory resource to allocate lanes from.
+   */
+  explicit ArrayVector(
+      std::size_t n,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : m_lanes(build([n, resource](std::size_t) {
+          return LaneType(n, resource);
+        })) {}
+
+  /**
+   * @brief Create an ArrayVector from its lanes.
+   * @param lanes the lanes. The memory resource of each lane is kept.
+   * @throws std::invalid_argument if the lanes have different sizes.
+   */
+  explicit ArrayVector(std::array<LaneType, N>&& lanes)
+      : m_lanes(std::move(lanes)) {
+    for (const auto& lane : m_lanes) {
+      if (lane.size() != m_lanes[0].size()) {
+        throw std::invalid_argument("lanes must have the same size");
+      }
+    }
+  }
+
+  /**
+   * @brief Convert a Vector of Arrays.
+   * @param vector the vector.
+   * @param resource the memory resource to allocate lanes from.
+   */
+  explicit ArrayVector(
+      const Vector<ValueType>& vector,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : ArrayVector(vector.size(), resource) {
+    for (std::size_t i = 0; i < vector.size(); ++i) {
+      for (std::size_t k = 0; k < N; ++k) {
+        m_lanes[k][i] = vector[i][k];
+      }
+    }
+  }
+
+  /**
+   * @brief Copy an ArrayVector into a specific memory resource.
+   */
+  ArrayVector(const ArrayVector& other, std::pmr::memory_resource* resource)
+      : m_lanes(build([&other, resource](std::size_t k) {
+          return LaneType(other.m_lanes[k], resource);
+        })) {}
+
+  /**
+   * @brief Copy constructor. The copy uses the default memory resource.
+   */
+  ArrayVector(const ArrayVector& other) = default;
+
+  /**
+   * @brief Move constructor. The memory resource is moved as well.
+   */
+  ArrayVector(ArrayVector&& other) noexcept = default;
+
+  /**
+   * @brief Copy assignment. Keeps the memory resource of this ArrayVector.
+   */
+  ArrayVector& operator=(const ArrayVector& other) = default;
+
+  /**
+   * @brief Move assignment. Keeps the memory resource of this ArrayVector.
+   */
+  ArrayVector& operator=(ArrayVector&& other) = default;
+
+  /**
+   * @brief The memory resource that the lanes are allocated from.
+   */
+  std::pmr::memory_resource* resource() const {
+    return m_lanes[0].resource();
+  }
+
+  /**
+   * @brief The size of the vector.
+   */
+  SizeType size() const {
+    return m_lanes[0].size();
+  }
+
+  /**
+   * @brief Check if this vector is empty.
+   */
+  bool empty() const {
+    return size() == 0;
+  }
+
+  /**
+   * @brief Get a lane.
+   * @param k the index of the lane, less than \p N.
+   * @return entry \p k of every element.
+   */
+  LaneType& lane(std::size_t k) {
+    return m_lanes[k];
+  }
+
+  /**
+   * @brief Get a lane.
+   * @param k the index of the lane, less than \p N.
+   * @return entry \p k of every element.
+   */
+  const LaneType& lane(std::size_t k) const {
+    return m_lanes[k];
+  }
+
+  /**
+   * @brief Mutable access to vector elements.
+   */
+  Reference operator[](std::size_t idx) {
+    return Reference(m_lanes, idx);
+  }
+
+  /**
+   * @brief Read only access to vector elements.
+   */
+  ValueType operator[](std::size_t idx) const {
+    ValueType value;
+    for (std::size_t k = 0; k < N; ++k) {
+      value[k] = m_lanes[k][idx];
+    }
+    return value;
+  }
+
+  /**
+   * @brief Add two vectors entry-wise.
+   */
+  ArrayVector add(const ArrayVector& other) const {
+    ensureCompatible(other);
+    return ArrayVector(build([this, &other](std::size_t k) {
+      return m_lanes[k].add(other.m_lanes[k]);
+    }));
+  }
+
+  /**
+   * @brief Add two vectors entry-wise in-place.
+   */
+  ArrayVector& addInPlace(const ArrayVector& other) {
+    ensureCompatible(other);
+    for (std::size_t k = 0; k < N; ++k) {
+      m_lanes[k].addInPlace(other.m_lanes[k]);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Subtract two vectors entry-wise.
+   */
+  ArrayVector subtract(const ArrayVector& other) const {
+    ensureCompatible(other);
+    return ArrayVector(build([this, &other](std::size_t k) {
+      return m_lanes[k].subtract(other.m_lanes[k]);
+    }));
+  }
+
+  /**
+   * @brief Subtract two vectors entry-wise in-place.
+   */
+  ArrayVector& subtractInPlace(const ArrayVector& other) {
+    ensureCompatible(other);
+    for (std::size_t k = 0; k < N; ++k) {
+      m_lanes[k].subtractInPlace(other.m_lanes[k]);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Multiply two vectors entry-wise.
+   */
+  ArrayVector multiplyEntryWise(const ArrayVector& other) const {
+    ensureCompatible(other);
+    return ArrayVector(build([this, &other](std::size_t k) {
+      return m_lanes[k].multiplyEntryWise(other.m_lanes[k]);
+    }));
+  }
+
+  /**
+   * @brief Multiply two vectors entry-wise in-place.
+   */
+  ArrayVector& multiplyEntryWiseInPlace(const ArrayVector& other) {
+    ensureCompatible(other);
+    for (std::size_t k = 0; k < N; ++k) {
+      m_lanes[k].multiplyEntryWiseInPlace(other.m_lanes[k]);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Compute a dot product between this and another vector.
+   * @return an Array with the dot product of each pair of lanes.
+   */
+  ValueType dot(const ArrayVector& other) const {
+    ensureCompatible(other);
+    ValueType value;
+    for (std::size_t k = 0; k < N; ++k) {
+      value[k] = m_lanes[k].dot(other.m_lanes[k]);
+    }
+    return value;
+  }
+
+  /**
+   * @brief Compute the sum over entries of this vector.
+   */
+  ValueType sum() const {
+    ValueType value;
+    for (std::size_t k = 0; k < N; ++k) {
+      value[k] = m_lanes[k].sum();
+    }
+    return value;
+  }
+
+  /**
+   * @brief Scale this vector by a constant.
+   * @param scalar the scalar. Multiplied onto every entry of every element.
+   */
+  template <typename SCALAR>
+    requires requires(const T& e, const SCALAR& s) {
+               { (e) * (s) } -> std::convertible_to<T>;
+             }
+  ArrayVector scalarMultiply(const SCALAR& scalar) const {
+    return ArrayVector(build([this, &scalar](std::size_t k) {
+      return m_lanes[k].scalarMultiply(scalar);
+    }));
+  }
+
+  /**
+   * @brief Scale this vector by an Array of constants.
+   * @param scalar the scalars. Entry \f$k\f$ scales lane \f$k\f$.
+   */
+  template <typename SCALAR>
+    requires requires(const T& e, const SCALAR& s) {
+               { (e) * (s) } -> std::convertible_to<T>;
+             }
+  ArrayVector scalarMultiply(const Array<SCALAR, N>& scalar) const {
+    return ArrayVector(build([this, &scalar](std::size_t k) {
+      return m_lanes[k].scalarMultiply(scalar[k]);
+    }));
+  }
+
+  /**
+   * @brief Scale this vector in-place by a constant.
+   */
+  template <typename SCALAR>
+    requires requires(T& e, const SCALAR& s) {
+               { e *= s } -> std::convertible_to<T>;
+             }
+  ArrayVector& scalarMultiplyInPlace(const SCALAR& scalar) {
+    for (auto& lane : m_lanes) {
+      lane.scalarMultiplyInPlace(scalar);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Scale this vector in-place by an Array of constants.
+   */
+  template <typename SCALAR>
+    requires requires(T& e, const SCALAR& s) {
+               { e *= s } -> std::convertible_to<T>;
+             }
+  ArrayVector& scalarMultiplyInPlace(const Array<SCALAR, N>& scalar) {
+    for (std::size_t k = 0; k < N; ++k) {
+      m_lanes[k].scalarMultiplyInPlace(scalar[k]);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Test if this vector is equal to another vector.
+   */
+  bool equals(const ArrayVector& other) const {
+    bool equal = true;
+    for (std::size_t k = 0; k < N; ++k) {
+      equal &= m_lanes[k].equals(other.m_lanes[k]);
+    }
+    return equal;
+  }
+
+  /**
+   * @brief Operator == overload for ArrayVector.
+   */
+  friend bool operator==(const ArrayVector& left, const ArrayVector& right) {
+    return left.equals(right);
+  }
+
+  /**
+   * @brief Operator != overload for ArrayVector.
+   */
+  friend bool operator!=(const ArrayVector& left, const ArrayVector& right) {
+    return !(left == right);
+  }
+
+  /**
+   * @brief Convert this to a Vector of Arrays.
+   */
+  Vector<ValueType> toVector() const {
+    typename Vector<ValueType>::ContainerType values(resource());
+    values.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+      values.emplace_back(operator[](i));
+    }
+    return Vector<ValueType>(std::move(values));
+  }
+
+  /**
+   * @brief Extract a sub-vector.
+   * @param start the start index, inclusive.
+   * @param end the end index, exclusive.
+   */
+  ArrayVector subVector(std::size_t start, std::size_t end) const {
+    return ArrayVector(build([this, start, end](std::size_t k) {
+      return m_lanes[k].subVector(start, end);
+    }));
+  }
+
+  /**
+   * @brief Extract a sub-vector.
+   *
+   * This method is equivalent to <code>subVector(0, end)</code>.
+   */
+  ArrayVector subVector(std::size_t end) const {
+    return subVector(0, end);
+  }
+
+  /**
+   * @brief Return a string representation of this vector.
+   *
+   * The same as the string representation of the equivalent Vector of Arrays.
+   */
+  std::string toString() const {
+    return toVector().toString();
+  }
+
+  /**
+   * @brief Write a string representation of this vector to a stream.
+   */
+  friend std::ostream& operator<<(std::ostream& os, const ArrayVector& v) {
+    return os << v.toString();
+  }
+
+  /**
+   * @brief The number of bytes needed to write the elements of this vector.
+   */
+  std::size_t byteSize() const {
+    return size() * ValueType::byteSize();
+  }
+
+ private:
+  // Create lanes as f(0), ..., f(N - 1), constructing each in place so that
+  // their memory resources are kept.
+  template <typename F>
+  static std::array<LaneType, N> build(F f) {
+    return [&f]<std::size_t... K>(std::index_sequence<K...>) {
+      return std::array<LaneType, N>{{f(K)...}};
+    }(std::make_index_sequence<N>{});
+  }
+
+  void ensureCompatible(const ArrayVector& other) const {
+    if (size() != other.size()) {
+      throw std::invalid_argument("Vec sizes mismatch");
+    }
+  }
+
+  std::array<LaneType, N> m_lanes;
+};
+
+template <typename T, std::size_t N>
+ArrayVector<T, N> ArrayVector<T, N>::random(
+    std::size_t n,
+    util::PRG& prg,
+    std::pmr::memory_resource* resource) {
+  const auto bytes = n * ValueType::byteSize();
+  auto buf = std::make_unique<unsigned char[]>(bytes);
+  prg.next(buf.get(), bytes);
+
+  ArrayVector v(n, resource);
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t k = 0; k < N; ++k) {
+      const auto offset = i * ValueType::byteSize() + k * T::byteSize();
+      v.m_lanes[k][i] = T::read(buf.get() + offset);
+    }
+  }
+  return v;
+}
+
+}  // namespace math
+
+namespace seri {
+
+/**
+ * @brief Serializer specialization for math::ArrayVector.
+ *
+ * Uses the same format as the serializer for a math::Vector of math::Array.
+ */
+template <typename T, std::size_t N>
+struct Serializer<math::ArrayVector<T, N>> {
+  /**
+   * @brief Size of a vector.
+   * @param vec the vector.
+   */
+  static std::size_t sizeOf(const math::ArrayVector<T, N>& vec) {
+    return Serializer<StlVecSizeType>::sizeOf(vec.size()) + vec.byteSize();
+  }
+
+  /**
+   * @brief Write a math::ArrayVector to a buffer.
+   * @param vec the vector.
+   * @param buf the buffer.
+   * @return the number of bytes written.
+   */
+  static std::size_t write(const math::ArrayVector<T, N>& vec,
+                           unsigned char* buf) {
+    auto offset = Serializer<StlVecSizeType>::write(vec.size(), buf);
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+      for (std::size_t k = 0; k < N; ++k) {
+        vec.m_lanes[k][i].write(buf + offset);
+        offset += T::byteSize();
+      }
+    }
+    return offset;
+  }
+
+  /**
+   * @brief Read a math::ArrayVector from a buffer.
+   * @param vec the vector.
+   * @param buf the buffer.
+   * @return the number of bytes read.
+   */
+  static std::size_t read(math::ArrayVector<T, N>& vec,
+                          const unsigned char* buf) {
+    StlVecSizeType size = 0;
+    auto offset = Serializer<StlVecSizeType>::read(size, buf);
+    for (auto& lane : vec.m_lanes) {
+      lane.container().resize(size);
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      for (std::size_t k = 0; k < N; ++k) {
+        vec.m_lanes[k][i] = T::read(buf + offset);
+        offset += T::byteSize();
+      }
+    }
+    return offset;
+  }
+};
+
+}  // namespace seri
+}  // namespace scl
+
+#endif  // SCL_MATH_ARRAY_VECTOR_H
@@ -68,6 +68,29 @@ template <typename CURVE>
 std::array<FF<typename CURVE::Field>, 2> toAffine(
     const typename CURVE::ValueType& point);
 
+/**
+ * @brief Get the coordinate whose inverse converts a point to affine form.
+ * @param point the point.
+ * @return the denominator of \p point, which is zero exactly when \p point is
+ *         the point-at-infinity.
+ *
+ * Together with the two argument overload of toAffine(), this allows many
+ * points to be converted to affine coordinates with a single inversion.
+ */
+template <typename CURVE>
+FF<typename CURVE::Field> denominator(const typename CURVE::ValueType& point);
+
+/**
+ * @brief Convert a point to affine coordinates given an inverse.
+ * @param point the point to convert. Must not be the point-at-infinity.
+ * @param inverse the inverse of <code>denominator(point)</code>.
+ * @return a set of affine coordinates.
+ */
+template <typename CURVE>
+std::array<FF<typename CURVE::Field>, 2> toAffine(
+    const typename CURVE::ValueType& point,
+    const FF<typename CURVE::Field>& inverse);
+
 /**
  * @brief Add two elliptic curve points in-place.
  * @param out the first point and output
@@ -76,6 +99,16 @@ std::array<FF<typename CURVE::Field>, 2> toAffine(
 template <typename CURVE>
 void add(typename CURVE::ValueType& out, const typename CURVE::ValueType& in);
 
+/**
+ * @brief Add a point in affine coordinates to a point in-place.
+ * @param out the first point and output
+ * @param in the affine coordinates of the second point, which must not be the
+ *        point-at-infinity
+ */
+template <typename CURVE>
+void addMixed(typename CURVE::ValueType& out,
+              const std::array<FF<typename CURVE::Field>, 2>& in);
+
 /**
  * @brief Double an elliptic curve point in-place.
  * @param out the point to double
@@ -27,10 +27,14 @@
 #include "scl/math/curves/ec_ops.h"
 #include "scl/math/ff.h"
 #include "scl/math/number.h"
+#include "scl/util/trace.h"
 
 namespace scl {
 namespace math {
 
+template <typename CURVE>
+class AffinePoint;
+
 /**
  * @brief Elliptic Curve interface.
  * @tparam CURVE elliptic curve definition
@@ -42,6 +46,8 @@ namespace math {
 template <typename CURVE>
 class EC final {
  public:
+  friend class AffinePoint<CURVE>;
+
   /**
    * @brief Field that this curve is defined over.
    */
@@ -86,6 +92,7 @@ class EC final {
    * @brief Reads an elliptic curve point from bytes.
    */
   static EC read(const unsigned char* src) {
+    SCL_TRACE_SPAN("ec", "EC::read");
     EC e;
     ec::fromBytes<CURVE>(e.m_value, src);
     return e;
@@ -135,6 +142,14 @@ class EC final {
     return tmp += rhs;
   }
 
+  /**
+   * @brief Add a point in affine coordinates to this.
+   *
+   * This is cheaper than adding a point in projective coordinates. Defined in
+   * scl/math/affine_point.h.
+   */
+  EC& addMixed(const AffinePoint<CURVE>& other);
+
   /**
    * @brief Double this point.
    */
@@ -171,6 +186,7 @@ class EC final {
    * @brief Perform a scalar multiplication.
    */
   EC& operator*=(const Number& scalar) {
+    SCL_TRACE_SPAN("ec", "EC::scalarMultiply");
     ec::scalarMultiply<CURVE>(m_value, scalar);
     return *this;
   }
@@ -179,6 +195,7 @@ class EC final {
    * @brief Perform a scalar multiplication.
    */
   EC& operator*=(const ScalarField& scalar) {
+    SCL_TRACE_SPAN("ec", "EC::scalarMultiply");
     ec::scalarMultiply<CURVE>(m_value, scalar);
     return *this;
   }
@@ -296,6 +313,7 @@ class EC final {
    * @brief Write this point to a buffer.
    */
   void write(unsigned char* dest, bool compress) const {
+    SCL_TRACE_SPAN("ec", "EC::write");
     ec::toBytes<CURVE>(dest, m_value, compress);
   }  // LCOV_EXCL_LINE
 
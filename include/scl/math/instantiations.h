@@ -0,0 +1,72 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_MATH_INSTANTIATIONS_H
+#define SCL_MATH_INSTANTIATIONS_H
+
+/**
+ * @file
+ * @brief Types for which libscl contains explicit template instantiations.
+ *
+ * <p>When SCL is built with the CMake option SCL_EXPLICIT_INSTANTIATION (the
+ * default), libscl contains instantiations of math::Vector, math::Matrix,
+ * math::Polynomial, math::computeLagrangeBasis and the Shamir and additive
+ * secret-sharing functions for the fields listed below, and of math::Vector,
+ * math::Matrix and math::Polynomial for the rings listed below. The headers
+ * declaring those templates tell the compiler not to instantiate them again
+ * in code that includes them. Other types are instantiated as usual.</p>
+ *
+ * <p>SCL_BUILTIN_FIELDS and SCL_BUILTIN_RINGS are X-macros that call their
+ * argument with each type.</p>
+ */
+
+#include <cstddef>
+
+namespace scl::math {
+
+namespace ff {
+struct Mersenne61;
+struct Mersenne127;
+struct Secp256k1Field;
+struct Secp256k1Scalar;
+}  // namespace ff
+
+template <typename FIELD>
+class FF;
+
+template <std::size_t BITS>
+class Z2k;
+
+}  // namespace scl::math
+
+/**
+ * @brief The built-in finite fields.
+ */
+#define SCL_BUILTIN_FIELDS(X)                     \
+  X(scl::math::FF<scl::math::ff::Mersenne61>)     \
+  X(scl::math::FF<scl::math::ff::Mersenne127>)    \
+  X(scl::math::FF<scl::math::ff::Secp256k1Field>) \
+  X(scl::math::FF<scl::math::ff::Secp256k1Scalar>)
+
+/**
+ * @brief The built-in rings which are not fields.
+ */
+#define SCL_BUILTIN_RINGS(X) \
+  X(scl::math::Z2k<32>)      \
+  X(scl::math::Z2k<64>)
+
+#endif  // SCL_MATH_INSTANTIATIONS_H
@@ -83,4 +83,26 @@ Vector<T> computeLagrangeBasis(const math::Vector<T>& nodes, int x) {
 
 }  // namespace scl::math
 
+#ifdef SCL_EXPLICIT_INSTANTIATION
+
+#include "scl/math/instantiations.h"
+
+/**
+ * @brief Explicit instantiation of computeLagrangeBasis, or its declaration if
+ * \p PREFIX is <code>extern</code>.
+ */
+#define SCL_LAGRANGE_INSTANCE(PREFIX, T)                                     \
+  PREFIX template scl::math::Vector<T> scl::math::computeLagrangeBasis(      \
+      const scl::math::Vector<T>&,                                           \
+      const T&);                                                             \
+  PREFIX template scl::math::Vector<T> scl::math::computeLagrangeBasis(      \
+      const scl::math::Vector<T>&,                                           \
+      int);
+
+#define SCL_EXTERN_LAGRANGE(T) SCL_LAGRANGE_INSTANCE(extern, T)
+SCL_BUILTIN_FIELDS(SCL_EXTERN_LAGRANGE)
+#undef SCL_EXTERN_LAGRANGE
+
+#endif  // SCL_EXPLICIT_INSTANTIATION
+
 #endif  // SCL_MATH_LAGRANGE_H
@@ -18,10 +18,12 @@
 #ifndef SCL_MATH_MATRIX_H
 #define SCL_MATH_MATRIX_H
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <iomanip>
 #include <memory>
+#include <memory_resource>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -31,6 +33,7 @@
 #include "scl/math/lagrange.h"
 #include "scl/math/vector.h"
 #include "scl/serialization/serializer.h"
+#include "scl/util/parallel.h"
 #include "scl/util/prg.h"
 
 namespace scl {
@@ -41,6 +44,10 @@ class Vector;
 
 /**
  * @brief Matrix.
+ *
+ * Like Vector, elements of a Matrix are allocated from a
+ * <code>std::pmr::memory_resource</code> and results of arithmetic are
+ * allocated from the resource of the Matrix they were computed from.
  */
 template <typename ELEMENT>
 class Matrix final {
@@ -52,14 +59,24 @@ class Matrix final {
    */
   using ValueType = ELEMENT;
 
+  /**
+   * @brief The type of the underlying container.
+   */
+  using ContainerType = std::pmr::vector<ELEMENT>;
+
   /**
    * @brief Create a Matrix and populate it with random elements.
    * @param n the number of rows
    * @param m the number of columns
    * @param prg the prg used to generate random elements
+   * @param resource the memory resource to allocate elements from
    * @return a Matrix with random elements.
    */
-  static Matrix<ELEMENT> random(std::size_t n, std::size_t m, util::PRG& prg);
+  static Matrix<ELEMENT> random(
+      std::size_t n,
+      std::size_t m,
+      util::PRG& prg,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
   /**
    * @brief Create an N-by-M Vandermonde matrix.
@@ -136,7 +153,7 @@ class Matrix final {
     if (vec.size() != n * m) {
       throw std::invalid_argument("invalid dimensions");
     }
-    return Matrix<ELEMENT>(n, m, vec);
+    return Matrix<ELEMENT>(n, m, ContainerType(vec.begin(), vec.end()));
   }
 
   /**
@@ -159,17 +176,49 @@ class Matrix final {
    * @brief Create an N-by-M matrix with default initialized values.
    * @param n the number of rows
    * @param m the number of columns
+   * @param resource the memory resource to allocate elements from
    */
-  explicit Matrix(std::size_t n, std::size_t m) {
+  explicit Matrix(
+      std::size_t n,
+      std::size_t m,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : m_rows(n), m_cols(m), m_values(resource) {
     if (n == 0 || m == 0) {
       throw std::invalid_argument("n or m cannot be 0");
     }
-    std::vector<ELEMENT> v(n * m);
-    m_rows = n;
-    m_cols = m;
-    m_values = v;
+    m_values.resize(n * m);
   }
 
+  /**
+   * @brief Copy a matrix into a specific memory resource.
+   * @param other the matrix to copy
+   * @param resource the memory resource to allocate elements from
+   */
+  Matrix(const Matrix& other, std::pmr::memory_resource* resource)
+      : m_rows(other.m_rows),
+        m_cols(other.m_cols),
+        m_values(other.m_values, resource) {}
+
+  /**
+   * @brief Copy constructor. The copy uses the default memory resource.
+   */
+  Matrix(const Matrix& other) = default;
+
+  /**
+   * @brief Move constructor. The memory resource is moved as well.
+   */
+  Matrix(Matrix&& other) noexcept = default;
+
+  /**
+   * @brief Copy assignment. Keeps the memory resource of this matrix.
+   */
+  Matrix& operator=(const Matrix& other) = default;
+
+  /**
+   * @brief Move assignment. Keeps the memory resource of this matrix.
+   */
+  Matrix& operator=(Matrix&& other) = default;
+
   /**
    * @brief Create a square matrix with default initialized values.
    * @param n the dimensions of the matrix
@@ -190,6 +239,14 @@ class Matrix final {
     return m_cols;
   }
 
+  /**
+   * @brief The memory resource that elements of this matrix are allocated
+   * from.
+   */
+  std::pmr::memory_resource* resource() const {
+    return m_values.get_allocator().resource();
+  }
+
   /**
    * @brief Provides mutable access to a matrix element.
    * @param row the row of the element being queried
@@ -218,8 +275,9 @@ class Matrix final {
    *         not equal.
    */
   Matrix add(const Matrix& other) const {
-    Matrix copy(m_rows, m_cols, m_values);
-    return copy.addInPlace(other);
+    Matrix copy(*this, resource());
+    copy.addInPlace(other);
+    return copy;
   }
 
   /**
@@ -246,8 +304,9 @@ class Matrix final {
    *         match.
    */
   Matrix subtract(const Matrix& other) const {
-    Matrix copy(m_rows, m_cols, m_values);
-    return copy.subtractInPlace(other);
+    Matrix copy(*this, resource());
+    copy.subtractInPlace(other);
+    return copy;
   }
 
   /**
@@ -275,8 +334,9 @@ class Matrix final {
    *         match.
    */
   Matrix multiplyEntryWise(const Matrix& other) const {
-    Matrix copy(m_rows, m_cols, m_values);
-    return copy.multiplyEntryWiseInPlace(other);
+    Matrix copy(*this, resource());
+    copy.multiplyEntryWiseInPlace(other);
+    return copy;
   }
 
   /**
@@ -315,6 +375,16 @@ class Matrix final {
    */
   Vector<ELEMENT> multiply(const Vector<ELEMENT>& vector) const;
 
+  /**
+   * @brief Performs a matrix vector product in parallel.
+   * @param vector the vector.
+   * @param policy the execution policy. Its grain is counted in matrix
+   *        entries, and chunks always consist of whole rows.
+   * @return the same vector as <code>multiply(vector)</code>.
+   */
+  Vector<ELEMENT> multiply(const Vector<ELEMENT>& vector,
+                           const util::Parallel& policy) const;
+
   /**
    * @brief Multiply this matrix with a scalar
    * @param scalar the scalar
@@ -323,8 +393,9 @@ class Matrix final {
   template <typename SCALAR>
     requires requires(ELEMENT a, ELEMENT b) { (a) * (b); }
   Matrix scalarMultiply(const SCALAR& scalar) const {
-    Matrix copy(m_rows, m_cols, m_values);
-    return copy.scalarMultiplyInPlace(scalar);
+    Matrix copy(*this, resource());
+    copy.scalarMultiplyInPlace(scalar);
+    return copy;
   }
 
   /**
@@ -417,8 +488,8 @@ class Matrix final {
   }
 
  private:
-  Matrix(std::size_t r, std::size_t c, std::vector<ELEMENT> v)
-      : m_rows(r), m_cols(c), m_values(v){};
+  Matrix(std::size_t r, std::size_t c, ContainerType v)
+      : m_rows(r), m_cols(c), m_values(std::move(v)){};
 
   void ensureCompatible(const Matrix& other) {
     if (m_rows != other.m_rows || m_cols != other.m_cols) {
@@ -428,7 +499,7 @@ class Matrix final {
 
   std::size_t m_rows;
   std::size_t m_cols;
-  std::vector<ELEMENT> m_values;
+  ContainerType m_values;
 
   friend class Vector<ELEMENT>;
 };
@@ -436,9 +507,11 @@ class Matrix final {
 template <typename ELEMENT>
 Matrix<ELEMENT> Matrix<ELEMENT>::random(std::size_t n,
                                         std::size_t m,
-                                        util::PRG& prg) {
+                                        util::PRG& prg,
+                                        std::pmr::memory_resource* resource) {
   std::size_t nelements = n * m;
-  return Matrix(n, m, Vector<ELEMENT>::random(nelements, prg).toStlVector());
+  auto elements = Vector<ELEMENT>::random(nelements, prg, resource);
+  return Matrix(n, m, std::move(elements.container()));
 }
 
 template <typename ELEMENT>
@@ -483,7 +556,7 @@ Matrix<ELEMENT> Matrix<ELEMENT>::multiply(const Matrix<ELEMENT>& other) const {
   const auto p = cols();
   const auto m = other.cols();
 
-  Matrix result(n, m);
+  Matrix result(n, m, resource());
   for (std::size_t i = 0; i < n; i++) {
     for (std::size_t k = 0; k < p; k++) {
       for (std::size_t j = 0; j < m; j++) {
@@ -500,7 +573,7 @@ Vector<ELEMENT> Matrix<ELEMENT>::multiply(const Vector<ELEMENT>& vector) const {
     throw std::invalid_argument("matmul: this->cols() != vec.size()");
   }
 
-  std::vector<ELEMENT> result;
+  ContainerType result(resource());
   result.reserve(rows());
 
   for (std::size_t i = 0; i < rows(); ++i) {
@@ -509,12 +582,33 @@ Vector<ELEMENT> Matrix<ELEMENT>::multiply(const Vector<ELEMENT>& vector) const {
     result.emplace_back(innerProd<ELEMENT>(b, e, vector.begin()));
   }
 
-  return result;
+  return Vector<ELEMENT>(std::move(result));
+}
+
+template <typename ELEMENT>
+Vector<ELEMENT> Matrix<ELEMENT>::multiply(const Vector<ELEMENT>& vector,
+                                          const util::Parallel& policy) const {
+  if (cols() != vector.size()) {
+    throw std::invalid_argument("matmul: this->cols() != vec.size()");
+  }
+
+  auto rows_policy = policy;
+  rows_policy.grain = policy.grain / std::max<std::size_t>(cols(), 1);
+
+  ContainerType result(rows(), resource());
+  util::parallelFor(rows(), rows_policy, [&](std::size_t b, std::size_t e) {
+    for (std::size_t i = b; i < e; ++i) {
+      auto row = m_values.begin() + i * cols();
+      result[i] = innerProd<ELEMENT>(row, row + cols(), vector.begin());
+    }
+  });
+
+  return Vector<ELEMENT>(std::move(result));
 }
 
 template <typename ELEMENT>
 Matrix<ELEMENT> Matrix<ELEMENT>::transpose() const {
-  Matrix t(cols(), rows());
+  Matrix t(cols(), rows(), resource());
   for (std::size_t i = 0; i < rows(); i++) {
     for (std::size_t j = 0; j < cols(); j++) {
       t(j, i) = operator()(i, j);
@@ -914,7 +1008,7 @@ struct Serializer<math::Matrix<ELEMENT>> {
   using DimType = std::uint32_t;
 
   // serializer for vector
-  using S_vec = Serializer<std::vector<ELEMENT>>;
+  using S_vec = Serializer<typename math::Matrix<ELEMENT>::ContainerType>;
 
   // serializer for the dimension
   using S_dim = Serializer<DimType>;
@@ -955,7 +1049,7 @@ struct Serializer<math::Matrix<ELEMENT>> {
     std::size_t offset = 0;
     offset = S_dim::read(rows, buf);
     offset += S_dim::read(cols, buf + offset);
-    std::vector<ELEMENT> elements;
+    typename math::Matrix<ELEMENT>::ContainerType elements;
     S_vec::read(elements, buf + offset);
     mat = math::Matrix<ELEMENT>(rows, cols, std::move(elements));
     return sizeOf(mat);
@@ -965,4 +1059,22 @@ struct Serializer<math::Matrix<ELEMENT>> {
 }  // namespace seri
 }  // namespace scl
 
+#ifdef SCL_EXPLICIT_INSTANTIATION
+
+#include "scl/math/instantiations.h"
+
+/**
+ * @brief Explicit instantiation of Matrix, or its declaration if \p PREFIX is
+ * <code>extern</code>.
+ */
+#define SCL_MATRIX_INSTANCE(PREFIX, T) \
+  PREFIX template class scl::math::Matrix<T>;
+
+#define SCL_EXTERN_MATRIX(T) SCL_MATRIX_INSTANCE(extern, T)
+SCL_BUILTIN_FIELDS(SCL_EXTERN_MATRIX)
+SCL_BUILTIN_RINGS(SCL_EXTERN_MATRIX)
+#undef SCL_EXTERN_MATRIX
+
+#endif  // SCL_EXPLICIT_INSTANTIATION
+
 #endif  // SCL_MATH_MATRIX_H
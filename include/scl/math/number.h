@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <utility>
 
 #include <gmp.h>
 
@@ -43,6 +44,12 @@ Number lcm(const Number& a, const Number& b);
  */
 Number gcd(const Number& a, const Number& b);
 
+/**
+ * @brief Find the next prime.
+ * @return the smallest probable prime strictly greater than \p n.
+ */
+Number nextPrime(const Number& n);
+
 /**
  * @brief Compute the modular inverse of a number.
  * @return \f$val^{-1} \mod mod \f$.
@@ -57,8 +64,55 @@ Number modInverse(const Number& val, const Number& mod);
  */
 Number modExp(const Number& base, const Number& exp, const Number& mod);
 
+/**
+ * @brief Compute \f$a + b\f$ and store the result in \p out.
+ *
+ * \p out may be the same as either of the inputs. Like the other functions
+ * which take an output argument, no memory is allocated if \p out is already
+ * large enough to hold the result.
+ */
+void add(Number& out, const Number& a, const Number& b);
+
+/**
+ * @brief Compute \f$a - b\f$ and store the result in \p out.
+ */
+void subtract(Number& out, const Number& a, const Number& b);
+
+/**
+ * @brief Compute \f$a \cdot b\f$ and store the result in \p out.
+ */
+void multiply(Number& out, const Number& a, const Number& b);
+
+/**
+ * @brief Compute \f$a \cdot b \mod mod\f$ and store the result in \p out.
+ *
+ * \p out should not be the same as \p mod.
+ */
+void mulMod(Number& out, const Number& a, const Number& b, const Number& mod);
+
+/**
+ * @brief Compute \f$base^{exp} \mod mod\f$ and store the result in \p out.
+ *
+ * \p out may be the same as \p base or \p exp but should not be the same as
+ * \p mod. Scratch space for the exponentiation is taken from the stack, so
+ * keeping \p out around between calls makes repeated exponentiations
+ * allocation free.
+ */
+void modExp(Number& out,
+            const Number& base,
+            const Number& exp,
+            const Number& mod);
+
 /**
  * @brief Arbitrary precision integer.
+ *
+ * <p>Number wraps a GMP integer. Moving a Number is O(1) and never allocates,
+ * and the compound assignment operators (<code>+=</code>, <code>*=</code>,
+ * etc.) work in-place and only allocate if the result does not fit in the
+ * memory already held by the Number. Hot loops can additionally use the
+ * functions which take an output argument, such as add(Number&, const
+ * Number&, const Number&) and mulMod(), together with reserve() to avoid
+ * allocating entirely.</p>
  */
 class Number final {
  public:
@@ -141,39 +195,57 @@ class Number final {
     return *this;
   }
 
+  /**
+   * @brief Make sure this Number can hold a value of some size without
+   * allocating.
+   * @param bits the size of the value in bits.
+   *
+   * The value of this Number is preserved if it fits in \p bits bits, and
+   * otherwise set to 0.
+   */
+  void reserve(std::size_t bits);
+
   /**
    * @brief In-place addition of two numbers.
    * @param number the other number
    * @return this
    */
-  Number& operator+=(const Number& number) {
-    *this = *this + number;
-    return *this;
-  }
+  Number& operator+=(const Number& number);
 
   /**
    * @brief Add two numbers.
    * @param number the other number
    * @return the sum of \p this and \p number.
    */
-  Number operator+(const Number& number) const;
+  Number operator+(const Number& number) const&;
+
+  /**
+   * @brief Add two Numbers, reusing the memory of this temporary.
+   */
+  Number operator+(const Number& number) && {
+    return std::move(*this += number);
+  }
 
   /**
    * @brief In-place subtraction of two numbers.
    * @param number the other number
    * @return this.
    */
-  Number& operator-=(const Number& number) {
-    *this = *this - number;
-    return *this;
-  }
+  Number& operator-=(const Number& number);
 
   /**
    * @brief Subtract two Numbers.
    * @param number the other number
    * @return the difference between \p this and \p number.
    */
-  Number operator-(const Number& number) const;
+  Number operator-(const Number& number) const&;
+
+  /**
+   * @brief Subtract two Numbers, reusing the memory of this temporary.
+   */
+  Number operator-(const Number& number) && {
+    return std::move(*this -= number);
+  }
 
   /**
    * @brief Negate this Number.
@@ -186,27 +258,28 @@ class Number final {
    * @param number the other Number
    * @return this.
    */
-  Number& operator*=(const Number& number) {
-    *this = *this * number;
-    return *this;
-  }
+  Number& operator*=(const Number& number);
 
   /**
    * @brief Multiply two Numbers.
    * @param number the other number
    * @return the product of \p this and \p number.
    */
-  Number operator*(const Number& number) const;
+  Number operator*(const Number& number) const&;
+
+  /**
+   * @brief Multiply two Numbers, reusing the memory of this temporary.
+   */
+  Number operator*(const Number& number) && {
+    return std::move(*this *= number);
+  }
 
   /**
    * @brief In-place integer division of two Numbers.
    * @param number the other number
    * @return this.
    */
-  Number& operator/=(const Number& number) {
-    *this = *this / number;
-    return *this;
-  }
+  Number& operator/=(const Number& number);
 
   /**
    * @brief Divide two Numbers.
@@ -220,27 +293,28 @@ class Number final {
    * @param mod the modulus.
    * @return this.
    */
-  Number& operator%=(const Number& mod) {
-    *this = *this % mod;
-    return *this;
-  }
+  Number& operator%=(const Number& mod);
 
   /**
    * @brief Modulo operation.
    * @param mod the modulus.
    * @return \p this modulo \p mod.
    */
-  Number operator%(const Number& mod) const;
+  Number operator%(const Number& mod) const&;
+
+  /**
+   * @brief Modulo operation, reusing the memory of this temporary.
+   */
+  Number operator%(const Number& mod) && {
+    return std::move(*this %= mod);
+  }
 
   /**
    * @brief In-place left shift.
    * @param shift the amount to left shift
    * @return this.
    */
-  Number& operator<<=(int shift) {
-    *this = *this << shift;
-    return *this;
-  }
+  Number& operator<<=(int shift);
 
   /**
    * @brief Perform a left shift of a Number.
@@ -254,10 +328,7 @@ class Number final {
    * @param shift the amount to right shift
    * @return this.
    */
-  Number& operator>>=(int shift) {
-    *this = *this >> shift;
-    return *this;
-  }
+  Number& operator>>=(int shift);
 
   /**
    * @brief Perform a right shift of a Number.
@@ -271,10 +342,7 @@ class Number final {
    * @param number the number to xor this with
    * @return \p this
    */
-  Number& operator^=(const Number& number) {
-    *this = *this ^ number;
-    return *this;
-  }
+  Number& operator^=(const Number& number);
 
   /**
    * @brief Exclusive or of two numbers.
@@ -288,10 +356,7 @@ class Number final {
    * @param number the other number.
    * @return this OR'ed with \p number.
    */
-  Number& operator|=(const Number& number) {
-    *this = *this | number;
-    return *this;
-  }
+  Number& operator|=(const Number& number);
 
   /**
    * @brief operator | for Number.
@@ -305,10 +370,7 @@ class Number final {
    * @param number the other Number.
    * @return this AND'ed with \p number.
    */
-  Number& operator&=(const Number& number) {
-    *this = *this & number;
-    return *this;
-  }
+  Number& operator&=(const Number& number);
 
   /**
    * @brief operator & for Number.
@@ -378,6 +440,13 @@ class Number final {
     return lhs.compare(rhs) >= 0;
   }
 
+  /**
+   * @brief Compute this Number modulo a small positive integer.
+   * @param divisor the divisor. Must not be 0.
+   * @return the remainder, which is always in <code>[0, divisor)</code>.
+   */
+  std::uint64_t remainder(std::uint64_t divisor) const;
+
   /**
    * @brief Get the size of this number in bytes.
    */
@@ -439,8 +508,7 @@ class Number final {
    * @brief STL swap implementation for Number.
    */
   friend void swap(Number& first, Number& second) {
-    using std::swap;
-    swap(first.m_value, second.m_value);
+    mpz_swap(first.m_value, second.m_value);
   }
 
  private:
@@ -448,10 +516,22 @@ class Number final {
 
   friend Number lcm(const Number& a, const Number& b);
   friend Number gcd(const Number& a, const Number& b);
+  friend Number nextPrime(const Number& n);
   friend Number modInverse(const Number& val, const Number& mod);
   friend Number modExp(const Number& base,
                        const Number& exp,
                        const Number& mod);
+  friend void add(Number& out, const Number& a, const Number& b);
+  friend void subtract(Number& out, const Number& a, const Number& b);
+  friend void multiply(Number& out, const Number& a, const Number& b);
+  friend void mulMod(Number& out,
+                     const Number& a,
+                     const Number& b,
+                     const Number& mod);
+  friend void modExp(Number& out,
+                     const Number& base,
+                     const Number& exp,
+                     const Number& mod);
 };
 
 }  // namespace math
@@ -18,22 +18,61 @@
 #ifndef SCL_MATH_POLY_H
 #define SCL_MATH_POLY_H
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <vector>
 
 #include "scl/math/vector.h"
 
 namespace scl::math {
 
+template <typename RING>
+class PolynomialDivisor;
+
+/**
+ * @brief Evaluate a polynomial given by its coefficients.
+ * @param coefficients the coefficients, with the constant term first.
+ * @param x the point to evaluate the polynomial on.
+ * @return f(x) where f is the polynomial, or 0 if \p coefficients is empty.
+ *
+ * This allows evaluating a polynomial without creating a Polynomial, e.g.,
+ * directly on some random coefficients.
+ */
+template <typename RING>
+RING evaluatePolynomial(std::span<const RING> coefficients, const RING& x) {
+  auto it = coefficients.rbegin();
+  auto end = coefficients.rend();
+  if (it == end) {
+    return RING();
+  }
+  auto y = *it++;
+  while (it != end) {
+    y = *it++ + y * x;
+  }
+  return y;
+}
+
 /**
  * @brief Polynomials over rings.
+ *
+ * A polynomial created from a Vector of coefficients allocates from the
+ * memory resource of that Vector, and so does the result of arithmetic on the
+ * polynomial.
  */
 template <typename RING>
 class Polynomial {
  public:
+  friend class PolynomialDivisor<RING>;
+
   /**
    * @brief Construct a polynomial with some supplied coefficients.
    * @param coefficients the coefficients
    *
+   * The polynomial uses the memory resource of \p coefficients.
    */
   static Polynomial<RING> create(const Vector<RING>& coefficients);
 
@@ -54,14 +93,10 @@ class Polynomial {
    * @return f(x) where \p x is the supplied point and f this polynomial.
    */
   RING evaluate(const RING& x) const {
-    auto it = m_coefficients.rbegin();
-    auto end = m_coefficients.rend();
-    auto y = *it++;
-    while (it != end) {
-      y = *it++ + y * x;
-    }
-    return y;
-  }  // LCOV_EXCL_LINE
+    return evaluatePolynomial<RING>(
+        {m_coefficients.data(), m_coefficients.size()},
+        x);
+  }
 
   /**
    * @brief Access coefficients, with the constant term at position 0.
@@ -85,24 +120,87 @@ class Polynomial {
     return m_coefficients;
   }
 
+  /**
+   * @brief The memory resource that coefficients are allocated from.
+   */
+  std::pmr::memory_resource* resource() const {
+    return m_coefficients.resource();
+  }
+
   /**
    * @brief Add two polynomials.
    */
   Polynomial add(const Polynomial& q) const;
 
+  /**
+   * @brief Add a polynomial to this polynomial in-place.
+   *
+   * Reuses the coefficients of this polynomial, so nothing is allocated unless
+   * \p q has larger degree.
+   */
+  Polynomial& addInPlace(const Polynomial& q) {
+    return entryWiseInPlace(q, [](RING& a, const RING& b) { a += b; });
+  }
+
   /**
    * @brief Subtraction two polynomials.
    */
   Polynomial subtract(const Polynomial& q) const;
 
+  /**
+   * @brief Subtract a polynomial from this polynomial in-place.
+   *
+   * Reuses the coefficients of this polynomial, so nothing is allocated unless
+   * \p q has larger degree.
+   */
+  Polynomial& subtractInPlace(const Polynomial& q) {
+    return entryWiseInPlace(q, [](RING& a, const RING& b) { a -= b; });
+  }
+
+  /**
+   * @brief Multiply this polynomial with a constant.
+   */
+  Polynomial scalarMultiply(const RING& c) const {
+    Polynomial p(Vector<RING>(m_coefficients, resource()));
+    return p.scalarMultiplyInPlace(c);
+  }
+
+  /**
+   * @brief Multiply this polynomial with a constant in-place.
+   */
+  Polynomial& scalarMultiplyInPlace(const RING& c) {
+    for (auto& v : m_coefficients) {
+      v *= c;
+    }
+    trim();
+    return *this;
+  }
+
   /**
    * @brief Multiply two polynomials.
+   *
+   * Uses Karatsuba multiplication when both polynomials are large.
    */
   Polynomial multiply(const Polynomial& q) const;
 
+  /**
+   * @brief Multiply two polynomials and store the product in a polynomial.
+   * @param out the output. Its coefficients are reused, so repeated products
+   *        into the same polynomial do not allocate once it is large enough.
+   * @param q the polynomial to multiply with.
+   * @return \p out.
+   *
+   * \p out may be this polynomial or \p q, in which case a temporary is used.
+   */
+  Polynomial& multiplyInto(Polynomial& out, const Polynomial& q) const;
+
   /**
    * @brief Divide two polynomials.
    * @return A pair \f$(q, r)\f$ such that \f$\mathtt{this} = p * q + r\f$.
+   *
+   * Long division is used when either the divisor or the quotient has small
+   * degree. Otherwise the quotient is computed with a PolynomialDivisor. Use a
+   * PolynomialDivisor directly when dividing many polynomials by \p q.
    */
   std::array<Polynomial, 2> divide(const Polynomial& q) const;
 
@@ -170,7 +268,30 @@ class Polynomial {
   }
 
  private:
-  Polynomial(const Vector<RING>& coefficients) : m_coefficients(coefficients){};
+  Polynomial(Vector<RING> coefficients)
+      : m_coefficients(std::move(coefficients)){};
+
+  // Remove leading zero coefficients, keeping at least one coefficient.
+  void trim() {
+    auto n = m_coefficients.size();
+    while (n > 1 && m_coefficients[n - 1] == RING()) {
+      --n;
+    }
+    m_coefficients.resize(n);
+  }
+
+  template <typename OP>
+  Polynomial& entryWiseInPlace(const Polynomial& q, OP op) {
+    const auto n = q.m_coefficients.size();
+    if (n > m_coefficients.size()) {
+      m_coefficients.resize(n);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      op(m_coefficients[i], q.m_coefficients[i]);
+    }
+    trim();
+    return *this;
+  }
 
   Vector<RING> m_coefficients;
 };
@@ -187,16 +308,101 @@ Polynomial<RING> Polynomial<RING>::create(const Vector<RING>& coefficients) {
     }
     --cutoff;
   }
-  const auto c =
-      Vector<RING>(coefficients.begin(), coefficients.begin() + cutoff);
+  auto c = Vector<RING>(coefficients.begin(),
+                        coefficients.begin() + cutoff,
+                        coefficients.resource());
 
   if (c.empty()) {
-    return Polynomial<RING>{};
+    return Polynomial<RING>{Vector<RING>(1, coefficients.resource())};
   }
 
-  return Polynomial<RING>{c};
+  return Polynomial<RING>{std::move(c)};
 }
 
+namespace details {
+
+/**
+ * @brief Operands smaller than this are multiplied with schoolbook
+ * multiplication.
+ */
+constexpr std::size_t KARATSUBA_THRESHOLD = 32;
+
+/**
+ * @brief Divisors and quotients with smaller degree use long division.
+ */
+constexpr std::size_t NEWTON_DIVISION_THRESHOLD = 512;
+
+/**
+ * @brief Multiply two polynomials given by their coefficients.
+ * @param out output of size <code>na + nb - 1</code>. Is overwritten.
+ * @param a the coefficients of the first polynomial.
+ * @param na the number of coefficients in \p a. Must be positive.
+ * @param b the coefficients of the second polynomial.
+ * @param nb the number of coefficients in \p b. Must be positive.
+ */
+template <typename RING>
+void multiplyCoefficients(RING* out,
+                          const RING* a,
+                          std::size_t na,
+                          const RING* b,
+                          std::size_t nb) {
+  if (na < nb) {
+    std::swap(a, b);
+    std::swap(na, nb);
+  }
+  std::fill(out, out + na + nb - 1, RING());
+
+  if (nb < KARATSUBA_THRESHOLD) {
+    for (std::size_t i = 0; i < na; ++i) {
+      for (std::size_t j = 0; j < nb; ++j) {
+        out[i + j] += a[i] * b[j];
+      }
+    }
+    return;
+  }
+
+  // unbalanced operands are multiplied in blocks of nb coefficients of a.
+  if (na > nb) {
+    std::vector<RING> block(2 * nb - 1);
+    for (std::size_t off = 0; off < na; off += nb) {
+      const auto len = std::min(nb, na - off);
+      multiplyCoefficients(block.data(), a + off, len, b, nb);
+      for (std::size_t i = 0; i < len + nb - 1; ++i) {
+        out[off + i] += block[i];
+      }
+    }
+    return;
+  }
+
+  // a = a0 + x^h * a1 and b = b0 + x^h * b1. Then a * b = z0 + x^h * (z1 - z0
+  // - z2) + x^(2h) * z2 with z0 = a0 * b0, z2 = a1 * b1 and z1 = (a0 + a1) *
+  // (b0 + b1). z0 and z2 are written directly to out.
+  const auto h = na / 2;
+  const auto nh = na - h;
+  multiplyCoefficients(out, a, h, b, h);
+  multiplyCoefficients(out + 2 * h, a + h, nh, b + h, nh);
+
+  std::vector<RING> sa(a + h, a + na);
+  std::vector<RING> sb(b + h, b + na);
+  for (std::size_t i = 0; i < h; ++i) {
+    sa[i] += a[i];
+    sb[i] += b[i];
+  }
+  std::vector<RING> z1(2 * nh - 1);
+  multiplyCoefficients(z1.data(), sa.data(), nh, sb.data(), nh);
+  for (std::size_t i = 0; i < 2 * h - 1; ++i) {
+    z1[i] -= out[i];
+  }
+  for (std::size_t i = 0; i < 2 * nh - 1; ++i) {
+    z1[i] -= out[2 * h + i];
+  }
+  for (std::size_t i = 0; i < 2 * nh - 1; ++i) {
+    out[h + i] += z1[i];
+  }
+}
+
+}  // namespace details
+
 /**
  * @brief Pads the coefficients of a polynomial with zeros.
  * @param p the polynomial
@@ -205,7 +411,7 @@ Polynomial<RING> Polynomial<RING>::create(const Vector<RING>& coefficients) {
  */
 template <typename RING>
 Vector<RING> padCoefficients(const Polynomial<RING>& p, std::size_t n) {
-  Vector<RING> c(n);
+  Vector<RING> c(n, p.resource());
   for (std::size_t i = 0; i < n; ++i) {
     if (i <= p.degree()) {
       c[i] = p[i];
@@ -216,33 +422,42 @@ Vector<RING> padCoefficients(const Polynomial<RING>& p, std::size_t n) {
 
 template <typename RING>
 Polynomial<RING> Polynomial<RING>::add(const Polynomial<RING>& q) const {
-  const auto this_larger = degree() > q.degree();
-  const auto n = (this_larger ? degree() : q.degree()) + 1;
-  const auto pp = padCoefficients(*this, n);
-  const auto qp = padCoefficients(q, n);
-  const auto c = pp.add(qp);
-  return Polynomial<RING>::create(c);
+  Polynomial p{padCoefficients(*this, std::max(degree(), q.degree()) + 1)};
+  p.addInPlace(q);
+  return p;
 }
 
 template <typename RING>
 Polynomial<RING> Polynomial<RING>::subtract(const Polynomial<RING>& q) const {
-  const auto this_larger = degree() > q.degree();
-  const auto n = (this_larger ? degree() : q.degree()) + 1;
-  const auto pp = padCoefficients(*this, n);
-  const auto qp = padCoefficients(q, n);
-  const auto c = pp.subtract(qp);
-  return Polynomial<RING>::create(c);
+  Polynomial p{padCoefficients(*this, std::max(degree(), q.degree()) + 1)};
+  p.subtractInPlace(q);
+  return p;
 }
 
 template <typename RING>
 Polynomial<RING> Polynomial<RING>::multiply(const Polynomial<RING>& q) const {
-  Vector<RING> c(degree() + q.degree() + 1);
-  for (std::size_t i = 0; i <= degree(); ++i) {
-    for (std::size_t j = 0; j <= q.degree(); ++j) {
-      c[i + j] += operator[](i) * q[j];
-    }
+  Polynomial p{Vector<RING>(resource())};
+  multiplyInto(p, q);
+  return p;
+}
+
+template <typename RING>
+Polynomial<RING>& Polynomial<RING>::multiplyInto(
+    Polynomial<RING>& out,
+    const Polynomial<RING>& q) const {
+  if (&out == this || &out == &q) {
+    out = multiply(q);
+    return out;
   }
-  return Polynomial<RING>::create(c);
+
+  out.m_coefficients.resize(degree() + q.degree() + 1);
+  details::multiplyCoefficients(out.m_coefficients.data(),
+                                m_coefficients.data(),
+                                degree() + 1,
+                                q.m_coefficients.data(),
+                                q.degree() + 1);
+  out.trim();
+  return out;
 }
 
 /**
@@ -253,11 +468,160 @@ template <typename RING>
 Polynomial<RING> divideLeadingTerms(const Polynomial<RING>& p,
                                     const Polynomial<RING>& q) {
   const auto deg_out = p.degree() - q.degree();
-  Vector<RING> c(deg_out + 1);
+  Vector<RING> c(deg_out + 1, p.resource());
   c[deg_out] = p.leadingTerm() / q.leadingTerm();
   return Polynomial<RING>::create(c);
 }
 
+/**
+ * @brief A polynomial prepared for fast division.
+ *
+ * <p>Division of \f$a\f$ by \f$b\f$ with \f$\deg(a) = n\f$ and
+ * \f$\deg(b) = m\f$ can be computed from the inverse of the reversed
+ * polynomial \f$x^m b(1/x)\f$ modulo \f$x^{n - m + 1}\f$, since the reversed
+ * quotient is the product of this inverse and the reversed \f$a\f$. The
+ * inverse is found with Newton iteration, which doubles the precision in each
+ * step, so a division costs a constant number of polynomial
+ * multiplications.</p>
+ *
+ * <p>A PolynomialDivisor computes this inverse once for dividends up to some
+ * degree, so it pays off when many polynomials are divided by the same
+ * polynomial. The leading term of the divisor must be invertible.</p>
+ */
+template <typename RING>
+class PolynomialDivisor {
+ public:
+  /**
+   * @brief Prepare division by a polynomial.
+   * @param divisor the polynomial to divide by.
+   * @param max_degree the largest degree of a dividend.
+   * @throws std::invalid_argument if \p divisor is the zero polynomial.
+   */
+  PolynomialDivisor(const Polynomial<RING>& divisor, std::size_t max_degree);
+
+  /**
+   * @brief The polynomial that this divides by.
+   */
+  const Polynomial<RING>& divisor() const {
+    return m_divisor;
+  }
+
+  /**
+   * @brief The largest degree of a polynomial that this can divide.
+   */
+  std::size_t maxDegree() const {
+    return m_max_degree;
+  }
+
+  /**
+   * @brief Divide a polynomial by the divisor.
+   * @param p the dividend.
+   * @return A pair \f$(q, r)\f$ such that \f$p = \mathtt{divisor} * q + r\f$.
+   * @throws std::invalid_argument if the degree of \p p exceeds maxDegree().
+   */
+  std::array<Polynomial<RING>, 2> divide(const Polynomial<RING>& p) const;
+
+ private:
+  Polynomial<RING> m_divisor;
+  std::size_t m_max_degree;
+
+  // inverse of the reversed divisor modulo x^(max_degree - deg(divisor) + 1).
+  std::vector<RING> m_inverse;
+};
+
+template <typename RING>
+PolynomialDivisor<RING>::PolynomialDivisor(const Polynomial<RING>& divisor,
+                                           std::size_t max_degree)
+    : m_divisor(divisor), m_max_degree(max_degree) {
+  if (divisor.isZero()) {
+    throw std::invalid_argument("division by 0");
+  }
+
+  const auto m = divisor.degree();
+  if (max_degree < m) {
+    return;
+  }
+  const auto k = max_degree - m + 1;
+
+  // f is the reversed divisor, and g its inverse modulo x^len. Then f * g = 1
+  // + x^len * e, and g - x^len * g * e is the inverse modulo x^(2 * len).
+  std::vector<RING> f(std::min(k, m + 1));
+  for (std::size_t i = 0; i < f.size(); ++i) {
+    f[i] = divisor[m - i];
+  }
+
+  m_inverse.reserve(k);
+  m_inverse.emplace_back(RING(1) / f[0]);
+  std::vector<RING> t(2 * k);
+  std::vector<RING> u(2 * k);
+  while (m_inverse.size() < k) {
+    const auto len = m_inverse.size();
+    const auto next = std::min(2 * len, k);
+    const auto nf = std::min(next, f.size());
+    details::multiplyCoefficients(t.data(),
+                                  f.data(),
+                                  nf,
+                                  m_inverse.data(),
+                                  len);
+    if (nf + len - 1 < next) {
+      std::fill(t.begin() + nf + len - 1, t.begin() + next, RING());
+    }
+    details::multiplyCoefficients(u.data(),
+                                  m_inverse.data(),
+                                  next - len,
+                                  t.data() + len,
+                                  next - len);
+    for (std::size_t i = 0; i < next - len; ++i) {
+      m_inverse.emplace_back(-u[i]);
+    }
+  }
+}
+
+template <typename RING>
+std::array<Polynomial<RING>, 2> PolynomialDivisor<RING>::divide(
+    const Polynomial<RING>& p) const {
+  const auto n = p.degree();
+  const auto m = m_divisor.degree();
+  if (n > m_max_degree) {
+    throw std::invalid_argument("dividend degree too large");
+  }
+  if (n < m) {
+    return {Polynomial<RING>{Vector<RING>(1, p.resource())}, p};
+  }
+
+  // the reversed quotient is the reversed dividend times the inverse, modulo
+  // x^k.
+  const auto k = n - m + 1;
+  std::vector<RING> a(k);
+  for (std::size_t i = 0; i < k; ++i) {
+    a[i] = p[n - i];
+  }
+  std::vector<RING> t(2 * k - 1);
+  details::multiplyCoefficients(t.data(), a.data(), k, m_inverse.data(), k);
+
+  Vector<RING> q(k, p.resource());
+  for (std::size_t i = 0; i < k; ++i) {
+    q[i] = t[k - 1 - i];
+  }
+
+  // only the m lowest coefficients of p - q * divisor can be non-zero.
+  Vector<RING> r(m, p.resource());
+  if (m > 0) {
+    const auto nq = std::min(k, m);
+    std::vector<RING> qb(nq + m);
+    details::multiplyCoefficients(qb.data(),
+                                  q.data(),
+                                  nq,
+                                  m_divisor.m_coefficients.data(),
+                                  m + 1);
+    for (std::size_t i = 0; i < m; ++i) {
+      r[i] = p[i] - qb[i];
+    }
+  }
+
+  return {Polynomial<RING>::create(q), Polynomial<RING>::create(r)};
+}
+
 template <typename RING>
 std::array<Polynomial<RING>, 2> Polynomial<RING>::divide(
     const Polynomial<RING>& q) const {
@@ -265,16 +629,32 @@ std::array<Polynomial<RING>, 2> Polynomial<RING>::divide(
     throw std::invalid_argument("division by 0");
   }
 
-  // https://en.wikipedia.org/wiki/Polynomial_long_division#Pseudocode
+  const auto n = degree();
+  const auto m = q.degree();
+  if (n < m) {
+    return {Polynomial{Vector<RING>(1, resource())}, *this};
+  }
+
+  if (std::min(m, n - m) >= details::NEWTON_DIVISION_THRESHOLD) {
+    return PolynomialDivisor<RING>(q, n).divide(*this);
+  }
 
-  Polynomial p;
-  Polynomial r = *this;
-  while (!r.isZero() && r.degree() >= q.degree()) {
-    const auto t = divideLeadingTerms(r, q);
-    p = p.add(t);
-    r = r.subtract(t.multiply(q));
+  // https://en.wikipedia.org/wiki/Polynomial_long_division, done in place on
+  // a copy of the coefficients of this polynomial.
+  Vector<RING> r(m_coefficients, resource());
+  Vector<RING> d(n - m + 1, resource());
+  const auto inverse = RING(1) / q.leadingTerm();
+  for (std::size_t i = n + 1; i-- > m;) {
+    const auto c = r[i] * inverse;
+    d[i - m] = c;
+    for (std::size_t j = 0; j < m; ++j) {
+      r[i - m + j] -= c * q[j];
+    }
   }
-  return {p, r};
+
+  return {Polynomial<RING>::create(d),
+          Polynomial<RING>::create(
+              Vector<RING>(r.begin(), r.begin() + m, resource()))};
 }
 
 template <typename RING>
@@ -293,4 +673,23 @@ std::string Polynomial<RING>::toString(const char* polynomial_name,
 
 }  // namespace scl::math
 
+#ifdef SCL_EXPLICIT_INSTANTIATION
+
+#include "scl/math/instantiations.h"
+
+/**
+ * @brief Explicit instantiation of Polynomial, or its declaration if \p PREFIX
+ * is <code>extern</code>.
+ */
+#define SCL_POLYNOMIAL_INSTANCE(PREFIX, T)    \
+  PREFIX template class scl::math::Polynomial<T>; \
+  PREFIX template class scl::math::PolynomialDivisor<T>;
+
+#define SCL_EXTERN_POLYNOMIAL(T) SCL_POLYNOMIAL_INSTANCE(extern, T)
+SCL_BUILTIN_FIELDS(SCL_EXTERN_POLYNOMIAL)
+SCL_BUILTIN_RINGS(SCL_EXTERN_POLYNOMIAL)
+#undef SCL_EXTERN_POLYNOMIAL
+
+#endif  // SCL_EXPLICIT_INSTANTIATION
+
 #endif  // SCL_MATH_POLY_H
@@ -0,0 +1,116 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_MATH_PRIME_H
+#define SCL_MATH_PRIME_H
+
+#include <cstddef>
+
+#include "scl/math/number.h"
+#include "scl/util/prg.h"
+
+namespace scl::math {
+
+/**
+ * @brief Test if a number is prime using the Miller-Rabin test.
+ * @param n the number to test.
+ * @param prg a PRG used to select bases for the test.
+ * @param rounds the number of rounds. 0 picks a number of rounds based on the
+ *        size of \p n, which bounds the error probability for a random
+ *        candidate by \f$2^{-100}\f$ (see FIPS 186-4, Appendix C.3).
+ * @return false if \p n is composite and true if \p n is probably prime.
+ *
+ * Candidates are first divided by a list of small primes, and the first
+ * round always uses base 2, so that most composites are rejected cheaply.
+ */
+bool isProbablePrime(const Number& n, util::PRG& prg, std::size_t rounds = 0);
+
+/**
+ * @brief Generate a random prime.
+ * @param bits the size of the prime in bits. Must be at least 32.
+ * @param prg the PRG used to select candidates.
+ * @param threads the number of parallel searches for a prime. 0 uses one per
+ *        thread of util::ThreadPool::global().
+ * @return a prime whose two most significant bits are set, so that the
+ *         product of two such primes has exactly <code>2 * bits</code> bits.
+ *
+ * <p>Candidates are taken from windows of consecutive odd numbers starting at
+ * a random point. Each window is sieved by the small primes before any
+ * Miller-Rabin test is run, and the residues used for the sieve are updated
+ * incrementally when moving to the next window.</p>
+ *
+ * <p>When several searches are used, they run on util::ThreadPool::global()
+ * and each one starts from its own point using a PRG forked from \p prg. The
+ * first prime found is returned. The result, and the state \p prg is left
+ * in, is therefore only deterministic given \p prg when
+ * <code>threads == 1</code>, which is the default.</p>
+ */
+Number generatePrime(std::size_t bits, util::PRG& prg, std::size_t threads = 1);
+
+/**
+ * @brief Generate a random safe prime.
+ * @param bits the size of the prime in bits. Must be at least 32.
+ * @param prg the PRG used to select candidates.
+ * @param threads the number of parallel searches for a prime. 0 uses one per
+ *        thread of util::ThreadPool::global().
+ * @return a prime \f$p = 2q + 1\f$ where \f$q\f$ is also prime, and where the
+ *         two most significant bits of \f$p\f$ are set.
+ *
+ * The sieve removes candidates where either \f$q\f$ or \f$2q + 1\f$ has a
+ * small factor, and \f$p\f$ is only tested if \f$q\f$ passes a base 2 round.
+ * See generatePrime() for how parallel searches are used.
+ */
+Number generateSafePrime(std::size_t bits,
+                         util::PRG& prg,
+                         std::size_t threads = 1);
+
+/**
+ * @brief An RSA modulus together with its factorization.
+ */
+struct RSAModulus {
+  /**
+   * @brief The modulus \f$n = pq\f$.
+   */
+  Number n;
+
+  /**
+   * @brief The first prime factor.
+   */
+  Number p;
+
+  /**
+   * @brief The second prime factor.
+   */
+  Number q;
+};
+
+/**
+ * @brief Generate an RSA modulus.
+ * @param bits the size of the modulus in bits. Must be at least 64.
+ * @param prg the PRG used to generate the primes.
+ * @param threads the number of parallel searches for each prime. 0 uses one
+ *        per thread of util::ThreadPool::global().
+ * @return a modulus of exactly \p bits bits with two distinct prime factors of
+ *         about <code>bits / 2</code> bits each.
+ */
+RSAModulus generateRSAModulus(std::size_t bits,
+                              util::PRG& prg,
+                              std::size_t threads = 1);
+
+}  // namespace scl::math
+
+#endif  // SCL_MATH_PRIME_H
@@ -21,12 +21,14 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <memory_resource>
 #include <sstream>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
 
 #include "scl/serialization/serializer.h"
+#include "scl/util/parallel.h"
 #include "scl/util/prg.h"
 
 namespace scl {
@@ -56,6 +58,11 @@ T innerProd(IT0 xb, IT0 xe, IT1 yb) {
  *
  * This class is a thin wrapper around std::vector meant only to provide some
  * functionality that makes it behave like other classes present in SCUtil.
+ *
+ * Elements are allocated from a <code>std::pmr::memory_resource</code>, which
+ * is the default resource unless another one, e.g., a util::Arena, is passed
+ * when constructing the Vector. Vectors returned by arithmetic on a Vector use
+ * the same resource as that Vector. Copies use the default resource.
  */
 template <typename ELEMENT>
 class Vector final {
@@ -72,34 +79,57 @@ class Vector final {
    */
   using SizeType = std::uint32_t;
 
+  /**
+   * @brief The type of the underlying container.
+   */
+  using ContainerType = std::pmr::vector<ELEMENT>;
+
   /**
    * @brief Iterator type.
    */
-  using iterator = typename std::vector<ELEMENT>::iterator;
+  using iterator = typename ContainerType::iterator;
 
   /**
    * @brief Const iterator type.
    */
-  using const_iterator = typename std::vector<ELEMENT>::const_iterator;
+  using const_iterator = typename ContainerType::const_iterator;
 
   /**
    * @brief Reverse iterator type.
    */
-  using reverse_iterator = typename std::vector<ELEMENT>::reverse_iterator;
+  using reverse_iterator = typename ContainerType::reverse_iterator;
 
   /**
    * @brief Reverse const iterator type.
    */
   using const_reverse_iterator =
-      typename std::vector<ELEMENT>::const_reverse_iterator;
+      typename ContainerType::const_reverse_iterator;
 
   /**
    * @brief Create a Vec and populate it with random elements.
    * @param n the size of the vector
    * @param prg a PRG used to generate random elements
+   * @param resource the memory resource to allocate elements from
    * @return a Vec with random elements.
    */
-  static Vector<ELEMENT> random(std::size_t n, util::PRG& prg);
+  static Vector<ELEMENT> random(
+      std::size_t n,
+      util::PRG& prg,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  /**
+   * @brief Create a Vec with random elements in parallel.
+   * @param n the size of the vector
+   * @param prg a PRG used to generate random elements
+   * @param policy the execution policy
+   * @param resource the memory resource to allocate elements from
+   * @return the same Vec as <code>random(n, prg, resource)</code>.
+   */
+  static Vector<ELEMENT> random(
+      std::size_t n,
+      util::PRG& prg,
+      const util::Parallel& policy,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
   /**
    * @brief Create a vector with values in a range.
@@ -123,11 +153,49 @@ class Vector final {
    */
   Vector() {}
 
+  /**
+   * @brief Create an empty Vec which allocates from a memory resource.
+   * @param resource the memory resource
+   */
+  explicit Vector(std::pmr::memory_resource* resource) : m_values(resource) {}
+
   /**
    * @brief Construct a new Vec of explicit size.
    * @param n the size
+   * @param resource the memory resource to allocate elements from
+   */
+  explicit Vector(
+      std::size_t n,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : m_values(n, resource) {}
+
+  /**
+   * @brief Copy a Vec into a specific memory resource.
+   * @param other the Vec to copy
+   * @param resource the memory resource to allocate elements from
+   */
+  Vector(const Vector& other, std::pmr::memory_resource* resource)
+      : m_values(other.m_values, resource) {}
+
+  /**
+   * @brief Copy constructor. The copy uses the default memory resource.
+   */
+  Vector(const Vector& other) = default;
+
+  /**
+   * @brief Move constructor. The memory resource is moved as well.
+   */
+  Vector(Vector&& other) noexcept = default;
+
+  /**
+   * @brief Copy assignment. Keeps the memory resource of this Vec.
    */
-  explicit Vector(std::size_t n) : m_values(n) {}
+  Vector& operator=(const Vector& other) = default;
+
+  /**
+   * @brief Move assignment. Keeps the memory resource of this Vec.
+   */
+  Vector& operator=(Vector&& other) = default;
 
   /**
    * @brief Construct a vector from an initializer_list.
@@ -139,22 +207,47 @@ class Vector final {
    * @brief Construct a vector from an STL vector.
    * @param values an STL vector
    */
-  Vector(const std::vector<ELEMENT>& values) : m_values(values) {}
+  Vector(const std::vector<ELEMENT>& values)
+      : m_values(values.begin(), values.end()) {}
 
   /**
    * @brief Move construct a vector from an STL vector.
    * @param values an STL vector
+   *
+   * The elements are moved into a new buffer allocated from the default
+   * memory resource, since a std::vector cannot hand over its buffer to a
+   * std::pmr::vector.
+   */
+  Vector(std::vector<ELEMENT>&& values)
+      : m_values(std::make_move_iterator(values.begin()),
+                 std::make_move_iterator(values.end())) {}
+
+  /**
+   * @brief Construct a vector from its underlying container.
+   * @param values the container, including its memory resource
    */
-  Vector(std::vector<ELEMENT>&& values) : m_values(std::move(values)) {}
+  Vector(ContainerType&& values) : m_values(std::move(values)) {}
 
   /**
    * @brief Construct a Vec from a pair of iterators.
    * @param first iterator pointing to the first element
    * @param last iterator pointing to the one past last element
+   * @param resource the memory resource to allocate elements from
    * @tparam It iterator type
    */
   template <typename IT>
-  explicit Vector(IT first, IT last) : m_values(first, last) {}
+  explicit Vector(
+      IT first,
+      IT last,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : m_values(first, last, resource) {}
+
+  /**
+   * @brief The memory resource that elements of this Vec are allocated from.
+   */
+  std::pmr::memory_resource* resource() const {
+    return m_values.get_allocator().resource();
+  }
 
   /**
    * @brief The size of the Vec.
@@ -170,6 +263,16 @@ class Vector final {
     return size() == 0;
   }
 
+  /**
+   * @brief Change the size of this Vec.
+   * @param n the new size. New elements are default constructed.
+   *
+   * Shrinking a Vec keeps its capacity.
+   */
+  void resize(std::size_t n) {
+    m_values.resize(n);
+  }
+
   /**
    * @brief Mutable access to vector elements.
    */
@@ -184,6 +287,20 @@ class Vector final {
     return m_values[idx];
   }
 
+  /**
+   * @brief Pointer to the first element of this vector.
+   */
+  ELEMENT* data() {
+    return m_values.data();
+  }
+
+  /**
+   * @brief Pointer to the first element of this vector.
+   */
+  const ELEMENT* data() const {
+    return m_values.data();
+  }
+
   /**
    * @brief Add two Vec objects entry-wise.
    * @param other the other vector
@@ -191,6 +308,16 @@ class Vector final {
    */
   Vector add(const Vector& other) const;
 
+  /**
+   * @brief Add two Vec objects entry-wise in parallel.
+   * @param other the other vector
+   * @param policy the execution policy
+   * @return the sum of this and \p other.
+   */
+  Vector add(const Vector& other, const util::Parallel& policy) const {
+    return entryWise(other, policy, std::plus<>{});
+  }
+
   /**
    * @brief Add two Vec objects entry-wise in-place.
    * @param other the other vector
@@ -211,6 +338,16 @@ class Vector final {
    */
   Vector subtract(const Vector& other) const;
 
+  /**
+   * @brief Subtract two Vec objects entry-wise in parallel.
+   * @param other the other vector
+   * @param policy the execution policy
+   * @return the difference of this and \p other.
+   */
+  Vector subtract(const Vector& other, const util::Parallel& policy) const {
+    return entryWise(other, policy, std::minus<>{});
+  }
+
   /**
    * @brief Subtract two Vec objects entry-wise in-place.
    * @param other the other vector
@@ -231,6 +368,17 @@ class Vector final {
    */
   Vector multiplyEntryWise(const Vector& other) const;
 
+  /**
+   * @brief Multiply two Vec objects entry-wise in parallel.
+   * @param other the other vector
+   * @param policy the execution policy
+   * @return the product of this and \p other.
+   */
+  Vector multiplyEntryWise(const Vector& other,
+                           const util::Parallel& policy) const {
+    return entryWise(other, policy, std::multiplies<>{});
+  }
+
   /**
    * @brief Multiply two Vec objects entry-wise in-place.
    * @param other the other vector
@@ -254,6 +402,24 @@ class Vector final {
     return innerProd<ELEMENT>(begin(), end(), other.begin());
   }
 
+  /**
+   * @brief Compute a dot product in parallel.
+   * @param other the other vector
+   * @param policy the execution policy
+   * @return the dot (or inner) product of this and \p other.
+   */
+  ELEMENT dot(const Vector& other, const util::Parallel& policy) const {
+    ensureCompatible(other);
+    return util::parallelReduce<ELEMENT>(
+        size(),
+        policy,
+        [this, &other](std::size_t b, std::size_t e) {
+          return innerProd<ELEMENT>(begin() + b,
+                                    begin() + e,
+                                    other.begin() + b);
+        });
+  }
+
   /**
    * @brief Compute the sum over entries of this vector.
    * @return the sum of the entries of this vector.
@@ -276,12 +442,12 @@ class Vector final {
                { (e) * (s) } -> std::convertible_to<ELEMENT>;
              }
   Vector scalarMultiply(const SCALAR& scalar) const {
-    std::vector<ELEMENT> r;
+    ContainerType r(resource());
     r.reserve(size());
     for (const auto& v : m_values) {
       r.emplace_back(scalar * v);
     }
-    return Vector(r);
+    return Vector(std::move(r));
   }
 
   /**
@@ -325,27 +491,42 @@ class Vector final {
    * @brief Convert this vector into a 1-by-N row matrix.
    */
   Matrix<ELEMENT> toRowMatrix() const {
-    return Matrix<ELEMENT>{1, size(), m_values};
+    return Matrix<ELEMENT>{1, size(), ContainerType(m_values, resource())};
   }
 
   /**
    * @brief Convert this vector into a N-by-1 column matrix.
    */
   Matrix<ELEMENT> toColumnMatrix() const {
-    return Matrix<ELEMENT>{size(), 1, m_values};
+    return Matrix<ELEMENT>{size(), 1, ContainerType(m_values, resource())};
+  }
+
+  /**
+   * @brief Copy this Vec object into an std::vector.
+   */
+  std::vector<ELEMENT> toStdVector() const {
+    return std::vector<ELEMENT>(m_values.begin(), m_values.end());
   }
 
   /**
-   * @brief Convert this Vec object to an std::vector.
+   * @brief Removed since the elements are no longer stored in an std::vector.
+   *
+   * Use container() to access the elements in place, or toStdVector() for a
+   * copy.
+   */
+  std::vector<ELEMENT>& toStlVector() = delete;
+
+  /**
+   * @brief The underlying container, including its memory resource.
    */
-  std::vector<ELEMENT>& toStlVector() {
+  ContainerType& container() {
     return m_values;
   }
 
   /**
-   * @brief Convert this Vec object to a const std::vector.
+   * @brief The underlying container, including its memory resource.
    */
-  const std::vector<ELEMENT>& toStlVector() const {
+  const ContainerType& container() const {
     return m_values;
   }
 
@@ -359,7 +540,7 @@ class Vector final {
     if (start > end) {
       throw std::logic_error("invalid range");
     }
-    return Vector<ELEMENT>(begin() + start, begin() + end);
+    return Vector<ELEMENT>(begin() + start, begin() + end, resource());
   }
 
   /**
@@ -484,7 +665,21 @@ class Vector final {
     }
   }
 
-  std::vector<ELEMENT> m_values;
+  template <typename OP>
+  Vector entryWise(const Vector& other,
+                   const util::Parallel& policy,
+                   OP op) const {
+    ensureCompatible(other);
+    ContainerType r(size(), resource());
+    util::parallelFor(size(), policy, [&](std::size_t b, std::size_t e) {
+      for (std::size_t i = b; i < e; ++i) {
+        r[i] = op(m_values[i], other.m_values[i]);
+      }
+    });
+    return Vector(std::move(r));
+  }
+
+  ContainerType m_values;
 };
 
 template <typename ELEMENT>
@@ -496,63 +691,81 @@ Vector<ELEMENT> Vector<ELEMENT>::range(std::size_t start, std::size_t end) {
     return Vector<ELEMENT>{};
   }
 
-  std::vector<ELEMENT> v;
+  ContainerType v;
   v.reserve(end - start);
   for (std::size_t i = start; i < end; ++i) {
     v.emplace_back(ELEMENT{(int)i});
   }
-  return Vector<ELEMENT>(v);
+  return Vector<ELEMENT>(std::move(v));
 }
 
 template <typename ELEMENT>
-Vector<ELEMENT> Vector<ELEMENT>::random(std::size_t n, util::PRG& prg) {
+Vector<ELEMENT> Vector<ELEMENT>::random(std::size_t n,
+                                        util::PRG& prg,
+                                        std::pmr::memory_resource* resource) {
   auto buf = std::make_unique<unsigned char[]>(n * ELEMENT::byteSize());
   prg.next(buf.get(), n * ELEMENT::byteSize());
 
-  std::vector<ELEMENT> elements;
+  ContainerType elements(resource);
   elements.reserve(n);
   for (std::size_t i = 0; i < n; ++i) {
     elements.emplace_back(ELEMENT::read(buf.get() + i * ELEMENT::byteSize()));
   }
 
-  return Vector<ELEMENT>(elements);
+  return Vector<ELEMENT>(std::move(elements));
+}
+
+template <typename ELEMENT>
+Vector<ELEMENT> Vector<ELEMENT>::random(std::size_t n,
+                                        util::PRG& prg,
+                                        const util::Parallel& policy,
+                                        std::pmr::memory_resource* resource) {
+  const auto size = ELEMENT::byteSize();
+  auto buf = std::make_unique<unsigned char[]>(n * size);
+  prg.next(buf.get(), n * size, policy);
+
+  ContainerType elements(n, resource);
+  util::parallelFor(n, policy, [&](std::size_t b, std::size_t e) {
+    for (std::size_t i = b; i < e; ++i) {
+      elements[i] = ELEMENT::read(buf.get() + i * size);
+    }
+  });
+
+  return Vector<ELEMENT>(std::move(elements));
 }
 
 template <typename ELEMENT>
 Vector<ELEMENT> Vector<ELEMENT>::add(const Vector<ELEMENT>& other) const {
   ensureCompatible(other);
-  std::vector<ELEMENT> r;
-  auto n = size();
-  r.reserve(n);
+  const auto n = size();
+  ContainerType r(n, resource());
   for (std::size_t i = 0; i < n; i++) {
-    r.emplace_back(m_values[i] + other.m_values[i]);
+    r[i] = m_values[i] + other.m_values[i];
   }
-  return Vector(r);
+  return Vector(std::move(r));
 }
 
 template <typename ELEMENT>
 Vector<ELEMENT> Vector<ELEMENT>::subtract(const Vector<ELEMENT>& other) const {
   ensureCompatible(other);
-  std::vector<ELEMENT> r;
-  auto n = size();
-  r.reserve(n);
+  const auto n = size();
+  ContainerType r(n, resource());
   for (std::size_t i = 0; i < n; i++) {
-    r.emplace_back(m_values[i] - other.m_values[i]);
+    r[i] = m_values[i] - other.m_values[i];
   }
-  return Vector(r);
+  return Vector(std::move(r));
 }
 
 template <typename ELEMENT>
 Vector<ELEMENT> Vector<ELEMENT>::multiplyEntryWise(
     const Vector<ELEMENT>& other) const {
   ensureCompatible(other);
-  std::vector<ELEMENT> r;
-  auto n = size();
-  r.reserve(n);
+  const auto n = size();
+  ContainerType r(n, resource());
   for (std::size_t i = 0; i < n; i++) {
-    r.emplace_back(m_values[i] * other.m_values[i]);
+    r[i] = m_values[i] * other.m_values[i];
   }
-  return Vector(r);
+  return Vector(std::move(r));
 }
 
 template <typename ELEMENT>
@@ -595,7 +808,7 @@ namespace seri {  // namespace seri
 template <typename ELEMENT>
 struct Serializer<math::Vector<ELEMENT>> {
  private:
-  using S_vec = Serializer<std::vector<ELEMENT>>;
+  using S_vec = Serializer<typename math::Vector<ELEMENT>::ContainerType>;
 
  public:
   /**
@@ -631,4 +844,22 @@ struct Serializer<math::Vector<ELEMENT>> {
 }  // namespace seri
 }  // namespace scl
 
+#ifdef SCL_EXPLICIT_INSTANTIATION
+
+#include "scl/math/instantiations.h"
+
+/**
+ * @brief Explicit instantiation of Vector, or its declaration if \p PREFIX is
+ * <code>extern</code>.
+ */
+#define SCL_VECTOR_INSTANCE(PREFIX, T) \
+  PREFIX template class scl::math::Vector<T>;
+
+#define SCL_EXTERN_VECTOR(T) SCL_VECTOR_INSTANCE(extern, T)
+SCL_BUILTIN_FIELDS(SCL_EXTERN_VECTOR)
+SCL_BUILTIN_RINGS(SCL_EXTERN_VECTOR)
+#undef SCL_EXTERN_VECTOR
+
+#endif  // SCL_EXPLICIT_INSTANTIATION
+
 #endif  // SCL_MATH_VECTOR_H
@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <stdexcept>
+#include <type_traits>
 
 #include "scl/math/z2k/z2k_ops.h"
 #include "scl/util/prg.h"
@@ -40,9 +41,21 @@ class Z2k final {
  public:
   /**
    * @brief The raw type of a Z2k element.
-   */
-  using ValueType =
-      std::conditional_t<(BITS <= 64), std::uint64_t, __uint128_t>;
+   *
+   * This is the narrowest unsigned type with at least \p BITS bits, so that
+   * e.g., a Vector of Z2k<32> elements uses 4 bytes per element, and
+   * entry-wise operations on it can use 32-bit SIMD lanes.
+   */
+  using ValueType = std::conditional_t<
+      (BITS <= 8),
+      std::uint8_t,
+      std::conditional_t<
+          (BITS <= 16),
+          std::uint16_t,
+          std::conditional_t<
+              (BITS <= 32),
+              std::uint32_t,
+              std::conditional_t<(BITS <= 64), std::uint64_t, __uint128_t>>>>;
 
   /**
    * @brief The number of bytes needed to store a ring element.
@@ -113,6 +126,15 @@ class Z2k final {
    */
   explicit constexpr Z2k(const ValueType& value) : m_value(value) {}
 
+  /**
+   * @brief Create a new ring element from an integer.
+   *
+   * \p value is reduced modulo \f$2^n\f$, where \f$n\f$ is the number of bits
+   * in ValueType.
+   */
+  template <typename T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+  explicit constexpr Z2k(T value) : m_value(static_cast<ValueType>(value)) {}
+
   /**
    * @brief Create a new ring element equal to 0.
    */
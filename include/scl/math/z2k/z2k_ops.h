@@ -27,6 +27,27 @@
 
 namespace scl::math::z2k {
 
+/**
+ * @brief Type used for arithmetic on values of type T.
+ *
+ * Types narrower than <code>unsigned</code> are promoted to <code>int</code>
+ * by arithmetic, where e.g., a product of two 16-bit values can overflow.
+ */
+template <typename T>
+using ArithmeticType = std::common_type_t<T, unsigned>;
+
+/**
+ * @brief Mask with the K lowest bits set.
+ */
+template <typename T, std::size_t K>
+constexpr T mask() {
+  if constexpr (K >= 8 * sizeof(T)) {
+    return static_cast<T>(~static_cast<T>(0));
+  } else {
+    return static_cast<T>((static_cast<T>(1) << K) - 1);
+  }
+}
+
 /**
  * @brief Add two values modulo a power of 2 without normalization.
  */
@@ -48,7 +69,8 @@ void subtract(T& dst, const T& op) {
  */
 template <typename T>
 void multiply(T& dst, const T& op) {
-  dst *= op;
+  using U = ArithmeticType<T>;
+  dst = static_cast<T>(static_cast<U>(dst) * static_cast<U>(op));
 }
 
 /**
@@ -56,7 +78,7 @@ void multiply(T& dst, const T& op) {
  */
 template <typename T>
 void negate(T& v) {
-  v = -v;
+  v = static_cast<T>(-static_cast<ArithmeticType<T>>(v));
 }
 
 /**
@@ -70,9 +92,8 @@ unsigned lsb(T& v) {
 /**
  * @brief Compute the inverse of a number modulo a power of 2.
  *
- * This function only works on bit-lengths smaller-or-equal than 128. In theses
- * cases, the template type T is guaranteed to be either std::uint64_t or
- * __uint128_t.
+ * This function only works on bit-lengths smaller-or-equal than 128. In these
+ * cases, the template type T is an unsigned integer type of at most 128 bits.
  *
  * @param v the value to invert
  */
@@ -82,24 +103,24 @@ void invert(T& v) {
     throw std::invalid_argument("value not invertible modulo 2^K");
   }
 
+  using U = ArithmeticType<T>;
+  const U x = v;
   std::size_t bits = 5;
-  T z = ((v * 3) ^ 2);
+  U z = ((x * 3) ^ 2);
   while (bits <= K) {
-    z *= 2 - v * z;
+    z *= 2 - x * z;
     bits *= 2;
   }
 
-  v = z;
+  v = static_cast<T>(z);
 }
 
-#define SCL_MASK(T, K) ((static_cast<T>(1) << (K)) - 1)
-
 /**
  * @brief Compute equality modulo a power of 2.
  */
 template <typename T, std::size_t K, std::enable_if_t<(K <= 128), bool> = true>
 bool equal(const T& a, const T& b) {
-  return (a & SCL_MASK(T, K)) == (b & SCL_MASK(T, K));
+  return static_cast<T>(a & mask<T, K>()) == static_cast<T>(b & mask<T, K>());
 }
 
 /**
@@ -107,8 +128,9 @@ bool equal(const T& a, const T& b) {
  */
 template <typename T, std::size_t K, std::enable_if_t<(K <= 128), bool> = true>
 void fromBytes(T& v, const unsigned char* src) {
-  v = *(const T*)src;
-  v &= SCL_MASK(T, K);
+  v = 0;
+  std::memcpy(&v, src, (K - 1) / 8 + 1);
+  v &= mask<T, K>();
 }
 
 /**
@@ -118,7 +140,7 @@ template <typename T, std::size_t K, std::enable_if_t<(K <= 128), bool> = true>
 void toBytes(const T& v, unsigned char* dest) {
   // normalization is deferred until elements are written somewhere, so v
   // needs to be normalized before we can write it.
-  auto w = v & SCL_MASK(T, K);
+  const T w = v & mask<T, K>();
   std::memcpy(dest, (unsigned char*)&w, (K - 1) / 8 + 1);
 }
 
@@ -130,7 +152,7 @@ void toBytes(const T& v, unsigned char* dest) {
 template <typename T, std::size_t K, std::enable_if_t<(K <= 128), bool> = true>
 void convertIn(T& v, const std::string& str) {
   v = util::fromHexString<T>(str);
-  v &= SCL_MASK(T, K);
+  v &= mask<T, K>();
 }
 
 /**
@@ -139,12 +161,11 @@ void convertIn(T& v, const std::string& str) {
  */
 template <typename T, std::size_t K, std::enable_if_t<(K <= 128), bool> = true>
 std::string toString(const T& v) {
-  auto w = v & SCL_MASK(T, K);
+  // widen narrow values, which would otherwise be printed as characters.
+  const ArithmeticType<T> w = v & mask<T, K>();
   return util::toHexString(w);
 }
 
-#undef SCL_MASK
-
 }  // namespace scl::math::z2k
 
 #endif  // SCL_MATH_Z2K_Z2K_OPS_H
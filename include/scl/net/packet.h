@@ -19,12 +19,14 @@
 #define SCL_NET_PACKET_H
 
 #include <cstddef>
-#include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <memory_resource>
+#include <utility>
 
 #include "scl/serialization/serializable.h"
 #include "scl/serialization/serializer.h"
+#include "scl/util/trace.h"
 
 namespace scl::net {
 
@@ -61,20 +63,12 @@ namespace scl::net {
  *   std::ptrdiff_t write_ptr; // pointer into buffer
  * };
  * @endcode
+ *
+ * <p>The buffer is allocated from a <code>std::pmr::memory_resource</code>,
+ * which makes it possible to e.g., build the packets of a protocol round in a
+ * util::Arena.
  */
 class Packet {
- private:
-  // the internal buffer is resized using realloc so it has to be allocated
-  // using malloc and deallocated using free, as opposed to new/delete.
-  struct FreeDeleter {
-    void operator()(void* p) const {
-      std::free(p);
-    }
-  };
-
-  // Internal buffer type.
-  using Buffer = std::unique_ptr<unsigned char[], FreeDeleter>;
-
  public:
   /**
    * @brief Type used to denote the size of a packet.
@@ -88,23 +82,48 @@ class Packet {
   /**
    * @brief Construct a new packet.
    * @param initial_size the initial amount of bytes to allocate.
+   * @param resource the memory resource to allocate the buffer from.
    */
-  Packet(std::size_t initial_size = 1024)
-      : m_buffer(static_cast<unsigned char*>(std::malloc(initial_size))),
+  Packet(
+      std::size_t initial_size = 1024,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : m_resource(resource),
+        m_buffer(allocate(resource, initial_size)),
         m_cap(initial_size),
         m_read_ptr(0),
         m_write_ptr(0) {}
 
   /**
-   * @brief Copy constructor.
+   * @brief Copy constructor. The copy uses the default memory resource.
    * @param packet the packet to copy.
    */
   Packet(const Packet& packet)
-      : m_buffer(static_cast<unsigned char*>(std::malloc(packet.m_cap))),
+      : m_resource(std::pmr::get_default_resource()),
+        m_buffer(allocate(m_resource, packet.m_cap)),
         m_cap(packet.m_cap),
         m_read_ptr(packet.m_read_ptr),
         m_write_ptr(packet.m_write_ptr) {
-    std::memcpy(m_buffer.get(), packet.m_buffer.get(), packet.m_write_ptr);
+    std::memcpy(m_buffer, packet.m_buffer, packet.m_write_ptr);
+  }
+
+  /**
+   * @brief Move constructor.
+   * @param packet the packet to move from. Left as an empty packet.
+   */
+  Packet(Packet&& packet) noexcept
+      : m_resource(packet.m_resource),
+        m_buffer(std::exchange(packet.m_buffer, nullptr)),
+        m_cap(std::exchange(packet.m_cap, 0)),
+        m_read_ptr(std::exchange(packet.m_read_ptr, 0)),
+        m_write_ptr(std::exchange(packet.m_write_ptr, 0)) {}
+
+  /**
+   * @brief Destructor.
+   */
+  ~Packet() {
+    if (m_buffer != nullptr) {
+      m_resource->deallocate(m_buffer, m_cap, 1);
+    }
   }
 
   /**
@@ -127,6 +146,7 @@ class Packet {
    */
   template <seri::Serializable T>
   T read() {
+    SCL_TRACE_SPAN("serialization", "Packet::read");
     T v;
     const auto sz = seri::Serializer<T>::read(v, get() + m_read_ptr);
     m_read_ptr += sz;
@@ -143,6 +163,7 @@ class Packet {
    */
   template <seri::Serializable T>
   std::size_t write(const T& obj) {
+    SCL_TRACE_SPAN("serialization", "Packet::write");
     const auto sz = seri::Serializer<T>::sizeOf(obj);
     reserveSpace(sz);
     seri::Serializer<T>::write(obj, get() + m_write_ptr);
@@ -190,14 +211,22 @@ class Packet {
    * @brief Get a raw const pointer to the content of this packet.
    */
   const unsigned char* get() const {
-    return m_buffer.get();
+    return m_buffer;
   }
 
   /**
    * @brief Get a raw pointer to the conte of this packet.
    */
   unsigned char* get() {
-    return m_buffer.get();
+    return m_buffer;
+  }
+
+  /**
+   * @brief The memory resource that the buffer of this packet is allocated
+   * from.
+   */
+  std::pmr::memory_resource* resource() const {
+    return m_resource;
   }
 
   /**
@@ -269,6 +298,7 @@ class Packet {
    */
   friend void swap(Packet& first, Packet& second) {
     using std::swap;
+    swap(first.m_resource, second.m_resource);
     swap(first.m_buffer, second.m_buffer);
     swap(first.m_cap, second.m_cap);
     swap(first.m_read_ptr, second.m_read_ptr);
@@ -276,23 +306,27 @@ class Packet {
   }
 
  private:
-  Buffer m_buffer;
+  std::pmr::memory_resource* m_resource;
+  unsigned char* m_buffer;
   std::size_t m_cap;
   std::ptrdiff_t m_read_ptr;
   std::ptrdiff_t m_write_ptr;
 
-  // Resize the internal buffer to some new size. This may move the entire
-  // packet to somewhere else in memory.
+  static unsigned char* allocate(std::pmr::memory_resource* resource,
+                                 std::size_t size) {
+    return static_cast<unsigned char*>(resource->allocate(size, 1));
+  }
+
+  // Resize the internal buffer to some new size. This moves the entire packet
+  // to somewhere else in memory. Throws std::bad_alloc if the memory resource
+  // cannot provide the space.
   void resizeBuffer(std::size_t new_size) {
-    auto* buf = m_buffer.release();
-    auto* buf_new = std::realloc(buf, new_size);
-    if (buf_new == nullptr) {
-      // Not testing this at the moment. It would be better if allocation of the
-      // internal buffer has handled by an allocator type of some sort. Possibly
-      // one from the standard library.
-      throw std::bad_alloc();  // LCOV_EXCL_LINE
+    auto* buf_new = allocate(m_resource, new_size);
+    if (m_buffer != nullptr) {
+      std::memcpy(buf_new, m_buffer, m_write_ptr);
+      m_resource->deallocate(m_buffer, m_cap, 1);
     }
-    m_buffer.reset(static_cast<unsigned char*>(buf_new));
+    m_buffer = buf_new;
     m_cap = new_size;
   }
 
@@ -28,6 +28,7 @@
 #include "scl/net/config.h"
 #include "scl/net/sys_iface.h"
 #include "scl/net/tcp_utils.h"
+#include "scl/util/trace.h"
 
 namespace scl::net {
 
@@ -121,45 +122,34 @@ coro::Task<void> TcpChannel<SYS>::send(Packet&& packet) {
   co_await send(packet);
 }
 
-template <typename SYS>
-coro::Task<void> TcpChannel<SYS>::send(const Packet& packet) {
-  // Write the packet size to a buffer.
-  const Packet::SizeType packet_size = packet.size();
-  const auto packet_size_size = sizeof(Packet::SizeType);
-  unsigned char packet_size_buf[packet_size_size] = {0};
-  std::memcpy(packet_size_buf, &packet_size, packet_size_size);
-
-  // assume writing the packet size won't block. It probably wont.
-  if (SYS::write(m_socket, packet_size_buf, packet_size_size) < 0) {
-    throw std::system_error(SYS::getError(),
-                            std::generic_category(),
-                            "writing packet size failed");
-  }
+namespace details {
 
-  // Write content of packet. This may block, in which case a RetrySend
-  // awaitable is created and this coroutine is suspended.
-  std::size_t rem = packet.size();
-  const unsigned char* data = packet.get();
+// Helper coroutine for writing some amount of bytes from a buffer to a socket.
+// If the write would block, then the call is suspended until the socket becomes
+// writable again.
+template <typename SYS>
+coro::Task<void> sendFrom(SocketType socket,
+                          const unsigned char* src,
+                          std::size_t nbytes) {
+  std::size_t rem = nbytes;
   while (rem > 0) {
-    const auto written = SYS::write(m_socket, data, rem);
+    const auto written = SYS::write(socket, src, rem);
     if (written < 0) {
       const auto err = SYS::getError();
       if (err == EAGAIN || err == EWOULDBLOCK) {
-        co_await [socket = m_socket]() {
-          return details::pollSocket<SYS>(socket, POLLOUT);
-        };
-      } else {
-        throw std::system_error(err, std::generic_category(), "send failed");
+        SCL_TRACE_ASYNC_SPAN("net", "TcpChannel::waitSend");
+        co_await
+            [socket = socket]() { return pollSocket<SYS>(socket, POLLOUT); };
+        continue;
       }
+      throw std::system_error(err, std::generic_category(), "send failed");
     }
 
     rem -= written;
-    data += written;
+    src += written;
   }
 }
 
-namespace details {
-
 // Helper coroutine for reading some amount of bytes from a socket into a
 // buffer. If the read would block, then the call is suspended using the
 // provided scheduler.
@@ -173,11 +163,18 @@ coro::Task<void> recvInto(SocketType socket,
     if (read < 0) {
       const auto err = SYS::getError();
       if (err == EAGAIN || err == EWOULDBLOCK) {
+        SCL_TRACE_ASYNC_SPAN("net", "TcpChannel::waitRecv");
         co_await
             [socket = socket]() { return pollSocket<SYS>(socket, POLLIN); };
-      } else {
-        throw std::system_error(err, std::generic_category(), "recv failed");
+        continue;
       }
+      throw std::system_error(err, std::generic_category(), "recv failed");
+    }
+
+    if (read == 0) {
+      throw std::system_error(ECONNRESET,
+                              std::generic_category(),
+                              "connection closed by peer");
     }
 
     rem -= read;
@@ -187,8 +184,26 @@ coro::Task<void> recvInto(SocketType socket,
 
 }  // namespace details
 
+template <typename SYS>
+coro::Task<void> TcpChannel<SYS>::send(const Packet& packet) {
+  SCL_TRACE_ASYNC_SPAN("net", "TcpChannel::send");
+
+  // Write the packet size to a buffer.
+  const Packet::SizeType packet_size = packet.size();
+  const auto packet_size_size = sizeof(Packet::SizeType);
+  unsigned char packet_size_buf[packet_size_size] = {0};
+  std::memcpy(packet_size_buf, &packet_size, packet_size_size);
+
+  // Write the size and then the content of the packet. Either may block, in
+  // which case this coroutine is suspended until the socket is writable.
+  co_await details::sendFrom<SYS>(m_socket, packet_size_buf, packet_size_size);
+  co_await details::sendFrom<SYS>(m_socket, packet.get(), packet.size());
+}
+
 template <typename SYS>
 coro::Task<Packet> TcpChannel<SYS>::recv() {
+  SCL_TRACE_ASYNC_SPAN("net", "TcpChannel::recv");
+
   unsigned char packet_size_buf[sizeof(Packet::SizeType)] = {0};
 
   // read size of the packet.
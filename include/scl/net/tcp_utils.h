@@ -131,7 +131,7 @@ Connection acceptConnection(SocketType server_socket) {
  * @tparam Sys interface for system calls
  * @param hostname the hostname of the remote peer
  * @param port the port of the remote peer
- * @return A socket.
+ * @return A socket, or -1 if the remote refused the connection.
  */
 template <typename SYS = SysIFace>
 SocketType connectAsClient(const std::string& hostname, int port) {
@@ -156,7 +156,14 @@ SocketType connectAsClient(const std::string& hostname, int port) {
   }
 
   if (SYS::connect(sock, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
-    throw std::system_error(SYS::getError(),
+    const auto error = SYS::getError();
+    // the remote may simply not be listening yet, in which case the caller
+    // can try again later.
+    if (error == ECONNREFUSED) {
+      SYS::close(sock);
+      return -1;
+    }
+    throw std::system_error(error,
                             std::generic_category(),
                             "could not connect");
   }
@@ -183,7 +190,7 @@ void markSocketNonBlocking(SocketType socket) {
 template <typename SYS = SysIFace>
 bool pollSocket(SocketType socket, short event) {
   struct pollfd fds {
-    socket, POLLIN, 0
+    socket, event, 0
   };
 
   auto r = SYS::poll(&fds, 1, 0);
@@ -194,7 +201,8 @@ bool pollSocket(SocketType socket, short event) {
                             "poll failed");
   }
 
-  return r > 0 && fds.revents == event;
+  // errors are reported as ready so that the subsequent read or write fails.
+  return r > 0 && (fds.revents & (event | POLLERR | POLLHUP)) != 0;
 }
 
 }  // namespace details
@@ -0,0 +1,85 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_OT_BASE_OT_H
+#define SCL_OT_BASE_OT_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "scl/coro/task.h"
+#include "scl/math/curves/secp256k1.h"
+#include "scl/math/ec.h"
+#include "scl/net/channel.h"
+#include "scl/util/bitmap.h"
+#include "scl/util/prg.h"
+
+namespace scl::ot {
+
+/**
+ * @brief A 128-bit OT message or key.
+ */
+using Block = std::array<unsigned char, 16>;
+
+/**
+ * @brief Random oblivious transfer based on the CDH assumption.
+ *
+ * <p>Implements the protocol by Chou and Orlandi over secp256k1. The sender
+ * learns two random keys for each OT, and the receiver learns the one selected
+ * by its choice bit. Any number of OTs is done in a single round trip, and each
+ * OT costs a couple of scalar multiplications for each party.</p>
+ *
+ * <p>Base OTs are slow compared to OT extension, and are mainly meant for
+ * setting up IknpSender and IknpReceiver.</p>
+ *
+ * @see https://eprint.iacr.org/2015/267
+ */
+struct BaseOT {
+  /**
+   * @brief The curve used.
+   */
+  using Curve = math::EC<math::ec::Secp256k1>;
+
+  /**
+   * @brief Run the sender side of a number of random OTs.
+   * @param channel a channel to the receiver.
+   * @param n the number of OTs.
+   * @param prg a PRG for generating the sender's randomness.
+   * @return a pair of keys for each OT.
+   * @throws std::runtime_error if the receiver does not run \p n OTs.
+   */
+  static coro::Task<std::vector<std::array<Block, 2>>> send(
+      net::Channel& channel,
+      std::size_t n,
+      util::PRG& prg);
+
+  /**
+   * @brief Run the receiver side of a number of random OTs.
+   * @param channel a channel to the sender.
+   * @param choices the choice bits, one for each OT.
+   * @param prg a PRG for generating the receiver's randomness.
+   * @return for each OT, the sender's key selected by the choice bit.
+   */
+  static coro::Task<std::vector<Block>> receive(net::Channel& channel,
+                                                const util::Bitmap& choices,
+                                                util::PRG& prg);
+};
+
+}  // namespace scl::ot
+
+#endif  // SCL_OT_BASE_OT_H
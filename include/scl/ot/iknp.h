@@ -0,0 +1,234 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_OT_IKNP_H
+#define SCL_OT_IKNP_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "scl/coro/task.h"
+#include "scl/math/vector.h"
+#include "scl/net/channel.h"
+#include "scl/net/packet.h"
+#include "scl/ot/base_ot.h"
+#include "scl/util/bitmap.h"
+#include "scl/util/prg.h"
+
+namespace scl::ot {
+
+namespace details {
+
+/**
+ * @brief Expand a key into a number of pseudorandom bytes.
+ * @param key the key.
+ * @param out where to store the output.
+ * @param n the number of bytes to output.
+ */
+void expand(const Block& key, unsigned char* out, std::size_t n);
+
+/**
+ * @brief Turn a random OT key into a random element of some ring.
+ */
+template <typename T>
+T toElement(const Block& key) {
+  if constexpr (T::byteSize() <= sizeof(Block)) {
+    return T::read(key.data());
+  } else {
+    unsigned char buf[T::byteSize()];
+    expand(key, buf, T::byteSize());
+    return T::read(buf);
+  }
+}
+
+}  // namespace details
+
+/**
+ * @brief The sender in the IKNP OT extension protocol.
+ *
+ * <p>OT extension turns a small number of base OTs into any number of OTs at
+ * the cost of a few AES calls each. setup() runs 128 base OTs, with the roles
+ * reversed, once. Afterwards, each call to sendRandom(), sendChosen() or
+ * sendCorrelated() produces a batch of OTs with a single message from the
+ * receiver (plus one from the sender for chosen and correlated OTs).</p>
+ *
+ * <p>The receiver's message is processed in chunks of a few thousand OTs that
+ * fit in the L2 cache. The 128 rows of each chunk are expanded with util::PRG,
+ * transposed with SSE2 and hashed with a tweakable correlation robust hash
+ * built from fixed-key AES. The protocol is secure against passive
+ * adversaries.</p>
+ *
+ * @see https://www.iacr.org/archive/crypto2003/27290145/27290145.pdf
+ * @see https://eprint.iacr.org/2019/074
+ */
+class IknpSender {
+ public:
+  /**
+   * @brief Run the base OTs.
+   * @param channel a channel to the receiver.
+   * @param prg a PRG used for the base OTs.
+   *
+   * Must be run together with IknpReceiver::setup() before any OTs can be
+   * produced.
+   */
+  coro::Task<void> setup(net::Channel& channel, util::PRG& prg);
+
+  /**
+   * @brief Produce a batch of random OTs.
+   * @param channel a channel to the receiver.
+   * @param n the number of OTs.
+   * @return a pair of random messages for each OT.
+   * @throws std::logic_error if setup() has not been run.
+   * @throws std::runtime_error if the receiver asks for a different number of
+   *         OTs.
+   */
+  coro::Task<std::vector<std::array<Block, 2>>> sendRandom(
+      net::Channel& channel,
+      std::size_t n);
+
+  /**
+   * @brief Send a batch of chosen messages.
+   * @param channel a channel to the receiver.
+   * @param messages a pair of messages for each OT.
+   */
+  coro::Task<void> sendChosen(
+      net::Channel& channel,
+      const std::vector<std::array<Block, 2>>& messages);
+
+  /**
+   * @brief Produce a batch of correlated OTs over some ring.
+   * @param channel a channel to the receiver.
+   * @param deltas the correlation of each OT.
+   * @return a random value <code>a[i]</code> for each OT.
+   *
+   * The receiver learns <code>a[i] + c[i] * deltas[i]</code>, where
+   * <code>c[i]</code> is its i'th choice bit.
+   */
+  template <typename T>
+  coro::Task<math::Vector<T>> sendCorrelated(net::Channel& channel,
+                                             const math::Vector<T>& deltas);
+
+ private:
+  std::vector<util::PRG> m_prgs;
+  Block m_delta;
+  std::uint64_t m_counter = 0;
+};
+
+/**
+ * @brief The receiver in the IKNP OT extension protocol.
+ * @see IknpSender
+ */
+class IknpReceiver {
+ public:
+  /**
+   * @brief Run the base OTs.
+   * @param channel a channel to the sender.
+   * @param prg a PRG used for the base OTs.
+   */
+  coro::Task<void> setup(net::Channel& channel, util::PRG& prg);
+
+  /**
+   * @brief Receive a batch of random OTs.
+   * @param channel a channel to the sender.
+   * @param choices the choice bits.
+   * @return for each OT, the sender's random message selected by the choice
+   *         bit.
+   * @throws std::logic_error if setup() has not been run.
+   */
+  coro::Task<std::vector<Block>> receiveRandom(net::Channel& channel,
+                                               const util::Bitmap& choices);
+
+  /**
+   * @brief Receive a batch of chosen messages.
+   * @param channel a channel to the sender.
+   * @param choices the choice bits.
+   * @return for each OT, the sender's message selected by the choice bit.
+   */
+  coro::Task<std::vector<Block>> receiveChosen(net::Channel& channel,
+                                               const util::Bitmap& choices);
+
+  /**
+   * @brief Receive a batch of correlated OTs over some ring.
+   * @param channel a channel to the sender.
+   * @param choices the choice bits.
+   * @return <code>a[i] + choices[i] * deltas[i]</code> for each OT, where
+   *         <code>a</code> and <code>deltas</code> are the sender's output and
+   *         input in IknpSender::sendCorrelated().
+   */
+  template <typename T>
+  coro::Task<math::Vector<T>> receiveCorrelated(net::Channel& channel,
+                                                const util::Bitmap& choices);
+
+ private:
+  std::vector<util::PRG> m_prgs0;
+  std::vector<util::PRG> m_prgs1;
+  std::uint64_t m_counter = 0;
+};
+
+template <typename T>
+coro::Task<math::Vector<T>> IknpSender::sendCorrelated(
+    net::Channel& channel,
+    const math::Vector<T>& deltas) {
+  const auto n = deltas.size();
+  const std::vector<std::array<Block, 2>> keys =
+      co_await sendRandom(channel, n);
+
+  // the receiver learns F(k0) or F(k1), where F(k1) - tau = F(k0) + delta.
+  math::Vector<T> a(n);
+  math::Vector<T> tau(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    a[i] = details::toElement<T>(keys[i][0]);
+    tau[i] = details::toElement<T>(keys[i][1]) - a[i] - deltas[i];
+  }
+
+  net::Packet packet;
+  packet << tau;
+  co_await channel.send(std::move(packet));
+
+  co_return a;
+}
+
+template <typename T>
+coro::Task<math::Vector<T>> IknpReceiver::receiveCorrelated(
+    net::Channel& channel,
+    const util::Bitmap& choices) {
+  const auto n = choices.size();
+  const std::vector<Block> keys = co_await receiveRandom(channel, choices);
+
+  net::Packet packet = co_await channel.recv();
+  const auto tau = packet.read<math::Vector<T>>();
+  if (tau.size() != n) {
+    throw std::runtime_error("unexpected number of OT corrections");
+  }
+
+  math::Vector<T> b(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    b[i] = details::toElement<T>(keys[i]);
+    if (choices.at(i)) {
+      b[i] -= tau[i];
+    }
+  }
+
+  co_return b;
+}
+
+}  // namespace scl::ot
+
+#endif  // SCL_OT_IKNP_H
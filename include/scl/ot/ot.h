@@ -0,0 +1,31 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_OT_OT_H
+#define SCL_OT_OT_H
+
+#include "scl/ot/base_ot.h"
+#include "scl/ot/iknp.h"
+
+/**
+ * @brief Oblivious transfer.
+ *
+ * The scl::ot namespace contains base OT and OT extension protocols.
+ */
+namespace scl::ot {}  // namespace scl::ot
+
+#endif  // SCL_OT_OT_H
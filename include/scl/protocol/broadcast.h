@@ -0,0 +1,132 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_PROTOCOL_BROADCAST_H
+#define SCL_PROTOCOL_BROADCAST_H
+
+#include <cstddef>
+#include <vector>
+
+#include "scl/coro/task.h"
+#include "scl/net/network.h"
+#include "scl/net/packet.h"
+#include "scl/util/sha3.h"
+
+namespace scl::proto {
+
+/**
+ * @brief Batched consistency check of broadcast messages.
+ *
+ * <p>A broadcast sent by sending the same message to every party is only
+ * secure if it can be checked that all parties received the same message.
+ * Instead of echoing every message, BroadcastChecker hashes every message
+ * broadcast by a party into a SHA3 transcript kept for that party. At the end
+ * of a phase, check() sends the digests of all transcripts to every other
+ * party and compares them, which costs a single round with one small message
+ * per party no matter how many messages were broadcast.</p>
+ *
+ * <p>Since there is a transcript per sender, messages from different senders
+ * may be recorded in any order, but messages from the same sender must be
+ * recorded in the order they were sent. Each message is hashed together with
+ * its length, so a sequence of messages cannot be confused with their
+ * concatenation.</p>
+ *
+ * @code
+ * proto::BroadcastChecker checker(env.network.size());
+ * co_await checker.broadcast(env.network, packet);
+ * for (std::size_t i = 0; i < env.network.size(); ++i) {
+ *   if (i != env.network.myId()) {
+ *     auto p = co_await checker.recv(env.network, i);
+ *     // ... use p
+ *   }
+ * }
+ * // ... more broadcasts.
+ * co_await checker.check(env.network);  // throws on inconsistency.
+ * @endcode
+ */
+class BroadcastChecker {
+ public:
+  /**
+   * @brief The hash function used for transcripts.
+   */
+  using Hash = util::Sha3<256>;
+
+  /**
+   * @brief Create a checker.
+   * @param parties the number of parties.
+   */
+  explicit BroadcastChecker(std::size_t parties) : m_transcripts(parties) {}
+
+  /**
+   * @brief Add a message to the transcript of a party.
+   * @param sender the ID of the party that broadcast the message.
+   * @param data the message.
+   * @param size the size of the message in bytes.
+   */
+  void record(std::size_t sender, const unsigned char* data, std::size_t size);
+
+  /**
+   * @brief Add a packet to the transcript of a party.
+   * @param sender the ID of the party that broadcast the packet.
+   * @param packet the packet. Its full content is recorded, irrespective of
+   *        how much of it has been read.
+   */
+  void record(std::size_t sender, const net::Packet& packet) {
+    record(sender, packet.get(), packet.size());
+  }
+
+  /**
+   * @brief Broadcast a packet to all other parties and record it.
+   * @param network the network.
+   * @param packet the packet.
+   */
+  coro::Task<void> broadcast(net::Network& network, const net::Packet& packet);
+
+  /**
+   * @brief Receive a broadcast packet from a party and record it.
+   * @param network the network.
+   * @param sender the ID of the party that broadcast the packet.
+   * @return the packet.
+   */
+  coro::Task<net::Packet> recv(net::Network& network, std::size_t sender);
+
+  /**
+   * @brief Check that all parties recorded the same messages.
+   * @param network the network.
+   * @throws std::runtime_error if the transcript of some party does not match
+   *         that of another party.
+   *
+   * The transcripts are reset afterwards, so the next phase starts from
+   * scratch.
+   */
+  coro::Task<void> check(net::Network& network);
+
+  /**
+   * @brief The number of messages recorded since the last check.
+   */
+  std::size_t pending() const {
+    return m_pending;
+  }
+
+ private:
+  std::vector<Hash> m_transcripts;
+  std::size_t m_pending = 0;
+};
+
+}  // namespace scl::proto
+
+#endif  // SCL_PROTOCOL_BROADCAST_H
@@ -0,0 +1,309 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_PROTOCOL_DOUBLE_SHARING_H
+#define SCL_PROTOCOL_DOUBLE_SHARING_H
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "scl/coro/task.h"
+#include "scl/math/matrix.h"
+#include "scl/math/vector.h"
+#include "scl/net/network.h"
+#include "scl/net/packet.h"
+#include "scl/util/prg.h"
+
+namespace scl::proto {
+
+/**
+ * @brief A batch of random double sharings.
+ *
+ * <code>low[i]</code> and <code>high[i]</code> are the local party's Shamir
+ * shares of the same random value, of degree \f$t\f$ and \f$2t\f$
+ * respectively.
+ */
+template <typename T>
+struct DoubleSharings {
+  /**
+   * @brief Shares of degree \f$t\f$.
+   */
+  math::Vector<T> low;
+
+  /**
+   * @brief Shares of degree \f$2t\f$.
+   */
+  math::Vector<T> high;
+
+  /**
+   * @brief The number of double sharings.
+   */
+  std::size_t size() const {
+    return low.size();
+  }
+};
+
+namespace details {
+
+/**
+ * @brief Compute <code>out = a * b</code> for row-major matrices.
+ * @param a a matrix with <code>a.cols()</code> rows.
+ * @param b a <code>a.cols()</code> by \p cols matrix.
+ * @param cols the number of columns of \p b.
+ * @param out a <code>a.rows()</code> by \p cols matrix.
+ */
+template <typename T>
+void multiplyInto(const math::Matrix<T>& a,
+                  const T* b,
+                  std::size_t cols,
+                  T* out) {
+  for (std::size_t i = 0; i < a.rows(); ++i) {
+    T* row = out + i * cols;
+    std::fill(row, row + cols, T::zero());
+    for (std::size_t k = 0; k < a.cols(); ++k) {
+      const auto aik = a(i, k);
+      const T* bk = b + k * cols;
+      for (std::size_t j = 0; j < cols; ++j) {
+        row[j] += aik * bk[j];
+      }
+    }
+  }
+}
+
+}  // namespace details
+
+/**
+ * @brief Generator of random double sharings.
+ * @tparam T a finite field type.
+ *
+ * <p>Generates random values shared with Shamir's scheme of both degree
+ * \f$t\f$ and \f$2t\f$, as used by honest majority multiplication, using the
+ * protocol by Damgård and Nielsen. Every party deals a batch of random double
+ * sharings, after which the parties multiply the vector of sharings dealt by
+ * each party with an \f$(n - t) \times n\f$ hyper-invertible matrix. Since at
+ * most \f$t\f$ of the dealers are corrupt, the \f$n - t\f$ outputs are
+ * uniformly random and unknown to the adversary.</p>
+ *
+ * <p>A call to generate() sends a single packet to each other party, holding
+ * all the shares for that party, and computes the shares to deal as well as
+ * the outputs using one matrix product each. Shares are of the form
+ * \f$f(i)\f$ for party \f$i - 1\f$, as in ss::shamirSecretShare(). Buffers
+ * are kept between calls, so repeated calls do not allocate once the largest
+ * batch has been seen.</p>
+ *
+ * @code
+ * proto::DoubleSharingGenerator<FF> gen(env.network.size(), t);
+ * proto::DoubleSharings<FF> ds;
+ * co_await gen.generate(env.network, 1000, prg, ds);
+ * // ds.low[i] and ds.high[i] now share the same random value.
+ * @endcode
+ *
+ * @see https://doi.org/10.1007/978-3-540-74143-5_32
+ */
+template <typename T>
+class DoubleSharingGenerator {
+ public:
+  /**
+   * @brief Create a generator.
+   * @param n the number of parties.
+   * @param t the privacy threshold.
+   * @throws std::invalid_argument if \f$2t \geq n\f$.
+   */
+  DoubleSharingGenerator(std::size_t n, std::size_t t)
+      : m_n(n),
+        m_t(t),
+        m_him(checkedHim(n, t)),
+        m_low(math::Matrix<T>::vandermonde(n, t + 1)),
+        m_high(math::Matrix<T>::vandermonde(n, 2 * t + 1)) {}
+
+  /**
+   * @brief The number of parties.
+   */
+  std::size_t parties() const {
+    return m_n;
+  }
+
+  /**
+   * @brief The privacy threshold.
+   */
+  std::size_t threshold() const {
+    return m_t;
+  }
+
+  /**
+   * @brief The number of double sharings obtained per sharing dealt by each
+   * party.
+   */
+  std::size_t rate() const {
+    return m_n - m_t;
+  }
+
+  /**
+   * @brief Generate random double sharings.
+   * @param network the network. Must have parties() parties.
+   * @param count the number of double sharings to generate.
+   * @param prg the PRG used to deal sharings.
+   * @param out where to write the double sharings. Resized to \p count.
+   * @throws std::invalid_argument if the size of \p network is wrong.
+   * @throws std::runtime_error if a party sends a message of the wrong size.
+   */
+  coro::Task<void> generate(net::Network& network,
+                            std::size_t count,
+                            util::PRG& prg,
+                            DoubleSharings<T>& out);
+
+  /**
+   * @brief Generate random double sharings.
+   * @param network the network. Must have parties() parties.
+   * @param count the number of double sharings to generate.
+   * @param prg the PRG used to deal sharings.
+   * @return \p count double sharings.
+   */
+  coro::Task<DoubleSharings<T>> generate(net::Network& network,
+                                         std::size_t count,
+                                         util::PRG& prg) {
+    DoubleSharings<T> out;
+    co_await generate(network, count, prg, out);
+    co_return out;
+  }
+
+ private:
+  static math::Matrix<T> checkedHim(std::size_t n, std::size_t t) {
+    if (2 * t >= n) {
+      throw std::invalid_argument("threshold must be less than n / 2");
+    }
+    return math::Matrix<T>::hyperInvertible(n - t, n);
+  }
+
+  // fill out with n random elements. Randomness is taken from prg in one call
+  // since small calls to PRG::next are slow.
+  void random(T* out, std::size_t n, util::PRG& prg) {
+    m_random.resize(n * T::byteSize());
+    prg.next(m_random.data(), m_random.size());
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = T::read(m_random.data() + i * T::byteSize());
+    }
+  }
+
+  std::size_t m_n;
+  std::size_t m_t;
+  math::Matrix<T> m_him;
+  math::Matrix<T> m_low;
+  math::Matrix<T> m_high;
+
+  std::vector<unsigned char> m_random;
+
+  // coefficients of the polynomials dealt, one sharing per column. Row 0 holds
+  // the secrets in both.
+  std::vector<T> m_low_coeffs;
+  std::vector<T> m_high_coeffs;
+
+  // shares dealt, with the shares for party i in row i. The first half of a
+  // row is of degree t and the second of degree 2t.
+  std::vector<T> m_dealt;
+
+  // shares received, with the shares dealt by party i in row i.
+  std::vector<T> m_received;
+
+  // the result of applying the hyper-invertible matrix to m_received.
+  std::vector<T> m_extracted;
+};
+
+template <typename T>
+coro::Task<void> DoubleSharingGenerator<T>::generate(net::Network& network,
+                                                     std::size_t count,
+                                                     util::PRG& prg,
+                                                     DoubleSharings<T>& out) {
+  if (network.size() != m_n) {
+    throw std::invalid_argument("network has the wrong number of parties");
+  }
+
+  // number of sharings each party deals, and the width of a row of shares.
+  const auto batch = (count + rate() - 1) / rate();
+  const auto width = 2 * batch;
+  const auto id = network.myId();
+
+  m_low_coeffs.resize((m_t + 1) * batch);
+  m_high_coeffs.resize((2 * m_t + 1) * batch);
+  random(m_low_coeffs.data(), m_low_coeffs.size(), prg);
+  std::copy(m_low_coeffs.begin(),
+            m_low_coeffs.begin() + batch,
+            m_high_coeffs.begin());
+  random(m_high_coeffs.data() + batch, m_high_coeffs.size() - batch, prg);
+
+  // the shares of degree t and 2t are computed into the two halves of the
+  // rows of m_received, and then moved to m_dealt.
+  m_dealt.resize(m_n * width);
+  m_received.resize(m_n * batch);
+  details::multiplyInto(m_low, m_low_coeffs.data(), batch, m_received.data());
+  for (std::size_t i = 0; i < m_n; ++i) {
+    std::copy_n(m_received.begin() + i * batch,
+                batch,
+                m_dealt.begin() + i * width);
+  }
+  details::multiplyInto(m_high, m_high_coeffs.data(), batch, m_received.data());
+  for (std::size_t i = 0; i < m_n; ++i) {
+    std::copy_n(m_received.begin() + i * batch,
+                batch,
+                m_dealt.begin() + i * width + batch);
+  }
+
+  for (std::size_t i = 0; i < m_n; ++i) {
+    if (i == id) {
+      continue;
+    }
+    net::Packet packet(width * T::byteSize());
+    for (std::size_t j = 0; j < width; ++j) {
+      packet << m_dealt[i * width + j];
+    }
+    co_await network.party(i)->send(std::move(packet));
+  }
+
+  m_received.resize(m_n * width);
+  for (std::size_t i = 0; i < m_n; ++i) {
+    auto* row = m_received.data() + i * width;
+    if (i == id) {
+      std::copy_n(m_dealt.begin() + i * width, width, row);
+      continue;
+    }
+    net::Packet packet = co_await network.party(i)->recv();
+    if (packet.remaining() != width * T::byteSize()) {
+      throw std::runtime_error("unexpected size of double sharing message");
+    }
+    for (std::size_t j = 0; j < width; ++j) {
+      row[j] = packet.read<T>();
+    }
+  }
+
+  m_extracted.resize(rate() * width);
+  details::multiplyInto(m_him, m_received.data(), width, m_extracted.data());
+
+  // output k is taken from row k / batch and column k % batch.
+  out.low.container().resize(count);
+  out.high.container().resize(count);
+  for (std::size_t k = 0; k < count; ++k) {
+    const auto* row = m_extracted.data() + (k / batch) * width;
+    out.low[k] = row[k % batch];
+    out.high[k] = row[batch + k % batch];
+  }
+}
+
+}  // namespace scl::proto
+
+#endif  // SCL_PROTOCOL_DOUBLE_SHARING_H
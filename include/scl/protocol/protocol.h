@@ -19,6 +19,8 @@
 #define SCL_PROTOCOL_PROTOCOL_H
 
 #include "scl/protocol/base.h"
+#include "scl/protocol/broadcast.h"
+#include "scl/protocol/double_sharing.h"
 #include "scl/protocol/env.h"
 #include "scl/protocol/eval.h"
 #include "scl/protocol/result.h"
@@ -21,6 +21,7 @@
 #include "scl/coro/coroutine.h"
 #include "scl/math/math.h"
 #include "scl/net/net.h"
+#include "scl/ot/ot.h"
 #include "scl/protocol/protocol.h"
 #include "scl/serialization/serialization.h"
 #include "scl/simulation/simulation.h"
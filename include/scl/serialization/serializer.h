@@ -156,16 +156,19 @@ struct Serializer<std::vector<unsigned char>> {
 
 /**
  * @brief Serializer specialization for generic <code>std::vector</code> types.
+ *
+ * Also used for vectors with other allocators, such as
+ * <code>std::pmr::vector</code>.
  */
-template <typename T>
-struct Serializer<std::vector<T>> {
+template <typename T, typename ALLOCATOR>
+struct Serializer<std::vector<T, ALLOCATOR>> {
  public:
   /**
    * @brief Determine the byte size of a vector.
    * @param vec the vector.
    * @return the size of \p vec when written using this Serializer.
    */
-  static std::size_t sizeOf(const std::vector<T>& vec) {
+  static std::size_t sizeOf(const std::vector<T, ALLOCATOR>& vec) {
     auto size = Serializer<StlVecSizeType>::sizeOf(vec.size());
     for (const auto& v : vec) {
       size += Serializer<T>::sizeOf(v);
@@ -179,7 +182,8 @@ struct Serializer<std::vector<T>> {
    * @param buf the buffer where \p vec is written to.
    * @return the number of bytes written to buf.
    */
-  static std::size_t write(const std::vector<T>& vec, unsigned char* buf) {
+  static std::size_t write(const std::vector<T, ALLOCATOR>& vec,
+                           unsigned char* buf) {
     auto offset = Serializer<StlVecSizeType>::write(vec.size(), buf);
     for (const auto& v : vec) {
       offset += Serializer<T>::write(v, buf + offset);
@@ -196,7 +200,8 @@ struct Serializer<std::vector<T>> {
    * This function reads a size from \p buf and uses it to <code>reserve</code>
    * space in \p vec. Elements are then read one by one from \p buf.
    */
-  static std::size_t read(std::vector<T>& vec, const unsigned char* buf) {
+  static std::size_t read(std::vector<T, ALLOCATOR>& vec,
+                          const unsigned char* buf) {
     StlVecSizeType size = 0;
     auto offset = Serializer<StlVecSizeType>::read(size, buf);
     vec.resize(size);
@@ -54,4 +54,23 @@ math::Vector<T> additiveShare(const T& secret, std::size_t n, util::PRG& prg) {
 
 }  // namespace scl::ss
 
+#ifdef SCL_EXPLICIT_INSTANTIATION
+
+#include "scl/math/instantiations.h"
+
+/**
+ * @brief Explicit instantiation of additiveShare, or its declaration if
+ * \p PREFIX is <code>extern</code>.
+ */
+#define SCL_ADDITIVE_INSTANCE(PREFIX, T)                                     \
+  PREFIX template scl::math::Vector<T> scl::ss::additiveShare(const T&,      \
+                                                              std::size_t,   \
+                                                              scl::util::PRG&);
+
+#define SCL_EXTERN_ADDITIVE(T) SCL_ADDITIVE_INSTANCE(extern, T)
+SCL_BUILTIN_FIELDS(SCL_EXTERN_ADDITIVE)
+#undef SCL_EXTERN_ADDITIVE
+
+#endif  // SCL_EXPLICIT_INSTANTIATION
+
 #endif  // SCL_SS_ADDITIVE_H
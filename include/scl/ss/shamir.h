@@ -21,6 +21,7 @@
 #include <array>
 #include <iostream>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <type_traits>
 #include <unordered_map>
@@ -31,6 +32,7 @@
 #include "scl/math/poly.h"
 #include "scl/math/vector.h"
 #include "scl/util/prg.h"
+#include "scl/util/trace.h"
 
 namespace scl::ss {
 
@@ -53,15 +55,16 @@ math::Vector<T> shamirSecretShare(const T& secret,
                                   std::size_t t,
                                   std::size_t n,
                                   util::PRG& prg) {
+  SCL_TRACE_SPAN("shamir", "shamirSecretShare");
   auto c = math::Vector<T>::random(t + 1, prg);
   c[0] = secret;
-  const auto p = math::Polynomial<T>::create(c);
+  const std::span<const T> p(c.data(), c.size());
 
   std::vector<T> shares;
   shares.reserve(n);
   auto x = T::one();
   for (std::size_t i = 1; i <= n; ++i) {
-    shares.emplace_back(p.evaluate(x++));
+    shares.emplace_back(math::evaluatePolynomial(p, x++));
   }
 
   return math::Vector<T>(shares);
@@ -82,6 +85,7 @@ template <typename T>
 T shamirRecoverP(const math::Vector<T>& shares,
                  const math::Vector<T>& alphas,
                  const T& x) {
+  SCL_TRACE_SPAN("shamir", "shamirRecoverP");
   const auto lb = math::computeLagrangeBasis(alphas, x);
   return math::innerProd<T>(shares.begin(), shares.end(), lb.begin());
 }
@@ -119,6 +123,7 @@ T shamirRecoverD(const math::Vector<T>& shares,
                  std::size_t t,
                  std::size_t d,
                  const T& x) {
+  SCL_TRACE_SPAN("shamir", "shamirRecoverD");
   if (shares.size() < d + t || alphas.size() < d + t) {
     throw std::logic_error("not enough shares provided to detect errors");
   }
@@ -202,6 +207,7 @@ struct ErrorCorrectedSecret {
 template <typename T>
 ErrorCorrectedSecret<T> shamirRecoverC(const math::Vector<T>& shares,
                                        const math::Vector<T>& alphas) {
+  SCL_TRACE_SPAN("shamir", "shamirRecoverC");
   const std::size_t t = (shares.size() - 1) / 3;
   const std::size_t n = 3 * t + 1;
 
@@ -260,4 +266,41 @@ ErrorCorrectedSecret<T> shamirRecoverC(const math::Vector<T>& shares) {
 
 }  // namespace scl::ss
 
+#ifdef SCL_EXPLICIT_INSTANTIATION
+
+#include "scl/math/instantiations.h"
+
+/**
+ * @brief Explicit instantiation of the Shamir functions, or their declaration
+ * if \p PREFIX is <code>extern</code>.
+ */
+#define SCL_SHAMIR_INSTANCE(PREFIX, T)                                       \
+  PREFIX template scl::math::Vector<T> scl::ss::shamirSecretShare(           \
+      const T&,                                                              \
+      std::size_t,                                                           \
+      std::size_t,                                                           \
+      scl::util::PRG&);                                                      \
+  PREFIX template T scl::ss::shamirRecoverP(const scl::math::Vector<T>&,     \
+                                            const scl::math::Vector<T>&,     \
+                                            const T&);                       \
+  PREFIX template T scl::ss::shamirRecoverP(const scl::math::Vector<T>&);    \
+  PREFIX template T scl::ss::shamirRecoverD(const scl::math::Vector<T>&,     \
+                                            const scl::math::Vector<T>&,     \
+                                            std::size_t,                     \
+                                            std::size_t,                     \
+                                            const T&);                       \
+  PREFIX template T scl::ss::shamirRecoverD(const scl::math::Vector<T>&,     \
+                                            std::size_t);                    \
+  PREFIX template scl::ss::ErrorCorrectedSecret<T> scl::ss::shamirRecoverC(  \
+      const scl::math::Vector<T>&,                                           \
+      const scl::math::Vector<T>&);                                          \
+  PREFIX template scl::ss::ErrorCorrectedSecret<T> scl::ss::shamirRecoverC(  \
+      const scl::math::Vector<T>&);
+
+#define SCL_EXTERN_SHAMIR(T) SCL_SHAMIR_INSTANCE(extern, T)
+SCL_BUILTIN_FIELDS(SCL_EXTERN_SHAMIR)
+#undef SCL_EXTERN_SHAMIR
+
+#endif  // SCL_EXPLICIT_INSTANTIATION
+
 #endif  // SCL_SS_SHAMIR_H
@@ -0,0 +1,92 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_UTIL_AES_H
+#define SCL_UTIL_AES_H
+
+#include <cstddef>
+
+#include <emmintrin.h>
+
+namespace scl::util {
+
+/**
+ * @brief The AES-128 block cipher.
+ *
+ * Encryption uses AES-NI, or VAES for long inputs, when the CPU supports it
+ * (see cpu::features()). Otherwise a (slow) software implementation is used.
+ *
+ * <p>Besides being the basis of PRG, AES with a fixed and public key is useful
+ * as a fast random permutation, e.g., for building correlation robust hash
+ * functions.</p>
+ */
+class AES {
+ public:
+  /**
+   * @brief The type of a block.
+   */
+  using BlockType = __m128i;
+
+  /**
+   * @brief Size of a block in bytes.
+   */
+  static constexpr std::size_t BLOCK_SIZE = sizeof(BlockType);
+
+  /**
+   * @brief Size of a key in bytes.
+   */
+  static constexpr std::size_t keySize() {
+    return BLOCK_SIZE;
+  }
+
+  /**
+   * @brief Create an AES object with a key.
+   * @param key the key, keySize() bytes.
+   */
+  explicit AES(const unsigned char* key);
+
+  /**
+   * @brief Encrypt a number of blocks.
+   * @param in the blocks to encrypt.
+   * @param out where to store the encrypted blocks. May be equal to \p in.
+   * @param nblocks the number of blocks.
+   */
+  void encrypt(const BlockType* in, BlockType* out, std::size_t nblocks) const;
+
+  /**
+   * @brief Encrypt a counter.
+   * @param nonce the upper 64 bits of each counter block.
+   * @param counter the lower 64 bits of the first counter block.
+   * @param nblocks the number of blocks to generate.
+   * @param out where to store the output. Must have room for
+   *        <code>nblocks * BLOCK_SIZE</code> bytes.
+   *
+   * Block <code>i</code> of the output is the encryption of
+   * <code>nonce || (counter + i)</code>.
+   */
+  void ctr(long nonce,
+           long counter,
+           std::size_t nblocks,
+           unsigned char* out) const;
+
+ private:
+  BlockType m_round_keys[11];
+};
+
+}  // namespace scl::util
+
+#endif  // SCL_UTIL_AES_H
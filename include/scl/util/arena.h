@@ -0,0 +1,124 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_UTIL_ARENA_H
+#define SCL_UTIL_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace scl::util {
+
+/**
+ * @brief A memory resource for temporary allocations that are freed together.
+ *
+ * <p>Arena hands out memory by bumping a pointer into a chunk of memory
+ * obtained from an upstream resource. Deallocation does nothing, and all
+ * memory is instead released at once with reset(). After a reset, an Arena
+ * keeps a single chunk large enough for everything that was allocated before
+ * the reset, so code which allocates roughly the same amount each time between
+ * resets stops allocating from the upstream resource after the first time.</p>
+ *
+ * <p>Arena can be used with the containers in SCL that accept a
+ * <code>std::pmr::memory_resource</code>, such as math::Vector, math::Matrix,
+ * math::Polynomial and net::Packet. Arithmetic on such containers allocates its
+ * result from the same resource as the left operand, so temporaries stay in
+ * the arena. A typical use is a protocol round:
+ *
+ * @code
+ * util::Arena arena;
+ * for (std::size_t round = 0; round < rounds; ++round) {
+ *   math::Vector<FF> x(n, &arena);
+ *   auto y = x.add(x).multiplyEntryWise(x);  // allocated in arena.
+ *   ...
+ *   arena.reset();  // nothing allocated in arena may be used after this.
+ * }
+ * @endcode
+ *
+ * Copies of containers (as opposed to moves) are allocated with the default
+ * memory resource, following the usual <code>std::pmr</code> rules, and can
+ * therefore be used after the arena is reset.</p>
+ *
+ * <p>An Arena is not thread-safe.</p>
+ */
+class Arena final : public std::pmr::memory_resource {
+ public:
+  /**
+   * @brief Create a new Arena.
+   * @param initial_size the size of the first chunk.
+   * @param upstream the resource to allocate chunks from.
+   */
+  explicit Arena(
+      std::size_t initial_size = 1 << 16,
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+  /**
+   * @brief Destructor. Returns all chunks to the upstream resource.
+   */
+  ~Arena() override;
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /**
+   * @brief Release all memory allocated from this Arena.
+   */
+  void reset();
+
+  /**
+   * @brief Number of bytes handed out since the last reset.
+   */
+  std::size_t allocated() const {
+    return m_allocated;
+  }
+
+  /**
+   * @brief Number of bytes obtained from the upstream resource.
+   */
+  std::size_t capacity() const;
+
+ private:
+  struct Chunk {
+    std::byte* data;
+    std::size_t size;
+  };
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+  void do_deallocate(void* /* p */,
+                     std::size_t /* bytes */,
+                     std::size_t /* alignment */) override {}
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  void addChunk(std::size_t size);
+  void releaseChunks();
+
+  std::pmr::memory_resource* m_upstream;
+  std::vector<Chunk> m_chunks;
+  std::byte* m_ptr = nullptr;
+  std::byte* m_end = nullptr;
+  std::size_t m_allocated = 0;
+};
+
+}  // namespace scl::util
+
+#endif  // SCL_UTIL_ARENA_H
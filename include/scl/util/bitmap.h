@@ -18,8 +18,10 @@
 #ifndef SCL_UTIL_BITMAP_H
 #define SCL_UTIL_BITMAP_H
 
-#include <bitset>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <ostream>
 #include <stdexcept>
 #include <vector>
@@ -29,22 +31,54 @@
 namespace scl {
 namespace util {
 
+namespace details {
+
+/**
+ * @brief Compute <code>dst[i] &= src[i]</code> for <code>i < n</code>.
+ */
+void bitmapAnd(std::uint64_t* dst, const std::uint64_t* src, std::size_t n);
+
+/**
+ * @brief Compute <code>dst[i] |= src[i]</code> for <code>i < n</code>.
+ */
+void bitmapOr(std::uint64_t* dst, const std::uint64_t* src, std::size_t n);
+
+/**
+ * @brief Compute <code>dst[i] ^= src[i]</code> for <code>i < n</code>.
+ */
+void bitmapXor(std::uint64_t* dst, const std::uint64_t* src, std::size_t n);
+
+/**
+ * @brief Compute <code>dst[i] = ~dst[i]</code> for <code>i < n</code>.
+ */
+void bitmapNot(std::uint64_t* dst, std::size_t n);
+
+/**
+ * @brief Count the number of bits set in <code>src[0..n)</code>.
+ */
+std::size_t bitmapCount(const std::uint64_t* src, std::size_t n);
+
+}  // namespace details
+
 /**
  * @brief A simple bitmap.
  *
  * The Bitmap class holds bits. It serves some of the same functionality as
  * <code>std::vector<bool></code>. The implementation of Bitmap stores bits
- * packed in objects of type Bitmap::BlockType, current <code>unsigned
- * char</code>. As a consequence, Bitmap always stores a multiple of
- * <code>sizeof(Bitmap::BlockType) * 8</code> bits. Any unset bits are
+ * packed in objects of type Bitmap::BlockType, currently
+ * <code>std::uint64_t</code>, with bit <code>i</code> stored in bit
+ * <code>i % 64</code> of block <code>i / 64</code>. Bits past size() are
  * guaranteed to be 0.
+ *
+ * <p>Bulk operations (count() and the bitwise operators) use
+ * <code>popcnt</code> and AVX2 when the CPU supports it.</p>
  */
 class Bitmap {
  public:
   /**
    * @brief The internal block type.
    */
-  using BlockType = unsigned char;
+  using BlockType = std::uint64_t;
 
   /**
    * @brief Number of bits that each block stores.
@@ -73,13 +107,21 @@ class Bitmap {
    * @param initial_size the initial size.
    */
   Bitmap(std::size_t initial_size)
-      : m_bits(ContainerType(bytesRequired(initial_size), 0)) {}
+      : m_size(initial_size),
+        m_bits(ContainerType(blocksRequired(initial_size), 0)) {}
 
   /**
    * @brief Construct an empty Bitmap.
    */
   Bitmap() : Bitmap(0) {}
 
+  /**
+   * @brief Number of bits in this Bitmap.
+   */
+  std::size_t size() const {
+    return m_size;
+  }
+
   /**
    * @brief Check the bit at some position.
    * @param index the bit position.
@@ -93,13 +135,14 @@ class Bitmap {
 
   /**
    * @brief Set the bit at some position.
-   * @param index the position of the bit to set.
+   * @param index the position of the bit to set. Must be less than size().
    * @param b the value to set.
    */
   void set(std::size_t index, bool b) {
     const std::size_t block = index / BITS_PER_BLOCK;
     const std::size_t block_index = index & (BITS_PER_BLOCK - 1);
-    m_bits[block] ^= (-(b ? 1 : 0) ^ m_bits[block]) & (1 << block_index);
+    const BlockType mask = BlockType{1} << block_index;
+    m_bits[block] ^= (-static_cast<BlockType>(b) ^ m_bits[block]) & mask;
   }
 
   /**
@@ -107,14 +150,36 @@ class Bitmap {
    * @return the population count of this Bitmap.
    */
   std::size_t count() const {
-    // https://stackoverflow.com/a/698108
-    static const unsigned char lut[] =
-        {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
-    std::size_t count = 0;
-    for (const auto& b : m_bits) {
-      count += lut[b & 0x0f] + lut[b >> 4];
+    return details::bitmapCount(m_bits.data(), m_bits.size());
+  }
+
+  /**
+   * @brief Find the next set bit.
+   * @param index the position to start searching from.
+   * @return the position of the first set bit at or after \p index, or size()
+   * if there is no such bit.
+   *
+   * Iterating over the set bits of a Bitmap <code>bm</code> can be done as
+   * @code
+   * for (auto i = bm.findNextSet(0); i < bm.size(); i = bm.findNextSet(i + 1))
+   * @endcode
+   */
+  std::size_t findNextSet(std::size_t index) const {
+    if (index >= m_size) {
+      return m_size;
     }
-    return count;
+
+    std::size_t block = index / BITS_PER_BLOCK;
+    const BlockType mask = ~BlockType{0} << (index % BITS_PER_BLOCK);
+    BlockType bits = m_bits[block] & mask;
+    while (bits == 0) {
+      if (++block == m_bits.size()) {
+        return m_size;
+      }
+      bits = m_bits[block];
+    }
+
+    return block * BITS_PER_BLOCK + std::countr_zero(bits);
   }
 
   /**
@@ -125,6 +190,24 @@ class Bitmap {
     return m_bits.size();
   }
 
+  /**
+   * @brief Get a pointer to the blocks of this Bitmap.
+   *
+   * Allows bulk access to the bits, e.g., when copying them to or from a byte
+   * buffer. Callers writing through this pointer must keep the bits past
+   * size() 0.
+   */
+  BlockType* data() {
+    return m_bits.data();
+  }
+
+  /**
+   * @brief Get a const pointer to the blocks of this Bitmap.
+   */
+  const BlockType* data() const {
+    return m_bits.data();
+  }
+
   /**
    * @brief Check if two bitmaps contain the same content.
    * @param bm0 the first Bitmap.
@@ -132,7 +215,7 @@ class Bitmap {
    * @return true if \p bm0 and \p bm1 are equal, false otherwise.
    */
   friend bool operator==(const Bitmap& bm0, const Bitmap& bm1) {
-    return bm0.m_bits == bm1.m_bits;
+    return bm0.m_size == bm1.m_size && bm0.m_bits == bm1.m_bits;
   }
 
   /**
@@ -149,27 +232,63 @@ class Bitmap {
    * @brief Write this bitmap to a stream.
    * @param os the stream.
    * @param m the bitmap.
+   *
+   * Bits are written in order, starting with the bit at position 0.
    */
   friend std::ostream& operator<<(std::ostream& os, const Bitmap& m) {
-    for (const BlockType& block : m.m_bits) {
-      os << std::bitset<BITS_PER_BLOCK>(block);
+    for (std::size_t i = 0; i < m.size(); ++i) {
+      os << (m.at(i) ? '1' : '0');
     }
     return os;
   }
 
+  /**
+   * @brief Compute the XOR of this bitmap and another bitmap in-place.
+   * @param other the other bitmap.
+   */
+  Bitmap& operator^=(const Bitmap& other) {
+    validateSizes(*this, other);
+    details::bitmapXor(m_bits.data(), other.m_bits.data(), m_bits.size());
+    return *this;
+  }
+
+  /**
+   * @brief Compute the AND of this bitmap and another bitmap in-place.
+   * @param other the other bitmap.
+   */
+  Bitmap& operator&=(const Bitmap& other) {
+    validateSizes(*this, other);
+    details::bitmapAnd(m_bits.data(), other.m_bits.data(), m_bits.size());
+    return *this;
+  }
+
+  /**
+   * @brief Compute the OR of this bitmap and another bitmap in-place.
+   * @param other the other bitmap.
+   */
+  Bitmap& operator|=(const Bitmap& other) {
+    validateSizes(*this, other);
+    details::bitmapOr(m_bits.data(), other.m_bits.data(), m_bits.size());
+    return *this;
+  }
+
+  /**
+   * @brief Negate this bitmap in-place.
+   */
+  Bitmap& flip() {
+    details::bitmapNot(m_bits.data(), m_bits.size());
+    clearPadding();
+    return *this;
+  }
+
   /**
    * @brief Compute the XOR of two bitmaps.
    * @param bm0 the first bitmap.
    * @param bm1 the other bitmap.
    */
   friend Bitmap operator^(const Bitmap& bm0, const Bitmap& bm1) {
-    validateSizes(bm0, bm1);
-    Bitmap bm;
-    bm.m_bits.resize(bm0.numberOfBlocks());
-    for (std::size_t i = 0; i < bm.m_bits.size(); i++) {
-      bm.m_bits[i] = bm0.m_bits[i] ^ bm1.m_bits[i];
-    }
-    return bm;
+    Bitmap bm = bm0;
+    return bm ^= bm1;
   }
 
   /**
@@ -178,13 +297,8 @@ class Bitmap {
    * @param bm1 the other bitmap.
    */
   friend Bitmap operator&(const Bitmap& bm0, const Bitmap& bm1) {
-    validateSizes(bm0, bm1);
-    Bitmap bm;
-    bm.m_bits.resize(bm0.numberOfBlocks());
-    for (std::size_t i = 0; i < bm.m_bits.size(); i++) {
-      bm.m_bits[i] = bm0.m_bits[i] & bm1.m_bits[i];
-    }
-    return bm;
+    Bitmap bm = bm0;
+    return bm &= bm1;
   }
 
   /**
@@ -193,13 +307,8 @@ class Bitmap {
    * @param bm1 the other bitmap.
    */
   friend Bitmap operator|(const Bitmap& bm0, const Bitmap& bm1) {
-    validateSizes(bm0, bm1);
-    Bitmap bm;
-    bm.m_bits.resize(bm0.numberOfBlocks());
-    for (std::size_t i = 0; i < bm.m_bits.size(); i++) {
-      bm.m_bits[i] = bm0.m_bits[i] | bm1.m_bits[i];
-    }
-    return bm;
+    Bitmap bm = bm0;
+    return bm |= bm1;
   }
 
   /**
@@ -207,27 +316,33 @@ class Bitmap {
    * @param bm0 the bitmap.
    */
   friend Bitmap operator~(const Bitmap& bm0) {
-    Bitmap bm;
-    bm.m_bits.resize(bm0.numberOfBlocks());
-    for (std::size_t i = 0; i < bm.m_bits.size(); i++) {
-      bm.m_bits[i] = ~bm0.m_bits[i];
-    }
-    return bm;
+    Bitmap bm = bm0;
+    return bm.flip();
   }
 
  private:
+  std::size_t m_size;
   ContainerType m_bits;
 
-  static constexpr std::size_t bytesRequired(std::size_t bits) {
+  static constexpr std::size_t blocksRequired(std::size_t bits) {
     return bits == 0 ? 1 : (bits - 1) / (BITS_PER_BLOCK) + 1;
   }
 
   static void validateSizes(const util::Bitmap& bm0, const util::Bitmap& bm1) {
-    if (bm0.numberOfBlocks() != bm1.numberOfBlocks()) {
+    if (bm0.size() != bm1.size()) {
       throw std::logic_error("bitmaps are different sizes");
     }
   }
 
+  void clearPadding() {
+    const auto used = m_size % BITS_PER_BLOCK;
+    if (used != 0) {
+      m_bits.back() &= (BlockType{1} << used) - 1;
+    } else if (m_size == 0) {
+      m_bits.back() = 0;
+    }
+  }
+
   friend scl::seri::Serializer<Bitmap>;
 };
 
@@ -237,6 +352,10 @@ namespace seri {
 
 /**
  * @brief Serializer for util::Bitmap types.
+ *
+ * A util::Bitmap is written as its size in bits, followed by the bytes of its
+ * blocks that hold those bits. The bytes are in the same order as in memory,
+ * so writing and reading are both a single copy.
  */
 template <>
 struct Serializer<util::Bitmap> {
@@ -246,7 +365,7 @@ struct Serializer<util::Bitmap> {
    * @return the size in bytes of the \p bm.
    */
   static std::size_t sizeOf(const util::Bitmap& bm) {
-    return Serializer<util::Bitmap::ContainerType>::sizeOf(bm.m_bits);
+    return Serializer<StlVecSizeType>::sizeOf(0) + bytes(bm.size());
   }
 
   /**
@@ -256,7 +375,10 @@ struct Serializer<util::Bitmap> {
    * @return the number of bytes written.
    */
   static std::size_t write(const util::Bitmap& bm, unsigned char* buf) {
-    return Serializer<util::Bitmap::ContainerType>::write(bm.m_bits, buf);
+    const auto size = static_cast<StlVecSizeType>(bm.size());
+    const auto offset = Serializer<StlVecSizeType>::write(size, buf);
+    std::memcpy(buf + offset, bm.m_bits.data(), bytes(bm.size()));
+    return sizeOf(bm);
   }
 
   /**
@@ -266,7 +388,17 @@ struct Serializer<util::Bitmap> {
    * @return the number of bytes read from \p buf.
    */
   static std::size_t read(util::Bitmap& bm, const unsigned char* buf) {
-    return Serializer<util::Bitmap::ContainerType>::read(bm.m_bits, buf);
+    StlVecSizeType size = 0;
+    const auto offset = Serializer<StlVecSizeType>::read(size, buf);
+    bm = util::Bitmap(size);
+    std::memcpy(bm.m_bits.data(), buf + offset, bytes(size));
+    bm.clearPadding();
+    return sizeOf(bm);
+  }
+
+ private:
+  static std::size_t bytes(std::size_t bits) {
+    return (bits + 7) / 8;
   }
 };
 
@@ -0,0 +1,211 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_UTIL_CACHE_H
+#define SCL_UTIL_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "scl/serialization/serializer.h"
+
+namespace scl::util {
+
+/**
+ * @brief A cache of expensive precomputations stored on disk.
+ *
+ * <p>Objects are stored in a directory, one file per key, using the
+ * seri::Serializer of their type. Each file starts with a header holding a
+ * format version, the full key and a checksum of the payload. A file is
+ * loaded with <code>mmap</code> and deserialized directly from the mapping.
+ * If the file is missing, was written by another format version, belongs to
+ * another key or fails its checksum, the object is computed again and the
+ * file is replaced.</p>
+ *
+ * @code
+ * util::PrecomputationCache cache("/var/cache/myparty");
+ * auto m = cache.get<math::Matrix<FF>>("hyperInvertible/7/7", [] {
+ *   return math::Matrix<FF>::hyperInvertible(7, 7);
+ * });
+ * @endcode
+ *
+ * <p>Keys should name both what was computed and every parameter it depends
+ * on. The type of the object is added to the key by get(). The checksum
+ * detects truncated or corrupted files, but not deliberate modifications, so
+ * the directory should only be writable by trusted processes.</p>
+ *
+ * <p>Files are written to a temporary name and then renamed, so several
+ * processes may share a directory. Failing to write a file is not an error,
+ * since the computed object can still be returned.</p>
+ */
+class PrecomputationCache final {
+ public:
+  /**
+   * @brief Version of the file format. Files with other versions are ignored.
+   */
+  static constexpr std::uint32_t VERSION = 1;
+
+  /**
+   * @brief Read only view of a cached payload, mapped into memory.
+   */
+  class Mapping {
+   public:
+    /**
+     * @brief Unmap the file.
+     */
+    ~Mapping();
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    /**
+     * @brief The payload.
+     */
+    const unsigned char* data() const {
+      return m_base + m_offset;
+    }
+
+    /**
+     * @brief The size of the payload in bytes.
+     */
+    std::size_t size() const {
+      return m_size;
+    }
+
+   private:
+    Mapping(const unsigned char* base,
+            std::size_t length,
+            std::size_t offset,
+            std::size_t size)
+        : m_base(base), m_length(length), m_offset(offset), m_size(size) {}
+
+    const unsigned char* m_base;
+    std::size_t m_length;
+    std::size_t m_offset;
+    std::size_t m_size;
+
+    friend class PrecomputationCache;
+  };
+
+  /**
+   * @brief Create a cache that stores files in a directory.
+   * @param directory the directory. Created if it does not exist.
+   */
+  explicit PrecomputationCache(std::filesystem::path directory);
+
+  /**
+   * @brief The directory where files are stored.
+   */
+  const std::filesystem::path& directory() const {
+    return m_directory;
+  }
+
+  /**
+   * @brief Get an object from the cache, or compute and store it.
+   * @param key the key of the object.
+   * @param compute function which computes the object on a miss.
+   * @return the cached object, or the result of \p compute.
+   */
+  template <typename T, typename F>
+  T get(const std::string& key, F&& compute) {
+    const auto full_key = std::string(typeid(T).name()) + "/" + key;
+
+    if (auto mapping = load(full_key); mapping != nullptr) {
+      if (auto obj = deserialize<T>(*mapping); obj.has_value()) {
+        m_hits++;
+        return std::move(*obj);
+      }
+    }
+
+    m_misses++;
+    T obj = compute();
+    std::vector<unsigned char> buf(seri::Serializer<T>::sizeOf(obj));
+    seri::Serializer<T>::write(obj, buf.data());
+    store(full_key, buf.data(), buf.size());
+    return obj;
+  }
+
+  /**
+   * @brief Map the payload stored under a key.
+   * @param key the key.
+   * @return the payload, or nullptr if there is no valid file for \p key.
+   */
+  std::unique_ptr<Mapping> load(const std::string& key) const;
+
+  /**
+   * @brief Store a payload under a key.
+   * @param key the key.
+   * @param data the payload.
+   * @param size the size of the payload.
+   * @return true if the file was written and false otherwise.
+   */
+  bool store(const std::string& key,
+             const unsigned char* data,
+             std::size_t size) const;
+
+  /**
+   * @brief Remove the file stored under a key, if any.
+   */
+  void erase(const std::string& key) const;
+
+  /**
+   * @brief The path of the file used for a key.
+   */
+  std::filesystem::path path(const std::string& key) const;
+
+  /**
+   * @brief Number of calls to get() that were answered from disk.
+   */
+  std::size_t hits() const {
+    return m_hits;
+  }
+
+  /**
+   * @brief Number of calls to get() that had to compute the object.
+   */
+  std::size_t misses() const {
+    return m_misses;
+  }
+
+ private:
+  template <typename T>
+  static std::optional<T> deserialize(const Mapping& mapping) {
+    T obj;
+    try {
+      if (seri::Serializer<T>::read(obj, mapping.data()) != mapping.size()) {
+        return std::nullopt;
+      }
+    } catch (...) {
+      return std::nullopt;
+    }
+    return obj;
+  }
+
+  std::filesystem::path m_directory;
+  std::size_t m_hits = 0;
+  std::size_t m_misses = 0;
+};
+
+}  // namespace scl::util
+
+#endif  // SCL_UTIL_CACHE_H
@@ -0,0 +1,93 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_UTIL_CPU_H
+#define SCL_UTIL_CPU_H
+
+namespace scl::util::cpu {
+
+/**
+ * @brief Instruction set extensions which SCL has specialized code for.
+ *
+ * <p>SCL is built for a baseline x86-64 CPU (unless built with
+ * <code>-DSCL_BUILD_NATIVE=ON</code>). Code which benefits from instruction set
+ * extensions, such as AES-NI in util::PRG or the SHA extensions in
+ * util::Sha256, is compiled separately for each extension and the best
+ * implementation is picked at runtime based on features().</p>
+ */
+struct Features {
+  /**
+   * @brief Population count instruction.
+   */
+  bool popcnt = false;
+
+  /**
+   * @brief AES-NI.
+   */
+  bool aes = false;
+
+  /**
+   * @brief Vector AES, i.e., AES-NI on 256-bit registers.
+   */
+  bool vaes = false;
+
+  /**
+   * @brief Carry-less multiplication.
+   */
+  bool pclmul = false;
+
+  /**
+   * @brief SHA-1 and SHA-256 extensions.
+   */
+  bool sha = false;
+
+  /**
+   * @brief AVX2.
+   */
+  bool avx2 = false;
+
+  /**
+   * @brief AVX-512 foundation.
+   */
+  bool avx512f = false;
+};
+
+/**
+ * @brief Detect the features supported by the CPU that runs the program.
+ */
+Features detect();
+
+/**
+ * @brief Get the features that SCL uses when picking an implementation.
+ *
+ * Initially the same as detect().
+ */
+const Features& features();
+
+/**
+ * @brief Restrict the features that SCL may use.
+ * @param features the features to allow.
+ *
+ * Features that are not supported by the CPU are ignored. Mostly useful for
+ * testing and benchmarking the fallback implementations. Must not be called
+ * while other threads are using SCL.
+ */
+void restrict(const Features& features);
+
+}  // namespace scl::util::cpu
+
+#endif  // SCL_UTIL_CPU_H
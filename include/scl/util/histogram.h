@@ -0,0 +1,163 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_UTIL_HISTOGRAM_H
+#define SCL_UTIL_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace scl::util {
+
+/**
+ * @brief A log-linear histogram of non-negative integers.
+ *
+ * <p>Histogram records values into buckets in the style of an HDR histogram.
+ * Values smaller than <code>2^(precision + 1)</code> are recorded exactly,
+ * while larger values are grouped into buckets whose width is at most a
+ * <code>2^-precision</code> fraction of the values they contain. Percentiles
+ * computed from a Histogram are therefore accurate up to this relative error.
+ * Memory use depends only on the precision and the largest recorded value,
+ * and not on the number of recorded values.</p>
+ *
+ * <p>The mean and variance of the recorded values are tracked exactly, and
+ * two histograms with the same precision can be merged. This makes it
+ * possible to record samples in several threads, or by several parties, and
+ * combine them afterwards.</p>
+ */
+class Histogram {
+ public:
+  /**
+   * @brief Default precision. Gives a relative error of less than 1%.
+   */
+  constexpr static std::size_t DEFAULT_PRECISION = 7;
+
+  /**
+   * @brief Largest supported precision.
+   */
+  constexpr static std::size_t MAX_PRECISION = 16;
+
+  /**
+   * @brief Create a new empty histogram.
+   * @param precision the number of bits of precision of each bucket.
+   * @throws std::invalid_argument if \p precision is 0 or larger than
+   * MAX_PRECISION.
+   */
+  explicit Histogram(std::size_t precision = DEFAULT_PRECISION);
+
+  /**
+   * @brief Record a value.
+   * @param value the value.
+   * @param count the number of times to record \p value.
+   */
+  void record(std::uint64_t value, std::uint64_t count = 1);
+
+  /**
+   * @brief Add all values recorded by another histogram to this histogram.
+   * @param other the other histogram.
+   * @throws std::invalid_argument if \p other has a different precision.
+   */
+  void merge(const Histogram& other);
+
+  /**
+   * @brief Get a percentile of the recorded values.
+   * @param p the percentile, which must be in the range [0, 100].
+   * @return the recorded value at the given percentile.
+   * @throws std::invalid_argument if \p p is not in the range [0, 100].
+   *
+   * The returned value is the largest value in the bucket holding the value
+   * of nearest rank, but never more than the largest recorded value. 0 is
+   * returned if the histogram is empty.
+   */
+  std::uint64_t percentile(double p) const;
+
+  /**
+   * @brief Get the number of recorded values.
+   */
+  std::uint64_t count() const {
+    return m_count;
+  }
+
+  /**
+   * @brief Check if this histogram is empty.
+   */
+  bool empty() const {
+    return m_count == 0;
+  }
+
+  /**
+   * @brief Get the smallest recorded value, or 0 if the histogram is empty.
+   */
+  std::uint64_t min() const {
+    return empty() ? 0 : m_min;
+  }
+
+  /**
+   * @brief Get the largest recorded value, or 0 if the histogram is empty.
+   */
+  std::uint64_t max() const {
+    return m_max;
+  }
+
+  /**
+   * @brief Get the mean of the recorded values.
+   */
+  long double mean() const {
+    return m_mean;
+  }
+
+  /**
+   * @brief Get the sample variance of the recorded values.
+   */
+  long double var() const {
+    return m_count <= 1 ? 0 : m_m2 / (m_count - 1);
+  }
+
+  /**
+   * @brief Get the sample standard deviation of the recorded values.
+   */
+  long double stddev() const;
+
+  /**
+   * @brief Get the precision of this histogram.
+   */
+  std::size_t precision() const {
+    return m_precision;
+  }
+
+ private:
+  std::size_t m_precision;
+  std::vector<std::uint64_t> m_counts;
+
+  std::uint64_t m_count = 0;
+  std::uint64_t m_min = 0;
+  std::uint64_t m_max = 0;
+
+  // running mean and sum of squared differences from the mean, as in
+  // Welford's algorithm.
+  long double m_mean = 0;
+  long double m_m2 = 0;
+
+  std::size_t indexOf(std::uint64_t value) const;
+  std::uint64_t highestValueIn(std::size_t index) const;
+  void update(std::uint64_t count, long double mean, long double m2);
+};
+
+}  // namespace scl::util
+
+#endif  // SCL_UTIL_HISTOGRAM_H
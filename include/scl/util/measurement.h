@@ -20,9 +20,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <ostream>
 #include <vector>
 
+#include "scl/util/histogram.h"
 #include "scl/util/time.h"
 
 namespace scl::util {
@@ -99,13 +101,18 @@ class Measurement {
       return zero();
     }
 
+    // samples are kept in the order they were added, so partially sort a
+    // copy to find the middle element(s).
+    auto samples = m_samples;
     const std::size_t half = size() / 2;
+    const auto mid = samples.begin() + half;
+    std::nth_element(samples.begin(), mid, samples.end());
 
     if (size() % 2 == 1) {
-      return m_samples[half];
+      return *mid;
     }
 
-    return (m_samples[half] + m_samples[half - 1]) / 2;
+    return (*mid + *std::max_element(samples.begin(), mid)) / 2;
   }
 
   /**
@@ -160,6 +167,142 @@ using DataMeasurement = Measurement<long double>;
  */
 std::ostream& operator<<(std::ostream& os, const DataMeasurement& m);
 
+/**
+ * @brief Measurement that does not store its samples.
+ *
+ * <p>StreamingMeasurement records samples in a util::Histogram. It therefore
+ * uses memory independent of the number of samples, and can report tail
+ * percentiles such as p99 and p999 up to the relative error of the histogram.
+ * Measurements from different threads or parties can be combined with
+ * merge().</p>
+ *
+ * <p>Samples are rounded to a non-negative integer before being recorded.
+ * Time samples are recorded in units of util::Time::Duration, and data samples
+ * in bytes.</p>
+ */
+template <typename T>
+class StreamingMeasurement {
+ public:
+  /**
+   * @brief Create a new empty measurement.
+   * @param precision the precision of the underlying histogram.
+   */
+  explicit StreamingMeasurement(
+      std::size_t precision = Histogram::DEFAULT_PRECISION)
+      : m_histogram(precision) {}
+
+  /**
+   * @brief Add a sample to this measurement.
+   * @param sample the sample.
+   */
+  void addSample(const T& sample) {
+    m_histogram.record(toValue(sample));
+  }
+
+  /**
+   * @brief Add all samples of another measurement to this measurement.
+   * @param other the other measurement.
+   */
+  void merge(const StreamingMeasurement<T>& other) {
+    m_histogram.merge(other.m_histogram);
+  }
+
+  /**
+   * @brief Get the mean of the measurement.
+   */
+  T mean() const {
+    return fromValue(m_histogram.mean());
+  }
+
+  /**
+   * @brief Get the sample standard deviation of the measurement.
+   */
+  T stddev() const {
+    return fromValue(m_histogram.stddev());
+  }
+
+  /**
+   * @brief Get a percentile of the measurement.
+   * @param p the percentile, in the range [0, 100].
+   */
+  T percentile(double p) const {
+    return fromValue(m_histogram.percentile(p));
+  }
+
+  /**
+   * @brief Get the median of the measurement.
+   */
+  T median() const {
+    return percentile(50);
+  }
+
+  /**
+   * @brief Get the smallest sample.
+   */
+  T min() const {
+    return fromValue(m_histogram.min());
+  }
+
+  /**
+   * @brief Get the largest sample.
+   */
+  T max() const {
+    return fromValue(m_histogram.max());
+  }
+
+  /**
+   * @brief The number of samples in this measurement.
+   */
+  std::size_t size() const {
+    return m_histogram.count();
+  }
+
+  /**
+   * @brief Check whether this measurement is empty.
+   */
+  bool empty() const {
+    return m_histogram.empty();
+  }
+
+  /**
+   * @brief Read-only access to the underlying histogram.
+   */
+  const Histogram& histogram() const {
+    return m_histogram;
+  }
+
+ private:
+  Histogram m_histogram;
+
+  // conversion to and from the values stored in the histogram.
+  static std::uint64_t toValue(const T& sample);
+  static T fromValue(long double value);
+};
+
+/**
+ * @brief A streaming measurement for time related observations.
+ */
+using StreamingTimeMeasurement = StreamingMeasurement<util::Time::Duration>;
+
+/**
+ * @brief Write a StreamingTimeMeasurement to an std::ostream.
+ *
+ * In addition to the mean and standard deviation, the output includes the
+ * minimum, maximum, number of samples and the p50, p90, p99 and p999
+ * percentiles.
+ */
+std::ostream& operator<<(std::ostream& os, const StreamingTimeMeasurement& m);
+
+/**
+ * @brief A streaming measurement for data related observations.
+ */
+using StreamingDataMeasurement = StreamingMeasurement<long double>;
+
+/**
+ * @brief Write a StreamingDataMeasurement to an std::ostream.
+ */
+std::ostream& operator<<(std::ostream& os, const StreamingDataMeasurement& m);
+
 /**
  * @brief A measurement for data sent and received.
  */
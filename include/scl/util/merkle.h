@@ -23,6 +23,7 @@
 #include "scl/util/bitmap.h"
 #include "scl/util/digest.h"
 #include "scl/util/merkle_proof.h"
+#include "scl/util/trace.h"
 
 namespace scl::util {
 
@@ -93,6 +94,7 @@ auto MerkleTree<HASH, LEAF>::hashLeafs(const std::vector<LEAF>& data)
 
 template <typename HASH, typename LEAF>
 auto MerkleTree<HASH, LEAF>::hash(const std::vector<LEAF>& data) -> DigestType {
+  SCL_TRACE_SPAN("merkle", "MerkleTree::hash");
   std::vector<DigestType> digests = hashLeafs(data);
 
   auto sz = digests.size();
@@ -122,6 +124,7 @@ auto MerkleTree<HASH, LEAF>::hash(const std::vector<LEAF>& data) -> DigestType {
 template <typename HASH, typename LEAF>
 auto MerkleTree<HASH, LEAF>::prove(const std::vector<LEAF>& data,
                                    std::size_t index) -> Proof {
+  SCL_TRACE_SPAN("merkle", "MerkleTree::prove");
   std::vector<DigestType> digests = hashLeafs(data);
   std::vector<DigestType> path;
   std::vector<bool> direction;
@@ -165,6 +168,7 @@ template <typename HASH, typename LEAF>
 bool MerkleTree<HASH, LEAF>::verify(const LEAF& leaf,
                                     const DigestType& root,
                                     const Proof& proof) {
+  SCL_TRACE_SPAN("merkle", "MerkleTree::verify");
   const auto [h, d] = proof;
 
   auto digest = HASH{}.update(leaf).finalize();
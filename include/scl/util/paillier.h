@@ -0,0 +1,420 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_UTIL_PAILLIER_H
+#define SCL_UTIL_PAILLIER_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "scl/math/number.h"
+#include "scl/serialization/serializer.h"
+#include "scl/util/prg.h"
+
+namespace scl::util {
+
+class PrecomputationCache;
+
+/**
+ * @brief The Paillier cryptosystem.
+ *
+ * <p>Paillier is an additively homomorphic public key encryption scheme with
+ * plaintexts in \f$\mathbb{Z}_n\f$ and ciphertexts in \f$\mathbb{Z}_{n^2}\f$.
+ * This implementation uses \f$g = n + 1\f$, decrypts modulo \f$p^2\f$ and
+ * \f$q^2\f$ separately and combines the results with the CRT, and draws the
+ * randomness of a ciphertext as \f$h_n^\alpha\f$ for a fixed \f$h_n =
+ * h^n \mod n^2\f$ and a short exponent \f$\alpha\f$, as suggested by Damgård,
+ * Jurik and Nielsen. The latter allows encryption to use a precomputed table of
+ * powers of \f$h_n\f$, see PublicKey::precompute().</p>
+ *
+ * @code
+ * auto prg = util::PRG::create();
+ * auto sk = util::Paillier::generate(2048, prg);
+ * auto pk = sk.publicKey();
+ * pk.precompute();
+ *
+ * auto c0 = util::Paillier::encrypt(pk, math::Number(2), prg);
+ * auto c1 = util::Paillier::encrypt(pk, math::Number(3), prg);
+ * auto c = util::Paillier::add(pk, c0, c1);
+ * auto m = util::Paillier::decrypt(sk, c);  // m == 5.
+ * @endcode
+ *
+ * @see https://doi.org/10.1007/3-540-48910-X_16
+ * @see https://doi.org/10.1007/s10207-010-0119-9
+ */
+class Paillier {
+ public:
+  /**
+   * @brief A Paillier public key.
+   */
+  class PublicKey {
+   public:
+    /**
+     * @brief Create an empty public key.
+     */
+    PublicKey() = default;
+
+    /**
+     * @brief Create a public key.
+     * @param n the modulus.
+     * @param hn the fixed base used for randomness, \f$h^n \mod n^2\f$.
+     */
+    PublicKey(const math::Number& n, const math::Number& hn);
+
+    /**
+     * @brief The modulus \f$n\f$.
+     */
+    const math::Number& n() const {
+      return m_n;
+    }
+
+    /**
+     * @brief The modulus squared.
+     */
+    const math::Number& n2() const {
+      return m_n2;
+    }
+
+    /**
+     * @brief The base \f$h_n\f$ used for the randomness of ciphertexts.
+     */
+    const math::Number& hn() const {
+      return m_hn;
+    }
+
+    /**
+     * @brief Number of bits in the exponent used for randomness.
+     */
+    std::size_t randomnessBits() const {
+      return m_n.bitSize() / 2;
+    }
+
+    /**
+     * @brief Precompute a table of powers of hn() to speed up encryption.
+     *
+     * The table has randomnessBits() / 4 * 15 entries modulo \f$n^2\f$, or
+     * about 2 MiB for a 2048 bit modulus. Copies of this key share the table.
+     */
+    void precompute();
+
+    /**
+     * @brief Load the table of precompute() from a cache, or compute and
+     *        store it.
+     * @param cache the cache.
+     *
+     * Loading the table from disk is several times faster than computing it,
+     * which matters for short-lived processes that use the same key.
+     */
+    void precompute(PrecomputationCache& cache);
+
+    /**
+     * @brief Check if precompute() has been called on this key.
+     */
+    bool hasPrecomputation() const {
+      return m_table != nullptr;
+    }
+
+    /**
+     * @brief Compare two public keys.
+     */
+    friend bool operator==(const PublicKey& lhs, const PublicKey& rhs) {
+      return lhs.m_n == rhs.m_n && lhs.m_hn == rhs.m_hn;
+    }
+
+   private:
+    struct Table;
+
+    math::Number m_n;
+    math::Number m_n2;
+    math::Number m_hn;
+    std::shared_ptr<const Table> m_table;
+
+    friend class Paillier;
+  };
+
+  /**
+   * @brief A Paillier secret key.
+   */
+  class SecretKey {
+   public:
+    /**
+     * @brief Create an empty secret key.
+     */
+    SecretKey() = default;
+
+    /**
+     * @brief Create a secret key.
+     * @param p the first prime factor of the modulus.
+     * @param q the second prime factor of the modulus.
+     * @param hn the fixed base of the public key.
+     * @throws std::invalid_argument if \p p and \p q are equal.
+     */
+    SecretKey(const math::Number& p,
+              const math::Number& q,
+              const math::Number& hn);
+
+    /**
+     * @brief The public key corresponding to this secret key.
+     */
+    const PublicKey& publicKey() const {
+      return m_pk;
+    }
+
+    /**
+     * @brief The first prime factor of the modulus.
+     */
+    const math::Number& p() const {
+      return m_p;
+    }
+
+    /**
+     * @brief The second prime factor of the modulus.
+     */
+    const math::Number& q() const {
+      return m_q;
+    }
+
+   private:
+    PublicKey m_pk;
+    math::Number m_p;
+    math::Number m_q;
+    math::Number m_p2;
+    math::Number m_q2;
+    math::Number m_p_minus_one;
+    math::Number m_q_minus_one;
+    math::Number m_hp;
+    math::Number m_hq;
+    math::Number m_q_inv;
+
+    friend class Paillier;
+  };
+
+  /**
+   * @brief A Paillier ciphertext.
+   */
+  struct Ciphertext {
+    /**
+     * @brief The ciphertext as an element of \f$\mathbb{Z}_{n^2}\f$.
+     */
+    math::Number value;
+
+    /**
+     * @brief Compare two ciphertexts.
+     */
+    friend bool operator==(const Ciphertext& lhs, const Ciphertext& rhs) {
+      return lhs.value == rhs.value;
+    }
+  };
+
+  /**
+   * @brief Generate a new key pair.
+   * @param bits the size of the modulus in bits.
+   * @param prg the PRG used to generate the primes.
+   * @param threads the number of parallel searches for each prime. 0 uses
+   *        one per thread of ThreadPool::global(). Keys are only
+   *        deterministic given \p prg when this is 1.
+   * @return a secret key. The public key is available through
+   *         SecretKey::publicKey().
+   * @see math::generateRSAModulus()
+   */
+  static SecretKey generate(std::size_t bits,
+                            PRG& prg,
+                            std::size_t threads = 1);
+
+  /**
+   * @brief Encrypt a plaintext.
+   * @param pk the public key.
+   * @param m the plaintext. Reduced modulo \f$n\f$.
+   * @param prg the PRG used to generate the randomness of the ciphertext.
+   * @return an encryption of \p m.
+   */
+  static Ciphertext encrypt(const PublicKey& pk,
+                            const math::Number& m,
+                            PRG& prg);
+
+  /**
+   * @brief Encrypt a batch of plaintexts using several threads.
+   * @param pk the public key.
+   * @param ms the plaintexts.
+   * @param prg the PRG used to generate the randomness of the ciphertexts.
+   * @param threads the number of chunks the batch is split into. Chunks run
+   *        on ThreadPool::global(). 0 uses one per thread of the pool.
+   * @return encryptions of \p ms.
+   *
+   * The randomness is drawn from \p prg before any work is split into
+   * chunks, so the result is the same as calling encrypt() on each plaintext
+   * in order.
+   */
+  static std::vector<Ciphertext> encrypt(const PublicKey& pk,
+                                         const std::vector<math::Number>& ms,
+                                         PRG& prg,
+                                         std::size_t threads = 0);
+
+  /**
+   * @brief Decrypt a ciphertext.
+   * @param sk the secret key.
+   * @param c the ciphertext.
+   * @return the plaintext, in \f$[0, n)\f$.
+   */
+  static math::Number decrypt(const SecretKey& sk, const Ciphertext& c);
+
+  /**
+   * @brief Decrypt a batch of ciphertexts using several threads.
+   * @param sk the secret key.
+   * @param cs the ciphertexts.
+   * @param threads the number of chunks the batch is split into. Chunks run
+   *        on ThreadPool::global(). 0 uses one per thread of the pool.
+   * @return the plaintexts.
+   */
+  static std::vector<math::Number> decrypt(const SecretKey& sk,
+                                           const std::vector<Ciphertext>& cs,
+                                           std::size_t threads = 0);
+
+  /**
+   * @brief Homomorphically add two ciphertexts.
+   * @return an encryption of the sum of the plaintexts of \p a and \p b.
+   */
+  static Ciphertext add(const PublicKey& pk,
+                        const Ciphertext& a,
+                        const Ciphertext& b);
+
+  /**
+   * @brief Homomorphically multiply a ciphertext with a constant.
+   * @return an encryption of \p k times the plaintext of \p c.
+   */
+  static Ciphertext scalarMultiply(const PublicKey& pk,
+                                   const Ciphertext& c,
+                                   const math::Number& k);
+};
+
+}  // namespace scl::util
+
+namespace scl::seri {
+
+/**
+ * @brief Serializer specialization for a Paillier ciphertext.
+ */
+template <>
+struct Serializer<util::Paillier::Ciphertext> {
+  /**
+   * @brief Size of a ciphertext in bytes.
+   */
+  static std::size_t sizeOf(const util::Paillier::Ciphertext& c) {
+    return Serializer<math::Number>::sizeOf(c.value);
+  }
+
+  /**
+   * @brief Write a ciphertext to a buffer.
+   */
+  static std::size_t write(const util::Paillier::Ciphertext& c,
+                           unsigned char* buf) {
+    return Serializer<math::Number>::write(c.value, buf);
+  }
+
+  /**
+   * @brief Read a ciphertext from a buffer.
+   */
+  static std::size_t read(util::Paillier::Ciphertext& c,
+                          const unsigned char* buf) {
+    return Serializer<math::Number>::read(c.value, buf);
+  }
+};
+
+/**
+ * @brief Serializer specialization for a Paillier public key.
+ *
+ * Only \f$n\f$ and \f$h_n\f$ are written. The table created by
+ * util::Paillier::PublicKey::precompute() is not.
+ */
+template <>
+struct Serializer<util::Paillier::PublicKey> {
+  /**
+   * @brief Size of a public key in bytes.
+   */
+  static std::size_t sizeOf(const util::Paillier::PublicKey& pk) {
+    return Serializer<math::Number>::sizeOf(pk.n()) +
+           Serializer<math::Number>::sizeOf(pk.hn());
+  }
+
+  /**
+   * @brief Write a public key to a buffer.
+   */
+  static std::size_t write(const util::Paillier::PublicKey& pk,
+                           unsigned char* buf) {
+    auto offset = Serializer<math::Number>::write(pk.n(), buf);
+    return offset + Serializer<math::Number>::write(pk.hn(), buf + offset);
+  }
+
+  /**
+   * @brief Read a public key from a buffer.
+   */
+  static std::size_t read(util::Paillier::PublicKey& pk,
+                          const unsigned char* buf) {
+    math::Number n;
+    math::Number hn;
+    auto offset = Serializer<math::Number>::read(n, buf);
+    offset += Serializer<math::Number>::read(hn, buf + offset);
+    pk = util::Paillier::PublicKey(n, hn);
+    return offset;
+  }
+};
+
+/**
+ * @brief Serializer specialization for a Paillier secret key.
+ */
+template <>
+struct Serializer<util::Paillier::SecretKey> {
+  /**
+   * @brief Size of a secret key in bytes.
+   */
+  static std::size_t sizeOf(const util::Paillier::SecretKey& sk) {
+    return Serializer<math::Number>::sizeOf(sk.p()) +
+           Serializer<math::Number>::sizeOf(sk.q()) +
+           Serializer<math::Number>::sizeOf(sk.publicKey().hn());
+  }
+
+  /**
+   * @brief Write a secret key to a buffer.
+   */
+  static std::size_t write(const util::Paillier::SecretKey& sk,
+                           unsigned char* buf) {
+    auto offset = Serializer<math::Number>::write(sk.p(), buf);
+    offset += Serializer<math::Number>::write(sk.q(), buf + offset);
+    return offset +
+           Serializer<math::Number>::write(sk.publicKey().hn(), buf + offset);
+  }
+
+  /**
+   * @brief Read a secret key from a buffer.
+   */
+  static std::size_t read(util::Paillier::SecretKey& sk,
+                          const unsigned char* buf) {
+    math::Number p;
+    math::Number q;
+    math::Number hn;
+    auto offset = Serializer<math::Number>::read(p, buf);
+    offset += Serializer<math::Number>::read(q, buf + offset);
+    offset += Serializer<math::Number>::read(hn, buf + offset);
+    sk = util::Paillier::SecretKey(p, q, hn);
+    return offset;
+  }
+};
+
+}  // namespace scl::seri
+
+#endif  // SCL_UTIL_PAILLIER_H
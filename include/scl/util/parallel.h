@@ -0,0 +1,186 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_UTIL_PARALLEL_H
+#define SCL_UTIL_PARALLEL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace scl::util {
+
+/**
+ * @brief A fixed set of worker threads that run batches of tasks.
+ *
+ * <p>A batch of tasks is started with run(), which hands out task indices to
+ * the workers and to the calling thread, and returns once every task has
+ * finished. Several threads may call run() at the same time, and a task may
+ * itself call run(), in which case the calling worker helps finish the inner
+ * batch.</p>
+ *
+ * <p>Most code should not use a ThreadPool directly, but instead pass the
+ * util::par policy to one of the operations that accept it, e.g.,
+ * math::Vector::add().</p>
+ */
+class ThreadPool final {
+ public:
+  /**
+   * @brief The pool used when a Parallel policy does not name one.
+   *
+   * Created on first use with one worker less than the number of hardware
+   * threads, since the thread calling run() takes part as well.
+   */
+  static ThreadPool& global();
+
+  /**
+   * @brief Create a new ThreadPool.
+   * @param workers the number of worker threads.
+   */
+  explicit ThreadPool(std::size_t workers);
+
+  /**
+   * @brief Destructor. Stops and joins all workers.
+   *
+   * No batch may be running when a ThreadPool is destroyed.
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * @brief Number of worker threads, not counting the caller of run().
+   */
+  std::size_t workers() const {
+    return m_workers.size();
+  }
+
+  /**
+   * @brief Run a batch of tasks.
+   * @param tasks the number of tasks.
+   * @param task function called as <code>task(i)</code> for each i in
+   *        <code>[0, tasks)</code>.
+   *
+   * If a task throws, the remaining tasks are still run and the first
+   * exception is rethrown in the calling thread.
+   */
+  void run(std::size_t tasks, const std::function<void(std::size_t)>& task);
+
+ private:
+  struct Batch;
+
+  void work();
+
+  std::vector<std::thread> m_workers;
+  std::deque<std::shared_ptr<Batch>> m_batches;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_stop = false;
+};
+
+/**
+ * @brief Execution policy for data-parallel operations.
+ *
+ * <p>Operations that accept a Parallel policy split their input into chunks of
+ * grain elements and hand the chunks to a ThreadPool. Inputs with at most one
+ * chunk are processed in the calling thread. Since chunk boundaries depend only
+ * on the input size and the grain, and partial results of reductions are
+ * combined in chunk order, the result never depends on the number of threads or
+ * how chunks are scheduled.</p>
+ *
+ * @code
+ * auto z = x.add(y, util::par);  // same as x.add(y), using all cores.
+ * auto w = x.dot(y, util::Parallel{.grain = 1 << 12});
+ * @endcode
+ */
+struct Parallel {
+  /**
+   * @brief The number of elements in each chunk.
+   */
+  std::size_t grain = 1 << 14;
+
+  /**
+   * @brief The pool to run chunks on. nullptr means ThreadPool::global().
+   */
+  ThreadPool* pool = nullptr;
+};
+
+/**
+ * @brief The default parallel execution policy.
+ */
+inline constexpr Parallel par{};
+
+/**
+ * @brief Call a function on chunks of a range in parallel.
+ * @param n the size of the range.
+ * @param policy the execution policy.
+ * @param f function called as <code>f(begin, end)</code> for each chunk.
+ */
+template <typename F>
+void parallelFor(std::size_t n, const Parallel& policy, F&& f) {
+  const auto grain = std::max<std::size_t>(policy.grain, 1);
+  const auto chunks = (n + grain - 1) / grain;
+  if (chunks <= 1) {
+    f(std::size_t{0}, n);
+    return;
+  }
+
+  auto& pool = policy.pool == nullptr ? ThreadPool::global() : *policy.pool;
+  pool.run(chunks, [&f, grain, n](std::size_t c) {
+    f(c * grain, std::min(n, (c + 1) * grain));
+  });
+}
+
+/**
+ * @brief Compute a sum over chunks of a range in parallel.
+ * @param n the size of the range.
+ * @param policy the execution policy.
+ * @param f function called as <code>f(begin, end)</code> for each chunk,
+ *        returning the partial result of that chunk.
+ * @return the sum of the partial results, added in chunk order.
+ */
+template <typename T, typename F>
+T parallelReduce(std::size_t n, const Parallel& policy, F&& f) {
+  const auto grain = std::max<std::size_t>(policy.grain, 1);
+  const auto chunks = (n + grain - 1) / grain;
+  if (chunks <= 1) {
+    return f(std::size_t{0}, n);
+  }
+
+  std::vector<T> partial(chunks);
+  auto& pool = policy.pool == nullptr ? ThreadPool::global() : *policy.pool;
+  pool.run(chunks, [&f, &partial, grain, n](std::size_t c) {
+    partial[c] = f(c * grain, std::min(n, (c + 1) * grain));
+  });
+
+  T sum = std::move(partial[0]);
+  for (std::size_t c = 1; c < chunks; ++c) {
+    sum += partial[c];
+  }
+  return sum;
+}
+
+}  // namespace scl::util
+
+#endif  // SCL_UTIL_PARALLEL_H
@@ -26,7 +26,7 @@
 #include <tuple>
 #include <vector>
 
-#include <emmintrin.h>
+#include "scl/util/aes.h"
 
 /**
  * @brief 64 bit nonce which is prepended to the counter in the PRG.
@@ -44,6 +44,8 @@
 
 namespace scl::util {
 
+struct Parallel;
+
 /**
  * @brief Pseudorandom generator based on AES-CTR.
  *
@@ -63,8 +65,7 @@ namespace scl::util {
  */
 class PRG {
  private:
-  using BlockType = __m128i;
-  static constexpr std::size_t BLOCK_SIZE = sizeof(BlockType);
+  static constexpr std::size_t BLOCK_SIZE = AES::BLOCK_SIZE;
 
  public:
   /**
@@ -92,6 +93,14 @@ class PRG {
    */
   static PRG create(const std::string& seed);
 
+  /**
+   * @brief Create a new PRG seeded with output of this PRG.
+   *
+   * Useful for giving each of several threads its own stream of randomness,
+   * which is deterministic given the state of this PRG.
+   */
+  PRG fork();
+
   /**
    * @brief Reset the PRG.
    *
@@ -106,6 +115,18 @@ class PRG {
    */
   void next(unsigned char* buffer, std::size_t n);
 
+  /**
+   * @brief Generate random data in parallel.
+   * @param buffer the buffer
+   * @param n how many bytes of random data to generate
+   * @param policy the execution policy
+   *
+   * The output and the state of the PRG afterwards are the same as if
+   * <code>next(buffer, n)</code> had been called. The grain of \p policy is
+   * counted in blocks of BLOCK_SIZE bytes.
+   */
+  void next(unsigned char* buffer, std::size_t n, const Parallel& policy);
+
   /**
    * @brief Generate random data and store it in a supplied buffer.
    * @param buffer the buffer with space pre-allocated
@@ -162,14 +183,12 @@ class PRG {
   }
 
  private:
-  PRG(std::array<unsigned char, BLOCK_SIZE> seed) : m_seed(seed){};
+  PRG(std::array<unsigned char, BLOCK_SIZE> seed)
+      : m_seed(seed), m_aes(m_seed.data()){};
 
   std::array<unsigned char, BLOCK_SIZE> m_seed = {0};
   long m_counter = PRG_INITIAL_COUNTER;
-  BlockType m_state[11];
-
-  void update();
-  void init();
+  AES m_aes;
 };
 
 }  // namespace scl::util
@@ -0,0 +1,265 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_UTIL_TRACE_H
+#define SCL_UTIL_TRACE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Tracing of spans of execution.
+ *
+ * <p>Spans are recorded into a ring buffer owned by the recording thread, and
+ * can afterwards be exported in the Chrome <code>trace_event</code> format
+ * with writeChromeTrace. The resulting file can be opened in
+ * <code>chrome://tracing</code> or Perfetto.</p>
+ *
+ * <p>The macros SCL_TRACE_SPAN and SCL_TRACE_ASYNC_SPAN are used to
+ * instrument code. They expand to nothing unless SCL is built with
+ * <code>SCL_ENABLE_TRACING</code> defined, which is done by passing
+ * <code>-DSCL_ENABLE_TRACING=ON</code> to cmake.</p>
+ */
+namespace scl::util::trace {
+
+/**
+ * @brief Read the current timestamp.
+ *
+ * Uses the time stamp counter on x86 and std::chrono::steady_clock elsewhere.
+ * Timestamps are converted to wall clock time when a trace is exported.
+ */
+inline std::uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  const auto t = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+#endif
+}
+
+/**
+ * @brief A recorded span.
+ */
+struct Event {
+  /**
+   * @brief The category of the span, e.g., "net".
+   */
+  const char* category;
+
+  /**
+   * @brief The name of the span.
+   */
+  const char* name;
+
+  /**
+   * @brief Timestamp of when the span began.
+   */
+  std::uint64_t begin;
+
+  /**
+   * @brief Timestamp of when the span ended.
+   */
+  std::uint64_t end;
+
+  /**
+   * @brief ID of an asynchronous span, or 0 if the span is synchronous.
+   */
+  std::uint64_t id;
+};
+
+/**
+ * @brief Ring buffer of events recorded by a single thread.
+ *
+ * Only the owning thread writes to a Buffer, so recording an event is a plain
+ * store followed by a release store of the write position. Once the buffer is
+ * full, new events overwrite the oldest ones.
+ */
+class Buffer {
+ public:
+  /**
+   * @brief Number of events a buffer can hold.
+   */
+  constexpr static std::size_t CAPACITY = 1 << 16;
+
+  /**
+   * @brief Record an event.
+   */
+  void push(const Event& event) noexcept {
+    const auto head = m_head.load(std::memory_order_relaxed);
+    m_events[head % CAPACITY] = event;
+    m_head.store(head + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Total number of events pushed to this buffer.
+   */
+  std::uint64_t pushed() const noexcept {
+    return m_head.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Get an event by the order it was pushed.
+   */
+  const Event& at(std::uint64_t i) const noexcept {
+    return m_events[i % CAPACITY];
+  }
+
+  /**
+   * @brief Forget all recorded events.
+   */
+  void clear() noexcept {
+    m_head.store(0, std::memory_order_release);
+  }
+
+ private:
+  std::array<Event, CAPACITY> m_events;
+  std::atomic<std::uint64_t> m_head = 0;
+};
+
+/**
+ * @brief Get the buffer of the calling thread.
+ *
+ * The buffer is allocated on first use and stays alive after the thread exits,
+ * so that its events can still be exported.
+ */
+Buffer& threadBuffer();
+
+/**
+ * @brief Get a fresh ID for an asynchronous span.
+ */
+std::uint64_t nextAsyncId() noexcept;
+
+/**
+ * @brief Write all recorded events as Chrome trace_event JSON.
+ * @param stream the stream to write the trace to.
+ *
+ * Events are only read consistently if no thread records events while the
+ * trace is being written.
+ */
+void writeChromeTrace(std::ostream& stream);
+
+/**
+ * @brief Forget all recorded events in all threads.
+ */
+void clear();
+
+/**
+ * @brief Span of synchronous execution, recorded when it goes out of scope.
+ */
+class Span {
+ public:
+  /**
+   * @brief Begin a new span.
+   * @param category the category of the span.
+   * @param name the name of the span.
+   *
+   * \p category and \p name must be string literals, or otherwise outlive the
+   * trace.
+   */
+  Span(const char* category, const char* name) noexcept
+      : m_category(category), m_name(name), m_begin(now()) {}
+
+  /**
+   * @brief End the span.
+   */
+  ~Span() {
+    threadBuffer().push({m_category, m_name, m_begin, now(), 0});
+  }
+
+  Span(const Span&) = delete;
+  Span& operator=(const Span&) = delete;
+
+ private:
+  const char* m_category;
+  const char* m_name;
+  std::uint64_t m_begin;
+};
+
+/**
+ * @brief Span which may be suspended, such as one in a coroutine.
+ *
+ * Other spans may begin and end on the same thread while an asynchronous span
+ * is suspended. Asynchronous spans are therefore exported as separate tracks,
+ * which keeps the time a coroutine spent suspended, e.g., waiting for data on
+ * a channel, visible in the trace.
+ */
+class AsyncSpan {
+ public:
+  /**
+   * @brief Begin a new asynchronous span.
+   * @param category the category of the span.
+   * @param name the name of the span.
+   */
+  AsyncSpan(const char* category, const char* name) noexcept
+      : m_category(category),
+        m_name(name),
+        m_begin(now()),
+        m_id(nextAsyncId()) {}
+
+  /**
+   * @brief End the span.
+   */
+  ~AsyncSpan() {
+    threadBuffer().push({m_category, m_name, m_begin, now(), m_id});
+  }
+
+  AsyncSpan(const AsyncSpan&) = delete;
+  AsyncSpan& operator=(const AsyncSpan&) = delete;
+
+ private:
+  const char* m_category;
+  const char* m_name;
+  std::uint64_t m_begin;
+  std::uint64_t m_id;
+};
+
+}  // namespace scl::util::trace
+
+#define SCL_TRACE_CONCAT_IMPL(a, b) a##b
+#define SCL_TRACE_CONCAT(a, b) SCL_TRACE_CONCAT_IMPL(a, b)
+#define SCL_TRACE_VAR SCL_TRACE_CONCAT(scl_trace_, __LINE__)
+
+#ifdef SCL_ENABLE_TRACING
+
+/**
+ * @brief Trace the enclosing scope as a synchronous span.
+ */
+#define SCL_TRACE_SPAN(category, name) \
+  const ::scl::util::trace::Span SCL_TRACE_VAR(category, name)
+
+/**
+ * @brief Trace the enclosing scope as an asynchronous span.
+ */
+#define SCL_TRACE_ASYNC_SPAN(category, name) \
+  const ::scl::util::trace::AsyncSpan SCL_TRACE_VAR(category, name)
+
+#else
+
+#define SCL_TRACE_SPAN(category, name) static_cast<void>(0)
+#define SCL_TRACE_ASYNC_SPAN(category, name) static_cast<void>(0)
+
+#endif  // SCL_ENABLE_TRACING
+
+#endif  // SCL_UTIL_TRACE_H
@@ -0,0 +1,72 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCL_UTIL_TRANSPOSE_H
+#define SCL_UTIL_TRANSPOSE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "scl/util/bitmap.h"
+
+namespace scl::util {
+
+/**
+ * @brief Transpose a bit matrix.
+ * @param in the input matrix. Row \f$i\f$ starts at
+ *        <code>in + i * in_stride</code>, and bit \f$j\f$ of a row is bit
+ *        <code>j % 8</code> of byte <code>j / 8</code>.
+ * @param in_stride the distance in bytes between rows of \p in. Must be at
+ *        least <code>(cols + 7) / 8</code>.
+ * @param out the output matrix, in the same layout as \p in.
+ * @param out_stride the distance in bytes between rows of \p out. Must be at
+ *        least <code>(rows + 7) / 8</code>.
+ * @param rows the number of rows of \p in, i.e., the number of bits in each
+ *        row of \p out.
+ * @param cols the number of columns of \p in, i.e., the number of rows of
+ *        \p out.
+ *
+ * <p>The layout is the same as that of a util::Bitmap, so a matrix whose rows
+ * are packed 64-bit words can be transposed directly. Only the first
+ * <code>(rows + 7) / 8</code> bytes of each row of \p out are written, and bits
+ * past \p rows in the last of these are set to 0.</p>
+ *
+ * <p>Blocks of 16 rows and 128 columns (32 rows with AVX2) are loaded into
+ * registers, transposed as a matrix of bytes, after which
+ * <code>movemask</code> extracts 16 (or 32) bits of an output row at a time.
+ * Large matrices are processed in tiles of 512 by 512 bits so that the rows
+ * read and written by a tile stay in cache. Rows and columns that do not fill
+ * a block are handled separately, so any size is supported.</p>
+ */
+void transposeBits(const unsigned char* in,
+                   std::size_t in_stride,
+                   unsigned char* out,
+                   std::size_t out_stride,
+                   std::size_t rows,
+                   std::size_t cols);
+
+/**
+ * @brief Transpose a bit matrix given by its rows.
+ * @param rows the rows of the matrix.
+ * @return the columns of the matrix.
+ * @throws std::invalid_argument if the rows do not all have the same size.
+ */
+std::vector<Bitmap> transposeBits(const std::vector<Bitmap>& rows);
+
+}  // namespace scl::util
+
+#endif  // SCL_UTIL_TRANSPOSE_H
@@ -0,0 +1,284 @@
+#!/usr/bin/env python3
+
+# Checks the benchmarks of SCL for performance regressions.
+#
+# Results of scl_bench and (optionally) scl_netbench are compared against a
+# baseline stored as JSON in bench/baselines/<profile>.json, where the profile
+# identifies the machine. If no baseline exists for the profile, the results are
+# stored as the new baseline. Pass --update to replace an existing baseline.
+#
+# A benchmark is flagged as a regression if its median got worse by more than
+# its threshold, and a one-sided Mann-Whitney U test on the samples agrees that
+# the difference is significant. The script exits with status 1 if any
+# regressions were found.
+
+import argparse
+import datetime
+import functools
+import json
+import math
+import os
+import re
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# default thresholds as (regex, threshold) pairs. The last matching entry is
+# used, so more specific entries should come later.
+DEFAULT_THRESHOLDS = [
+    (r'.*', 0.10),
+    # measurements over real sockets are a lot noisier.
+    (r'^net:', 0.25),
+]
+
+# arguments for scl_netbench that keeps its running time reasonable.
+NETBENCH_ARGS = ['-rounds', '100',
+                 '-stream_bytes', str(32 << 20),
+                 '-max_size', str(4 << 20),
+                 '-max_parties', '4']
+
+
+def run_json(cmd):
+    print('running', ' '.join(cmd), file=sys.stderr)
+    out = subprocess.run(cmd + ['-json', '-'],
+                         check=True,
+                         stdout=subprocess.PIPE,
+                         stderr=subprocess.DEVNULL,
+                         text=True).stdout
+    # scl_bench prints results as text before the JSON.
+    return json.loads(out[out.index('{\n'):])
+
+
+def metric(unit, better, samples):
+    return {'unit': unit, 'better': better, 'samples': samples}
+
+
+def bench_metrics(results):
+    metrics = {}
+    for b in results['benchmarks']:
+        name = 'bench:' + b['name']
+        metrics[name] = metric('ns/op', 'lower', b['ns_per_op']['samples'])
+        metrics[name + ':allocs'] = metric(
+            'allocs/op', 'lower', [b['allocs_per_op']])
+    return metrics
+
+
+def netbench_metrics(runs):
+    # scl_netbench reports a single value per experiment, so each run
+    # contributes one sample.
+    metrics = {}
+
+    def add(name, unit, better, value):
+        metrics.setdefault(name, metric(unit, better, []))
+        metrics[name]['samples'].append(value)
+
+    for r in runs:
+        for e in r['ping_pong']:
+            add(f'net:ping_pong/{e["size"]}:p50',
+                e['latency']['unit'], 'lower', e['latency']['p50'])
+        for e in r['stream']:
+            add(f'net:stream/{e["size"]}',
+                'MiB/s', 'higher', e['mib_per_second'])
+        for e in r['all_to_all']:
+            add(f'net:all_to_all/{e["parties"]}:p50',
+                e['latency']['unit'], 'lower', e['latency']['p50'])
+    return metrics
+
+
+def profile_name(context):
+    name = f'{context["host"]}-{context["cpu"]}-{context["num_cpus"]}'
+    return re.sub(r'[^A-Za-z0-9_.-]+', '_', name).strip('_')
+
+
+def median(samples):
+    s = sorted(samples)
+    n = len(s)
+    return s[n // 2] if n % 2 else (s[n // 2 - 1] + s[n // 2]) / 2
+
+
+@functools.lru_cache(maxsize=None)
+def u_counts(n1, n2):
+    # number of orderings of n1 + n2 distinct values for which U = u.
+    if n1 == 0 or n2 == 0:
+        return (1,)
+    a = u_counts(n1 - 1, n2)
+    b = u_counts(n1, n2 - 1)
+    counts = [0] * (n1 * n2 + 1)
+    for u, c in enumerate(a):
+        counts[u + n2] += c
+    for u, c in enumerate(b):
+        counts[u] += c
+    return tuple(counts)
+
+
+def p_worse(base, new, better):
+    """One-sided Mann-Whitney U test that new is worse than base.
+
+    Returns None if there are too few samples to say anything.
+    """
+    n1 = len(new)
+    n2 = len(base)
+    if n1 < 2 or n2 < 2:
+        return None
+
+    def worse(x, y):
+        return x > y if better == 'lower' else x < y
+
+    u = sum(1.0 if worse(x, y) else 0.5 if x == y else 0.0
+            for x in new for y in base)
+
+    if n1 <= 20 and n2 <= 20:
+        counts = u_counts(n1, n2)
+        return sum(counts[math.floor(u):]) / sum(counts)
+
+    mu = n1 * n2 / 2
+    sigma = math.sqrt(n1 * n2 * (n1 + n2 + 1) / 12)
+    z = (u - mu - 0.5) / sigma
+    return 0.5 * math.erfc(z / math.sqrt(2))
+
+
+def threshold_for(name, thresholds):
+    t = None
+    for regex, value in thresholds:
+        if re.search(regex, name):
+            t = value
+    return t
+
+
+def compare(baseline, current, thresholds, alpha):
+    regressions = 0
+    rows = []
+    for name, m in current.items():
+        if name not in baseline:
+            rows.append((name, '', '', '', '', 'new'))
+            continue
+
+        b = baseline[name]
+        mb = median(b['samples'])
+        mn = median(m['samples'])
+        is_allocs = name.endswith(':allocs')
+
+        if is_allocs:
+            # allocations are deterministic, so any increase is a regression.
+            change = mn - mb
+            worse = change > 0.5
+            better = change < -0.5
+            p = None
+            change_str = f'{change:+.2f}'
+        else:
+            change = (mn - mb) / mb if mb else 0.0
+            if m['better'] == 'higher':
+                change = -change
+            t = threshold_for(name, thresholds)
+            p = p_worse(b['samples'], m['samples'], m['better'])
+            p_better = p_worse(m['samples'], b['samples'], m['better'])
+            significant = p is None or p < alpha
+            worse = change > t and significant
+            better = change < -t and (p_better is None or p_better < alpha)
+            change_str = f'{100 * change:+.1f}%'
+
+        status = 'REGRESSION' if worse else 'improved' if better else 'ok'
+        if worse:
+            regressions += 1
+        if is_allocs and status == 'ok':
+            continue
+
+        p_str = '' if p is None else f'{p:.3f}'
+        rows.append((name,
+                     f'{mb:.4g} {m["unit"]}',
+                     f'{mn:.4g} {m["unit"]}',
+                     change_str,
+                     p_str,
+                     status))
+
+    for name in baseline:
+        if name not in current:
+            rows.append((name, '', '', '', '', 'missing'))
+
+    header = ('benchmark', 'baseline', 'current', 'change', 'p', 'status')
+    widths = [max(len(r[i]) for r in rows + [header]) for i in range(6)]
+    for r in [header] + rows:
+        print('  '.join(c.ljust(w) for c, w in zip(r, widths)).rstrip())
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Check SCL benchmarks for performance regressions.')
+    parser.add_argument('--bench', required=True,
+                        help='path to scl_bench')
+    parser.add_argument('--netbench',
+                        help='path to scl_netbench (network benchmarks are '
+                        'skipped if not given)')
+    parser.add_argument('--filter', default='',
+                        help='only run scl_bench benchmarks matching regex')
+    parser.add_argument('--repetitions', type=int, default=5,
+                        help='repetitions of each scl_bench benchmark')
+    parser.add_argument('--net-repetitions', type=int, default=3,
+                        help='number of times to run scl_netbench')
+    parser.add_argument('--threshold', action='append', default=[],
+                        metavar='[REGEX=]VALUE',
+                        help='allowed relative slowdown, e.g. 0.1 for 10%%, '
+                        'optionally only for benchmarks matching REGEX. '
+                        'May be given several times')
+    parser.add_argument('--alpha', type=float, default=0.05,
+                        help='significance level of the statistical test')
+    parser.add_argument('--profile',
+                        help='name of the machine profile (default: derived '
+                        'from host name and CPU)')
+    parser.add_argument('--baseline-dir',
+                        default=os.path.join(ROOT, 'bench', 'baselines'),
+                        help='directory with baselines')
+    parser.add_argument('--update', action='store_true',
+                        help='store the results as the new baseline')
+    args = parser.parse_args()
+
+    thresholds = list(DEFAULT_THRESHOLDS)
+    for t in args.threshold:
+        regex, _, value = t.rpartition('=')
+        thresholds.append((regex or r'.*', float(value)))
+
+    cmd = [args.bench, '-repetitions', str(args.repetitions)]
+    if args.filter:
+        cmd += ['-filter', args.filter]
+    results = run_json(cmd)
+    context = results['context']
+    current = bench_metrics(results)
+
+    if args.netbench:
+        runs = [run_json([args.netbench] + NETBENCH_ARGS)
+                for _ in range(args.net_repetitions)]
+        current.update(netbench_metrics(runs))
+
+    profile = args.profile or profile_name(context)
+    path = os.path.join(args.baseline_dir, profile + '.json')
+
+    if args.update or not os.path.exists(path):
+        os.makedirs(args.baseline_dir, exist_ok=True)
+        with open(path, 'w') as f:
+            json.dump({'profile': profile,
+                       'context': context,
+                       'date': datetime.date.today().isoformat(),
+                       'metrics': current},
+                      f, indent=1)
+            f.write('\n')
+        print(f'stored baseline for {profile} in {path}')
+        return 0
+
+    with open(path) as f:
+        baseline = json.load(f)
+
+    print(f'comparing against baseline for {profile} from {baseline["date"]}')
+    regressions = compare(baseline['metrics'], current, thresholds, args.alpha)
+    if regressions:
+        print(f'{regressions} regression(s) found')
+        return 1
+
+    print('no regressions found')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
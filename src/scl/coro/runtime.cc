@@ -20,6 +20,7 @@
 #include <coroutine>
 
 #include "scl/coro/task.h"
+#include "scl/util/trace.h"
 
 using namespace scl;
 
@@ -31,6 +32,7 @@ void coro::details::removeHandle(Runtime* runtime,
 }
 
 std::coroutine_handle<> coro::DefaultRuntime::next() {
+  SCL_TRACE_SPAN("coro", "Runtime::next");
   auto b = m_tq.begin();
   const auto e = m_tq.end();
   while (b != e) {
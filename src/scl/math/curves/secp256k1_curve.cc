@@ -74,6 +74,17 @@ std::array<Field, 2> math::ec::toAffine<Curve>(const Point& point) {
   return {GET_X(point) * Z, GET_Y(point) * Z};
 }
 
+template <>
+Field math::ec::denominator<Curve>(const Point& point) {
+  return GET_Z(point);
+}
+
+template <>
+std::array<Field, 2> math::ec::toAffine<Curve>(const Point& point,
+                                               const Field& inverse) {
+  return {GET_X(point) * inverse, GET_Y(point) * inverse};
+}
+
 template <>
 bool math::ec::equal<Curve>(const Point& in1, const Point& in2) {
   const auto& Z1 = GET_Z(in1);
@@ -173,11 +184,11 @@ void addProj(Field& x1,
   z1 = z3;
 }
 
-void addMixed(Field& x1,
-              Field& y1,
-              Field& z1,
-              const Field& x2,
-              const Field& y2) {
+void addAffine(Field& x1,
+               Field& y1,
+               Field& z1,
+               const Field& x2,
+               const Field& y2) {
   static const auto b3 = Field(3 * 7);
 
   auto t0 = x1 * x2;
@@ -262,7 +273,7 @@ void math::ec::add<Curve>(Point& out, const Point& in) {
   // https://eprint.iacr.org/2015/1060.pdf algorithm 7, 8
 
   if (GET_Z(in) == Field::one()) {
-    addMixed(GET_X(out), GET_Y(out), GET_Z(out), GET_X(in), GET_Y(in));
+    addAffine(GET_X(out), GET_Y(out), GET_Z(out), GET_X(in), GET_Y(in));
   } else {
     addProj(GET_X(out),
             GET_Y(out),
@@ -273,6 +284,15 @@ void math::ec::add<Curve>(Point& out, const Point& in) {
   }
 }
 
+template <>
+void math::ec::addMixed<Curve>(Point& out, const std::array<Field, 2>& in) {
+  if (isPointAtInfinity<Curve>(out)) {
+    out = {in[0], in[1], Field::one()};
+  } else {
+    addAffine(GET_X(out), GET_Y(out), GET_Z(out), in[0], in[1]);
+  }
+}
+
 template <>
 void math::ec::negate<Curve>(Point& out) {
   if (GET_Y(out) == Field::zero()) {
@@ -289,20 +309,120 @@ void math::ec::subtract<Curve>(Point& out, const Point& in) {
   ec::add<Curve>(out, copy);
 }
 
+namespace {
+
+// A point in Jacobian coordinates (X, Y, Z), which represents the affine point
+// (X / Z^2, Y / Z^3). Since a = 0 for secp256k1, doubling and adding in
+// Jacobian coordinates takes fewer multiplications than the complete formulas
+// used by add and dbl. The formulas below are not complete, so the cases where
+// they fail are checked for explicitly. Jacobian points are only used inside
+// scalar multiplication, and are converted back to projective coordinates when
+// it is done.
+struct Jacobian {
+  Field x;
+  Field y;
+  Field z;
+};
+
+// The point added in each step of a scalar multiplication, with the powers of Z
+// used by the addition formula computed once.
+struct Addend {
+  Field x;
+  Field y;
+  Field z;
+  Field zz;
+  Field zzz;
+  bool affine;
+};
+
+Addend toAddend(const Point& point) {
+  // (X, Y, Z) in projective coordinates is (X * Z, Y * Z^2, Z) in Jacobian.
+  const auto& z = GET_Z(point);
+  if (z == Field::one()) {
+    return {GET_X(point), GET_Y(point), z, z, z, true};
+  }
+  const auto zz = z * z;
+  return {GET_X(point) * z, GET_Y(point) * zz, z, zz, zz * z, false};
+}
+
+Point toProjective(const Jacobian& p) {
+  // (X, Y, Z) in Jacobian coordinates is (X * Z, Y, Z^3) in projective.
+  if (p.z == Field::zero()) {
+    return POINT_AT_INFINITY;
+  }
+  return {p.x * p.z, p.y, p.z * p.z * p.z};
+}
+
+// dbl-2009-l from
+// https://hyperelliptic.org/EFD/g1p/auto-shortw-jacobian-0.html
+void dblJacobian(Jacobian& p) {
+  const auto a = p.x * p.x;
+  const auto b = p.y * p.y;
+  const auto c = b * b;
+  auto d = p.x + b;
+  d = d * d - a - c;
+  d = d + d;
+  const auto e = a + a + a;
+  const auto f = e * e;
+
+  p.z = p.y * p.z;
+  p.z = p.z + p.z;
+  p.x = f - d - d;
+  auto c8 = c + c;
+  c8 = c8 + c8;
+  c8 = c8 + c8;
+  p.y = e * (d - p.x) - c8;
+}
+
+// Add q to p. When q is affine this is the same as a mixed addition.
+void addJacobian(Jacobian& p, const Addend& q) {
+  if (p.z == Field::zero()) {
+    p = {q.x, q.y, q.z};
+    return;
+  }
+
+  const auto z1z1 = p.z * p.z;
+  const auto u1 = q.affine ? p.x : p.x * q.zz;
+  const auto s1 = q.affine ? p.y : p.y * q.zzz;
+  const auto u2 = q.x * z1z1;
+  const auto s2 = q.y * p.z * z1z1;
+  const auto h = u2 - u1;
+  const auto r = s2 - s1;
+
+  // p and q have the same x coordinate, so q is either p or -p.
+  if (h == Field::zero()) {
+    if (r == Field::zero()) {
+      dblJacobian(p);
+    } else {
+      p.z = Field::zero();
+    }
+    return;
+  }
+
+  const auto hh = h * h;
+  const auto hhh = h * hh;
+  const auto v = u1 * hh;
+  p.x = r * r - hhh - v - v;
+  p.y = r * (v - p.x) - s1 * hhh;
+  p.z = q.affine ? p.z * h : p.z * q.z * h;
+}
+
+}  // namespace
+
 template <>
 void math::ec::scalarMultiply<Curve>(Point& out, const Number& scalar) {
   if (!isPointAtInfinity<Curve>(out)) {
     const auto n = scalar.bitSize();
-    Point res;
-    setPointAtInfinity<Curve>(res);
+    const auto q = toAddend(out);
+    Jacobian res{Field::one(), Field::one(), Field::zero()};
     // equivalent to for (int i = n - 1; i >= 0; i--)
     for (auto i = n; i-- > 0;) {
-      dbl<Curve>(res);
+      dblJacobian(res);
       if (scalar.testBit(i)) {
-        ec::add<Curve>(res, out);
+        addJacobian(res, q);
       }
     }
-    out = res;
+    out = toProjective(res);
   }
 }
 
@@ -310,18 +430,21 @@ template <>
 void math::ec::scalarMultiply<Curve>(Point& out,
                                      const FF<Curve::Scalar>& scalar) {
   if (!isPointAtInfinity<Curve>(out)) {
-    Point res;
-    setPointAtInfinity<Curve>(res);
+    const auto q = toAddend(out);
+    auto q_neg = q;
+    q_neg.y.negate();
+
+    Jacobian res{Field::one(), Field::one(), Field::zero()};
     const auto naf = details::toNaf(scalar);
     for (auto i = naf.size; i-- > 0;) {
-      ec::dbl<Curve>(res);
+      dblJacobian(res);
       if (naf.values[i].pos()) {
-        ec::add<Curve>(res, out);
+        addJacobian(res, q);
       } else if (naf.values[i].neg()) {
-        ec::subtract<Curve>(res, out);
+        addJacobian(res, q_neg);
       }
     }
-    out = res;
+    out = toProjective(res);
   }
 }
 
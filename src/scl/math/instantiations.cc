@@ -0,0 +1,44 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/math/instantiations.h"
+
+#include "scl/math/ff.h"
+#include "scl/math/fields/mersenne127.h"
+#include "scl/math/fields/mersenne61.h"
+#include "scl/math/fields/secp256k1_field.h"
+#include "scl/math/fields/secp256k1_scalar.h"
+#include "scl/math/lagrange.h"
+#include "scl/math/matrix.h"
+#include "scl/math/poly.h"
+#include "scl/math/vector.h"
+#include "scl/math/z2k.h"
+
+#define SCL_DEFINE_VECTOR(T) SCL_VECTOR_INSTANCE(, T)
+SCL_BUILTIN_FIELDS(SCL_DEFINE_VECTOR)
+SCL_BUILTIN_RINGS(SCL_DEFINE_VECTOR)
+
+#define SCL_DEFINE_MATRIX(T) SCL_MATRIX_INSTANCE(, T)
+SCL_BUILTIN_FIELDS(SCL_DEFINE_MATRIX)
+SCL_BUILTIN_RINGS(SCL_DEFINE_MATRIX)
+
+#define SCL_DEFINE_POLYNOMIAL(T) SCL_POLYNOMIAL_INSTANCE(, T)
+SCL_BUILTIN_FIELDS(SCL_DEFINE_POLYNOMIAL)
+SCL_BUILTIN_RINGS(SCL_DEFINE_POLYNOMIAL)
+
+#define SCL_DEFINE_LAGRANGE(T) SCL_LAGRANGE_INSTANCE(, T)
+SCL_BUILTIN_FIELDS(SCL_DEFINE_LAGRANGE)
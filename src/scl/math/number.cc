@@ -31,12 +31,13 @@ math::Number::Number() {
   mpz_init(m_value);
 }
 
-math::Number::Number(const Number& number) : Number() {
-  mpz_set(m_value, number.m_value);
+math::Number::Number(const Number& number) {
+  mpz_init_set(m_value, number.m_value);
 }
 
+// mpz_init does not allocate, so moving only swaps the limb pointers.
 math::Number::Number(Number&& number) noexcept : Number() {
-  mpz_set(m_value, number.m_value);
+  mpz_swap(m_value, number.m_value);
 }
 
 math::Number::~Number() {
@@ -87,17 +88,80 @@ math::Number math::Number::read(const unsigned char* buf) {
   return r;
 }  // LCOV_EXCL_LINE
 
-math::Number::Number(int value) : Number() {
-  mpz_set_si(m_value, value);
+math::Number::Number(int value) {
+  mpz_init_set_si(m_value, value);
 }
 
-math::Number math::Number::operator+(const Number& number) const {
+void math::Number::reserve(std::size_t bits) {
+  mpz_realloc2(m_value, bits);
+}
+
+math::Number& math::Number::operator+=(const Number& number) {
+  mpz_add(m_value, m_value, number.m_value);
+  return *this;
+}
+
+math::Number& math::Number::operator-=(const Number& number) {
+  mpz_sub(m_value, m_value, number.m_value);
+  return *this;
+}
+
+math::Number& math::Number::operator*=(const Number& number) {
+  mpz_mul(m_value, m_value, number.m_value);
+  return *this;
+}
+
+math::Number& math::Number::operator/=(const Number& number) {
+  if (mpz_sgn(number.m_value) == 0) {
+    throw std::logic_error("division by 0");
+  }
+  mpz_div(m_value, m_value, number.m_value);
+  return *this;
+}
+
+math::Number& math::Number::operator%=(const Number& mod) {
+  mpz_mod(m_value, m_value, mod.m_value);
+  return *this;
+}
+
+math::Number& math::Number::operator<<=(int shift) {
+  if (shift < 0) {
+    return operator>>=(-shift);
+  }
+  mpz_mul_2exp(m_value, m_value, shift);
+  return *this;
+}
+
+math::Number& math::Number::operator>>=(int shift) {
+  if (shift < 0) {
+    return operator<<=(-shift);
+  }
+  mpz_tdiv_q_2exp(m_value, m_value, shift);
+  return *this;
+}
+
+math::Number& math::Number::operator^=(const Number& number) {
+  mpz_xor(m_value, m_value, number.m_value);
+  return *this;
+}
+
+math::Number& math::Number::operator|=(const Number& number) {
+  mpz_ior(m_value, m_value, number.m_value);
+  return *this;
+}
+
+math::Number& math::Number::operator&=(const Number& number) {
+  mpz_and(m_value, m_value, number.m_value);
+  return *this;
+}
+
+math::Number math::Number::operator+(const Number& number) const& {
   math::Number sum;
   mpz_add(sum.m_value, m_value, number.m_value);
   return sum;
 }  // LCOV_EXCL_LINE
 
-math::Number math::Number::operator-(const Number& number) const {
+math::Number math::Number::operator-(const Number& number) const& {
   math::Number diff;
   mpz_sub(diff.m_value, m_value, number.m_value);
   return diff;
@@ -109,7 +173,7 @@ math::Number math::Number::operator-() const {
   return neg;
 }  // LCOV_EXCL_LINE
 
-math::Number math::Number::operator*(const Number& number) const {
+math::Number math::Number::operator*(const Number& number) const& {
   math::Number prod;
   mpz_mul(prod.m_value, m_value, number.m_value);
   return prod;
@@ -124,7 +188,7 @@ math::Number math::Number::operator/(const Number& number) const {
   return frac;
 }  // LCOV_EXCL_LINE
 
-math::Number math::Number::operator%(const Number& mod) const {
+math::Number math::Number::operator%(const Number& mod) const& {
   math::Number res;
   mpz_mod(res.m_value, m_value, mod.m_value);
   return res;
@@ -178,6 +242,11 @@ int math::Number::compare(const Number& number) const {
   return mpz_cmp(m_value, number.m_value);
 }
 
+std::uint64_t math::Number::remainder(std::uint64_t divisor) const {
+  static_assert(sizeof(unsigned long) == sizeof(std::uint64_t));
+  return mpz_fdiv_ui(m_value, divisor);
+}
+
 std::size_t math::Number::byteSize() const {
   return (bitSize() - 1) / 8 + 1;
 }
@@ -222,6 +291,12 @@ math::Number math::gcd(const Number& a, const Number& b) {
   return gcd;
 }  // LCOV_EXCL_LINE
 
+math::Number math::nextPrime(const Number& n) {
+  Number prime;
+  mpz_nextprime(prime.m_value, n.m_value);
+  return prime;
+}  // LCOV_EXCL_LINE
+
 math::Number math::modInverse(const Number& val, const Number& mod) {
   if (mpz_sgn(mod.m_value) == 0) {
     throw std::invalid_argument("modulus cannot be 0");
@@ -243,3 +318,30 @@ math::Number math::modExp(const Number& base,
   mpz_powm(r.m_value, base.m_value, exp.m_value, mod.m_value);
   return r;
 }  // LCOV_EXCL_LINE
+
+void math::add(Number& out, const Number& a, const Number& b) {
+  mpz_add(out.m_value, a.m_value, b.m_value);
+}
+
+void math::subtract(Number& out, const Number& a, const Number& b) {
+  mpz_sub(out.m_value, a.m_value, b.m_value);
+}
+
+void math::multiply(Number& out, const Number& a, const Number& b) {
+  mpz_mul(out.m_value, a.m_value, b.m_value);
+}
+
+void math::mulMod(Number& out,
+                  const Number& a,
+                  const Number& b,
+                  const Number& mod) {
+  mpz_mul(out.m_value, a.m_value, b.m_value);
+  mpz_mod(out.m_value, out.m_value, mod.m_value);
+}
+
+void math::modExp(Number& out,
+                  const Number& base,
+                  const Number& exp,
+                  const Number& mod) {
+  mpz_powm(out.m_value, base.m_value, exp.m_value, mod.m_value);
+}
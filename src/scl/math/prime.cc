@@ -0,0 +1,365 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/math/prime.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "scl/util/parallel.h"
+
+using namespace scl;
+
+using Number = math::Number;
+
+namespace {
+
+// Small odd primes are used for trial division and sieving.
+constexpr std::uint32_t SMALL_PRIME_BOUND = 1 << 15;
+
+// Number of odd candidates in each sieve window.
+constexpr std::size_t WINDOW_SIZE = 4096;
+
+const std::vector<std::uint32_t>& smallPrimes() {
+  static const auto primes = [] {
+    std::vector<bool> composite(SMALL_PRIME_BOUND, false);
+    std::vector<std::uint32_t> ps;
+    for (std::uint32_t i = 3; i < SMALL_PRIME_BOUND; i += 2) {
+      if (!composite[i]) {
+        ps.emplace_back(i);
+        for (std::uint64_t j = std::uint64_t{i} * i; j < SMALL_PRIME_BOUND;
+             j += 2 * i) {
+          composite[j] = true;
+        }
+      }
+    }
+    return ps;
+  }();
+  return primes;
+}
+
+// Miller-Rabin rounds needed for an error probability below 2^-100 for a
+// random candidate of some size. FIPS 186-4, Table C.2 and C.3.
+std::size_t defaultRounds(std::size_t bits) {
+  if (bits >= 1536) {
+    return 4;
+  }
+  if (bits >= 1024) {
+    return 5;
+  }
+  if (bits >= 512) {
+    return 8;
+  }
+  if (bits >= 256) {
+    return 16;
+  }
+  return 40;
+}
+
+// Uniformly random non-negative number of at most bits bits.
+Number randomBits(std::size_t bits, util::PRG& prg) {
+  // Number::random may return fewer bits than asked for, so ask for a few
+  // more and mask.
+  const auto r = Number::random(bits + 8, prg);
+  const auto mask = (Number(1) << static_cast<int>(bits)) - Number(1);
+  return (r < Number(0) ? -r : r) & mask;
+}
+
+// Random odd number of exactly bits bits with the two top bits set.
+Number randomCandidate(std::size_t bits, util::PRG& prg) {
+  const auto top = Number(3) << static_cast<int>(bits - 2);
+  return randomBits(bits, prg) | top | Number(1);
+}
+
+// Precomputed values for Miller-Rabin testing of an odd n > 3.
+class MillerRabin {
+ public:
+  explicit MillerRabin(const Number& n)
+      : m_n(n), m_n_minus_one(n - Number(1)), m_one(1) {
+    while (!m_n_minus_one.testBit(m_s)) {
+      m_s++;
+    }
+    m_d = m_n_minus_one >> static_cast<int>(m_s);
+  }
+
+  // Run a single round with base a.
+  bool round(const Number& a) {
+    math::modExp(m_x, a, m_d, m_n);
+    if (m_x == m_one || m_x == m_n_minus_one) {
+      return true;
+    }
+    for (std::size_t i = 1; i < m_s; ++i) {
+      math::mulMod(m_x, m_x, m_x, m_n);
+      if (m_x == m_n_minus_one) {
+        return true;
+      }
+      if (m_x == m_one) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  // Run a round with a random base in [2, n - 2].
+  bool randomRound(util::PRG& prg) {
+    const auto range = m_n - Number(3);
+    const auto a = randomBits(m_n.bitSize() + 64, prg) % range + Number(2);
+    return round(a);
+  }
+
+ private:
+  const Number& m_n;
+  Number m_n_minus_one;
+  Number m_one;
+  Number m_d;
+  Number m_x;
+  std::size_t m_s = 0;
+};
+
+// Miller-Rabin test without trial division, for candidates that passed the
+// sieve. The first round uses base 2 since it is the cheapest.
+bool millerRabin(const Number& n,
+                 util::PRG& prg,
+                 std::size_t rounds,
+                 const std::atomic<bool>& stop) {
+  MillerRabin mr(n);
+  if (!mr.round(Number(2))) {
+    return false;
+  }
+  for (std::size_t i = 1; i < rounds; ++i) {
+    if (stop.load(std::memory_order_relaxed) || !mr.randomRound(prg)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Fermat test with base 2. Used to quickly reject 2q + 1 when generating safe
+// primes.
+bool fermat(const Number& n) {
+  Number x;
+  math::modExp(x, Number(2), n - Number(1), n);
+  return x == Number(1);
+}
+
+// Search for a prime (or safe prime) of some size. Returns nothing if stop is
+// set by another thread before a prime is found.
+std::optional<Number> search(std::size_t bits,
+                             bool safe,
+                             util::PRG& prg,
+                             const std::atomic<bool>& stop) {
+  const auto& primes = smallPrimes();
+  const auto candidate_bits = safe ? bits - 1 : bits;
+  const auto rounds = defaultRounds(bits);
+
+  std::vector<std::uint32_t> residues(primes.size());
+  std::vector<bool> composite(WINDOW_SIZE);
+
+  while (!stop.load(std::memory_order_relaxed)) {
+    auto base = randomCandidate(candidate_bits, prg);
+    for (std::size_t i = 0; i < primes.size(); ++i) {
+      residues[i] = base.remainder(primes[i]);
+    }
+
+    while (base.bitSize() == candidate_bits) {
+      // candidate k of this window is base + 2k. It is divisible by a small
+      // prime p when 2k = -r mod p where r = base mod p. For safe primes,
+      // 2(base + 2k) + 1 must also not be divisible by p, i.e., 4k != -(2r +
+      // 1) mod p.
+      std::fill(composite.begin(), composite.end(), false);
+      for (std::size_t i = 0; i < primes.size(); ++i) {
+        const std::uint64_t p = primes[i];
+        const std::uint64_t r = residues[i];
+        const std::uint64_t inv2 = (p + 1) / 2;
+        for (auto k = ((p - r) % p) * inv2 % p; k < WINDOW_SIZE; k += p) {
+          composite[k] = true;
+        }
+        if (safe) {
+          const auto inv4 = inv2 * inv2 % p;
+          const auto t = (p - (2 * r + 1) % p) % p;
+          for (auto k = t * inv4 % p; k < WINDOW_SIZE; k += p) {
+            composite[k] = true;
+          }
+        }
+      }
+
+      for (std::size_t k = 0; k < WINDOW_SIZE; ++k) {
+        if (composite[k]) {
+          continue;
+        }
+        if (stop.load(std::memory_order_relaxed)) {
+          return std::nullopt;
+        }
+
+        const auto c = base + Number(static_cast<int>(2 * k));
+        if (c.bitSize() != candidate_bits) {
+          break;
+        }
+
+        if (!safe) {
+          if (millerRabin(c, prg, rounds, stop)) {
+            return c;
+          }
+          continue;
+        }
+
+        // q must pass a base 2 round before p = 2q + 1 is looked at.
+        if (!MillerRabin(c).round(Number(2))) {
+          continue;
+        }
+        const auto p = (c << 1) + Number(1);
+        if (fermat(p) && millerRabin(c, prg, rounds, stop) &&
+            millerRabin(p, prg, rounds, stop)) {
+          return p;
+        }
+      }
+
+      base += Number(static_cast<int>(2 * WINDOW_SIZE));
+      for (std::size_t i = 0; i < primes.size(); ++i) {
+        residues[i] = (residues[i] + 2 * WINDOW_SIZE) % primes[i];
+      }
+    }
+  }
+
+  return std::nullopt;
+}
+
+Number findPrime(std::size_t bits,
+                 bool safe,
+                 util::PRG& prg,
+                 std::size_t threads) {
+  if (bits < 32) {
+    throw std::invalid_argument("primes must be at least 32 bits");
+  }
+
+  if (threads == 0) {
+    threads = util::ThreadPool::global().workers() + 1;
+  }
+
+  std::atomic<bool> stop{false};
+  if (threads == 1) {
+    return *search(bits, safe, prg, stop);
+  }
+
+  std::vector<util::PRG> prgs;
+  prgs.reserve(threads);
+  for (std::size_t t = 0; t < threads; ++t) {
+    prgs.emplace_back(prg.fork());
+  }
+
+  // Each search runs until some search finds a prime, so a search that throws
+  // must stop the others before the pool can rethrow its exception.
+  std::optional<Number> result;
+  std::mutex mutex;
+  util::ThreadPool::global().run(threads, [&](std::size_t t) {
+    std::optional<Number> prime;
+    try {
+      prime = search(bits, safe, prgs[t], stop);
+    } catch (...) {
+      stop.store(true, std::memory_order_relaxed);
+      throw;
+    }
+    if (prime.has_value()) {
+      std::scoped_lock lock(mutex);
+      if (!result.has_value()) {
+        result = std::move(prime);
+      }
+      stop.store(true, std::memory_order_relaxed);
+    }
+  });
+
+  return std::move(*result);
+}
+
+}  // namespace
+
+bool math::isProbablePrime(const Number& n,
+                           util::PRG& prg,
+                           std::size_t rounds) {
+  if (n < Number(2)) {
+    return false;
+  }
+  if (n.even()) {
+    return n == Number(2);
+  }
+
+  for (const auto p : smallPrimes()) {
+    if (n.remainder(p) == 0) {
+      return n == Number(static_cast<int>(p));
+    }
+  }
+
+  // no factors below SMALL_PRIME_BOUND, so n is prime if it is smaller than
+  // SMALL_PRIME_BOUND squared.
+  if (n < Number(static_cast<int>(SMALL_PRIME_BOUND)) *
+              Number(static_cast<int>(SMALL_PRIME_BOUND))) {
+    return true;
+  }
+
+  if (rounds == 0) {
+    rounds = defaultRounds(n.bitSize());
+  }
+
+  const std::atomic<bool> stop{false};
+  return millerRabin(n, prg, rounds, stop);
+}
+
+Number math::generatePrime(std::size_t bits,
+                           util::PRG& prg,
+                           std::size_t threads) {
+  return findPrime(bits, false, prg, threads);
+}
+
+Number math::generateSafePrime(std::size_t bits,
+                               util::PRG& prg,
+                               std::size_t threads) {
+  return findPrime(bits, true, prg, threads);
+}
+
+math::RSAModulus math::generateRSAModulus(std::size_t bits,
+                                          util::PRG& prg,
+                                          std::size_t threads) {
+  if (bits < 64) {
+    throw std::invalid_argument("RSA modulus must be at least 64 bits");
+  }
+
+  const auto p_bits = bits / 2;
+  const auto q_bits = bits - p_bits;
+
+  // p and q should not be too close, since n can then be factored with Fermat's
+  // method (FIPS 186-4, Appendix B.3.1).
+  const auto min_distance =
+      p_bits > 100 ? Number(1) << static_cast<int>(p_bits - 100) : Number(0);
+
+  auto p = generatePrime(p_bits, prg, threads);
+  auto q = generatePrime(q_bits, prg, threads);
+  while (true) {
+    const auto distance = p > q ? p - q : q - p;
+    if (distance > min_distance) {
+      break;
+    }
+    q = generatePrime(q_bits, prg, threads);
+  }
+
+  auto n = p * q;
+  return {std::move(n), std::move(p), std::move(q)};
+}
@@ -0,0 +1,108 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/ot/base_ot.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "scl/coro/coroutine.h"
+#include "scl/net/packet.h"
+#include "scl/util/hash.h"
+
+using namespace scl;
+
+namespace {
+
+using Curve = ot::BaseOT::Curve;
+using Scalar = Curve::ScalarField;
+
+// Key of the index'th OT, derived from the sender's message s, the receiver's
+// message r and the shared point k.
+ot::Block deriveKey(std::size_t index,
+                    const Curve& s,
+                    const Curve& r,
+                    const Curve& k) {
+  util::Hash<256> hash;
+  hash.update(index).update(s).update(r).update(k);
+  const auto digest = hash.finalize();
+
+  ot::Block key;
+  std::copy(digest.begin(), digest.begin() + key.size(), key.begin());
+  return key;
+}
+
+}  // namespace
+
+coro::Task<std::vector<std::array<ot::Block, 2>>> ot::BaseOT::send(
+    net::Channel& channel,
+    std::size_t n,
+    util::PRG& prg) {
+  // the sender sends S = yG.
+  const auto y = Scalar::random(prg);
+  const auto s = Curve::generator() * y;
+  net::Packet packet;
+  packet << s;
+  co_await channel.send(std::move(packet));
+
+  // the receiver replies with R = cS + xG for each OT. The keys are then
+  // derived from yR and y(R - S), one of which is equal to xS.
+  auto reply = co_await channel.recv();
+  const auto rs = reply.read<std::vector<Curve>>();
+  if (rs.size() != n) {
+    throw std::runtime_error("unexpected number of base OTs");
+  }
+
+  const auto t = s * y;
+  std::vector<std::array<Block, 2>> keys;
+  keys.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto k = rs[i] * y;
+    keys.push_back({deriveKey(i, s, rs[i], k), deriveKey(i, s, rs[i], k - t)});
+  }
+
+  co_return keys;
+}
+
+coro::Task<std::vector<ot::Block>> ot::BaseOT::receive(
+    net::Channel& channel,
+    const util::Bitmap& choices,
+    util::PRG& prg) {
+  auto packet = co_await channel.recv();
+  const auto s = packet.read<Curve>();
+
+  const auto n = choices.size();
+  std::vector<Curve> rs;
+  rs.reserve(n);
+  std::vector<Block> keys;
+  keys.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto x = Scalar::random(prg);
+    auto r = Curve::generator() * x;
+    if (choices.at(i)) {
+      r += s;
+    }
+    keys.emplace_back(deriveKey(i, s, r, s * x));
+    rs.emplace_back(r);
+  }
+
+  net::Packet reply;
+  reply << rs;
+  co_await channel.send(std::move(reply));
+
+  co_return keys;
+}
@@ -0,0 +1,285 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/ot/iknp.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <emmintrin.h>
+
+#include "scl/coro/coroutine.h"
+#include "scl/util/aes.h"
+#include "scl/util/transpose.h"
+
+using namespace scl;
+
+namespace {
+
+// Computational security parameter, and the number of base OTs.
+constexpr std::size_t KAPPA = 128;
+
+// Number of OTs processed at a time. The 128 x CHUNK bit matrix is 64 KiB.
+constexpr std::size_t CHUNK = 4096;
+
+std::size_t roundUp(std::size_t n) {
+  return (n + KAPPA - 1) / KAPPA * KAPPA;
+}
+
+bool testBit(const ot::Block& block, std::size_t i) {
+  return ((block[i / 8] >> (i % 8)) & 1) == 1;
+}
+
+__m128i* asBlocks(void* p) {
+  return static_cast<__m128i*>(p);
+}
+
+// dst[i] = a[i] ^ b[i] for n bytes, where n is a multiple of 16.
+void xorBytes(unsigned char* dst,
+              const unsigned char* a,
+              const unsigned char* b,
+              std::size_t n) {
+  for (std::size_t i = 0; i < n; i += 16) {
+    const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const auto y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(x, y));
+  }
+}
+
+const util::AES& fixedKeyAES() {
+  static const unsigned char key[util::AES::keySize()] = {
+      0x61, 0x7e, 0x8d, 0xa2, 0xa0, 0x51, 0x1e, 0x96,
+      0x5e, 0x41, 0xc2, 0x9b, 0x15, 0x3f, 0xc7, 0x7a};
+  static const util::AES aes(key);
+  return aes;
+}
+
+// out[j] = H(tweak + j, in[j]) where H(i, x) = pi(pi(x) ^ i) ^ pi(x) is the
+// tweakable correlation robust hash by Guo et al., and pi is fixed-key AES.
+// tmp must have room for n blocks. out may be equal to in.
+void hash(const __m128i* in,
+          __m128i* out,
+          __m128i* tmp,
+          std::size_t n,
+          std::uint64_t tweak) {
+  const auto& aes = fixedKeyAES();
+  aes.encrypt(in, tmp, n);
+  for (std::size_t j = 0; j < n; ++j) {
+    const auto i = _mm_set_epi64x(0, static_cast<long>(tweak + j));
+    _mm_storeu_si128(out + j, _mm_xor_si128(_mm_loadu_si128(tmp + j), i));
+  }
+  aes.encrypt(out, out, n);
+  for (std::size_t j = 0; j < n; ++j) {
+    const auto x = _mm_loadu_si128(out + j);
+    _mm_storeu_si128(out + j, _mm_xor_si128(x, _mm_loadu_si128(tmp + j)));
+  }
+}
+
+}  // namespace
+
+void ot::details::expand(const Block& key, unsigned char* out, std::size_t n) {
+  const auto nblocks = (n + sizeof(Block) - 1) / sizeof(Block);
+  std::vector<Block> blocks(nblocks, key);
+  std::vector<Block> tmp(nblocks);
+  hash(asBlocks(blocks.data()),
+       asBlocks(blocks.data()),
+       asBlocks(tmp.data()),
+       nblocks,
+       0);
+  std::memcpy(out, blocks.data(), n);
+}
+
+coro::Task<void> ot::IknpSender::setup(net::Channel& channel,
+                                       util::PRG& prg) {
+  prg.next(m_delta.data(), m_delta.size());
+  util::Bitmap choices(KAPPA);
+  for (std::size_t i = 0; i < KAPPA; ++i) {
+    choices.set(i, testBit(m_delta, i));
+  }
+
+  const auto seeds = co_await BaseOT::receive(channel, choices, prg);
+
+  m_prgs.clear();
+  for (const auto& seed : seeds) {
+    m_prgs.emplace_back(util::PRG::create(seed.data(), seed.size()));
+  }
+  m_counter = 0;
+}
+
+coro::Task<std::vector<std::array<ot::Block, 2>>> ot::IknpSender::sendRandom(
+    net::Channel& channel,
+    std::size_t n) {
+  if (m_prgs.empty()) {
+    throw std::logic_error("OT extension has not been set up");
+  }
+
+  const auto m = roundUp(n);
+  auto packet = co_await channel.recv();
+  const auto u = packet.read<std::vector<unsigned char>>();
+  if (u.size() != KAPPA * m / 8) {
+    throw std::runtime_error("unexpected size of OT extension message");
+  }
+
+  const auto delta = _mm_loadu_si128(asBlocks(m_delta.data()));
+  std::vector<unsigned char> q(KAPPA * CHUNK / 8);
+  std::vector<Block> q0(CHUNK);
+  std::vector<Block> q1(CHUNK);
+  std::vector<Block> tmp(CHUNK);
+  std::vector<std::array<Block, 2>> keys(m);
+
+  for (std::size_t c = 0; c < m; c += CHUNK) {
+    const auto mc = std::min(CHUNK, m - c);
+    const auto bytes = mc / 8;
+    const auto* uc = u.data() + KAPPA * c / 8;
+
+    // q_i = G(k_i) ^ delta_i * u_i = t_i ^ delta_i * r.
+    for (std::size_t i = 0; i < KAPPA; ++i) {
+      auto* qi = q.data() + i * bytes;
+      m_prgs[i].next(qi, bytes);
+      if (testBit(m_delta, i)) {
+        xorBytes(qi, qi, uc + i * bytes, bytes);
+      }
+    }
+
+    // after transposing, q_j = t_j ^ r_j * delta.
+    util::transposeBits(q.data(),
+                        bytes,
+                        q0.front().data(),
+                        sizeof(Block),
+                        KAPPA,
+                        mc);
+    auto* b0 = asBlocks(q0.data());
+    auto* b1 = asBlocks(q1.data());
+    for (std::size_t j = 0; j < mc; ++j) {
+      _mm_storeu_si128(b1 + j, _mm_xor_si128(_mm_loadu_si128(b0 + j), delta));
+    }
+
+    hash(b0, b0, asBlocks(tmp.data()), mc, m_counter + c);
+    hash(b1, b1, asBlocks(tmp.data()), mc, m_counter + c);
+    for (std::size_t j = 0; j < mc; ++j) {
+      keys[c + j] = {q0[j], q1[j]};
+    }
+  }
+
+  m_counter += m;
+  keys.resize(n);
+  co_return keys;
+}
+
+coro::Task<void> ot::IknpSender::sendChosen(
+    net::Channel& channel,
+    const std::vector<std::array<Block, 2>>& messages) {
+  const auto n = messages.size();
+  const auto keys = co_await sendRandom(channel, n);
+
+  std::vector<unsigned char> y(n * 2 * sizeof(Block));
+  xorBytes(y.data(),
+           reinterpret_cast<const unsigned char*>(messages.data()),
+           reinterpret_cast<const unsigned char*>(keys.data()),
+           y.size());
+
+  net::Packet packet;
+  packet << y;
+  co_await channel.send(std::move(packet));
+}
+
+coro::Task<void> ot::IknpReceiver::setup(net::Channel& channel,
+                                         util::PRG& prg) {
+  const auto seeds = co_await BaseOT::send(channel, KAPPA, prg);
+
+  m_prgs0.clear();
+  m_prgs1.clear();
+  for (const auto& seed : seeds) {
+    m_prgs0.emplace_back(util::PRG::create(seed[0].data(), seed[0].size()));
+    m_prgs1.emplace_back(util::PRG::create(seed[1].data(), seed[1].size()));
+  }
+  m_counter = 0;
+}
+
+coro::Task<std::vector<ot::Block>> ot::IknpReceiver::receiveRandom(
+    net::Channel& channel,
+    const util::Bitmap& choices) {
+  if (m_prgs0.empty()) {
+    throw std::logic_error("OT extension has not been set up");
+  }
+
+  const auto n = choices.size();
+  const auto m = roundUp(n);
+
+  // the choice bits, padded with zeros to m bits.
+  std::vector<unsigned char> r(m / 8, 0);
+  std::memcpy(r.data(), choices.data(), (n + 7) / 8);
+
+  std::vector<unsigned char> u(KAPPA * m / 8);
+  std::vector<unsigned char> t(KAPPA * CHUNK / 8);
+  std::vector<unsigned char> g(CHUNK / 8);
+  std::vector<Block> tmp(CHUNK);
+  std::vector<Block> keys(m);
+
+  for (std::size_t c = 0; c < m; c += CHUNK) {
+    const auto mc = std::min(CHUNK, m - c);
+    const auto bytes = mc / 8;
+    auto* uc = u.data() + KAPPA * c / 8;
+
+    // t_i = G(k_i^0) and u_i = t_i ^ G(k_i^1) ^ r.
+    for (std::size_t i = 0; i < KAPPA; ++i) {
+      auto* ti = t.data() + i * bytes;
+      auto* ui = uc + i * bytes;
+      m_prgs0[i].next(ti, bytes);
+      m_prgs1[i].next(g.data(), bytes);
+      xorBytes(ui, ti, g.data(), bytes);
+      xorBytes(ui, ui, r.data() + c / 8, bytes);
+    }
+
+    auto* kc = asBlocks(keys.data() + c);
+    util::transposeBits(t.data(),
+                        bytes,
+                        keys[c].data(),
+                        sizeof(Block),
+                        KAPPA,
+                        mc);
+    hash(kc, kc, asBlocks(tmp.data()), mc, m_counter + c);
+  }
+
+  net::Packet packet;
+  packet << u;
+  co_await channel.send(std::move(packet));
+
+  m_counter += m;
+  keys.resize(n);
+  co_return keys;
+}
+
+coro::Task<std::vector<ot::Block>> ot::IknpReceiver::receiveChosen(
+    net::Channel& channel,
+    const util::Bitmap& choices) {
+  const auto n = choices.size();
+  auto keys = co_await receiveRandom(channel, choices);
+
+  auto packet = co_await channel.recv();
+  const auto y = packet.read<std::vector<unsigned char>>();
+  if (y.size() != n * 2 * sizeof(Block)) {
+    throw std::runtime_error("unexpected size of chosen OT message");
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto* yi = y.data() + (2 * i + choices.at(i)) * sizeof(Block);
+    xorBytes(keys[i].data(), keys[i].data(), yi, sizeof(Block));
+  }
+
+  co_return keys;
+}
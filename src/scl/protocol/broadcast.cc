@@ -0,0 +1,107 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/protocol/broadcast.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "scl/coro/coroutine.h"
+#include "scl/util/digest.h"
+
+using namespace scl;
+
+using Digest = proto::BroadcastChecker::Hash::DigestType;
+
+void proto::BroadcastChecker::record(std::size_t sender,
+                                     const unsigned char* data,
+                                     std::size_t size) {
+  auto& transcript = m_transcripts.at(sender);
+  const auto length = static_cast<std::uint64_t>(size);
+  unsigned char prefix[sizeof(length)];
+  std::memcpy(prefix, &length, sizeof(length));
+  transcript.update(prefix, sizeof(prefix));
+  transcript.update(data, size);
+  m_pending++;
+}
+
+coro::Task<void> proto::BroadcastChecker::broadcast(
+    net::Network& network,
+    const net::Packet& packet) {
+  for (std::size_t i = 0; i < network.size(); ++i) {
+    if (i != network.myId()) {
+      co_await network.party(i)->send(packet);
+    }
+  }
+  record(network.myId(), packet);
+}
+
+coro::Task<net::Packet> proto::BroadcastChecker::recv(net::Network& network,
+                                                      std::size_t sender) {
+  net::Packet packet = co_await network.party(sender)->recv();
+  record(sender, packet);
+  co_return packet;
+}
+
+coro::Task<void> proto::BroadcastChecker::check(net::Network& network) {
+  if (network.size() != m_transcripts.size()) {
+    throw std::invalid_argument("network has the wrong number of parties");
+  }
+
+  std::vector<Digest> digests;
+  digests.reserve(m_transcripts.size());
+  net::Packet packet(m_transcripts.size() * sizeof(Digest));
+  for (auto& transcript : m_transcripts) {
+    digests.emplace_back(transcript.finalize());
+    packet << digests.back();
+    transcript = Hash{};
+  }
+  m_pending = 0;
+
+  for (std::size_t i = 0; i < network.size(); ++i) {
+    if (i != network.myId()) {
+      co_await network.party(i)->send(packet);
+    }
+  }
+
+  // all digests are received before comparing, so that an inconsistency does
+  // not leave messages on the channels.
+  std::vector<net::Packet> received(network.size());
+  for (std::size_t i = 0; i < network.size(); ++i) {
+    if (i != network.myId()) {
+      received[i] = co_await network.party(i)->recv();
+    }
+  }
+
+  for (std::size_t i = 0; i < network.size(); ++i) {
+    if (i == network.myId()) {
+      continue;
+    }
+    if (received[i].remaining() != packet.size()) {
+      throw std::runtime_error("unexpected size of digests from party " +
+                               std::to_string(i));
+    }
+    for (std::size_t j = 0; j < digests.size(); ++j) {
+      if (received[i].read<Digest>() != digests[j]) {
+        throw std::runtime_error("inconsistent broadcast from party " +
+                                 std::to_string(j));
+      }
+    }
+  }
+}
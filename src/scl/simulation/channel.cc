@@ -69,8 +69,11 @@ coro::Task<net::Packet> sim::details::SimulatedChannel::recv() {
 
   m_context.recvStart(m_cid.remote);
 
-  // block until there is data available on the transport.
-  co_await [tp = m_transport, cid = m_cid]() { return tp->hasData(cid); };
+  // block until there is data available on the transport. The transport is
+  // captured by raw pointer since it is owned by this channel, and since GCC
+  // may destroy temporaries in a co_await expression more than once, which
+  // would drop the reference count of a captured shared_ptr.
+  co_await [tp = m_transport.get(), cid = m_cid]() { return tp->hasData(cid); };
 
   auto packet = m_transport->recv(m_cid);
 
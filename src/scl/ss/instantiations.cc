@@ -0,0 +1,32 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/math/instantiations.h"
+
+#include "scl/math/ff.h"
+#include "scl/math/fields/mersenne127.h"
+#include "scl/math/fields/mersenne61.h"
+#include "scl/math/fields/secp256k1_field.h"
+#include "scl/math/fields/secp256k1_scalar.h"
+#include "scl/ss/additive.h"
+#include "scl/ss/shamir.h"
+
+#define SCL_DEFINE_SHAMIR(T) SCL_SHAMIR_INSTANCE(, T)
+SCL_BUILTIN_FIELDS(SCL_DEFINE_SHAMIR)
+
+#define SCL_DEFINE_ADDITIVE(T) SCL_ADDITIVE_INSTANCE(, T)
+SCL_BUILTIN_FIELDS(SCL_DEFINE_ADDITIVE)
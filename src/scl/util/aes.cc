@@ -0,0 +1,369 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/util/aes.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <immintrin.h>
+
+#include "scl/util/cpu.h"
+
+/**
+ * AES-128 implementation with code from
+ * https://github.com/sebastien-riou/aes-brute-force
+ *
+ * The AES-NI and VAES code is compiled for those extensions only, and is picked
+ * at runtime if the CPU supports it. Otherwise a (slow) software implementation
+ * of AES is used.
+ */
+
+#define BLOCK_SIZE sizeof(__m128i)
+
+#define AES_128_KEY_EXP(k, rcon) \
+  aes128KeyExpansion(k, _mm_aeskeygenassist_si128(k, rcon))
+
+#define AESNI __attribute__((target("aes")))
+#define VAES __attribute__((target("aes,avx2,vaes")))
+
+namespace {
+
+// number of blocks encrypted in parallel by the AES-NI and VAES code.
+constexpr std::size_t PARALLEL_BLOCKS = 8;
+
+auto createMask(long nonce, long counter) {
+  return _mm_set_epi64x(nonce, counter);
+}
+
+AESNI auto aes128KeyExpansion(__m128i key, __m128i keygened) {
+  keygened = _mm_shuffle_epi32(keygened, _MM_SHUFFLE(3, 3, 3, 3));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, keygened);
+}
+
+AESNI void aes128LoadKey(const unsigned char* enc_key, __m128i* key_schedule) {
+  const auto* k = reinterpret_cast<const __m128i*>(enc_key);
+  key_schedule[0] = _mm_loadu_si128(k);
+  key_schedule[1] = AES_128_KEY_EXP(key_schedule[0], 0x01);
+  key_schedule[2] = AES_128_KEY_EXP(key_schedule[1], 0x02);
+  key_schedule[3] = AES_128_KEY_EXP(key_schedule[2], 0x04);
+  key_schedule[4] = AES_128_KEY_EXP(key_schedule[3], 0x08);
+  key_schedule[5] = AES_128_KEY_EXP(key_schedule[4], 0x10);
+  key_schedule[6] = AES_128_KEY_EXP(key_schedule[5], 0x20);
+  key_schedule[7] = AES_128_KEY_EXP(key_schedule[6], 0x40);
+  key_schedule[8] = AES_128_KEY_EXP(key_schedule[7], 0x80);
+  key_schedule[9] = AES_128_KEY_EXP(key_schedule[8], 0x1B);
+  key_schedule[10] = AES_128_KEY_EXP(key_schedule[9], 0x36);
+}
+
+AESNI void aes128Ctr(const __m128i* key_schedule,
+                     long nonce,
+                     long counter,
+                     std::size_t nblocks,
+                     unsigned char* out) {
+  auto* p = reinterpret_cast<__m128i*>(out);
+  std::size_t i = 0;
+
+  // encrypt several blocks at a time to hide the latency of aesenc.
+  for (; i + PARALLEL_BLOCKS <= nblocks; i += PARALLEL_BLOCKS) {
+    __m128i m[PARALLEL_BLOCKS];
+    for (std::size_t j = 0; j < PARALLEL_BLOCKS; ++j) {
+      m[j] = _mm_xor_si128(createMask(nonce, counter + i + j),
+                           key_schedule[0]);
+    }
+    for (std::size_t r = 1; r < 10; ++r) {
+      for (std::size_t j = 0; j < PARALLEL_BLOCKS; ++j) {
+        m[j] = _mm_aesenc_si128(m[j], key_schedule[r]);
+      }
+    }
+    for (std::size_t j = 0; j < PARALLEL_BLOCKS; ++j) {
+      m[j] = _mm_aesenclast_si128(m[j], key_schedule[10]);
+      _mm_storeu_si128(p + i + j, m[j]);
+    }
+  }
+
+  for (; i < nblocks; ++i) {
+    auto m = _mm_xor_si128(createMask(nonce, counter + i), key_schedule[0]);
+    for (std::size_t r = 1; r < 10; ++r) {
+      m = _mm_aesenc_si128(m, key_schedule[r]);
+    }
+    m = _mm_aesenclast_si128(m, key_schedule[10]);
+    _mm_storeu_si128(p + i, m);
+  }
+}
+
+AESNI void aes128Encrypt(const __m128i* key_schedule,
+                         const __m128i* in,
+                         __m128i* out,
+                         std::size_t nblocks) {
+  std::size_t i = 0;
+  for (; i + PARALLEL_BLOCKS <= nblocks; i += PARALLEL_BLOCKS) {
+    __m128i m[PARALLEL_BLOCKS];
+    for (std::size_t j = 0; j < PARALLEL_BLOCKS; ++j) {
+      m[j] = _mm_xor_si128(_mm_loadu_si128(in + i + j), key_schedule[0]);
+    }
+    for (std::size_t r = 1; r < 10; ++r) {
+      for (std::size_t j = 0; j < PARALLEL_BLOCKS; ++j) {
+        m[j] = _mm_aesenc_si128(m[j], key_schedule[r]);
+      }
+    }
+    for (std::size_t j = 0; j < PARALLEL_BLOCKS; ++j) {
+      m[j] = _mm_aesenclast_si128(m[j], key_schedule[10]);
+      _mm_storeu_si128(out + i + j, m[j]);
+    }
+  }
+
+  for (; i < nblocks; ++i) {
+    auto m = _mm_xor_si128(_mm_loadu_si128(in + i), key_schedule[0]);
+    for (std::size_t r = 1; r < 10; ++r) {
+      m = _mm_aesenc_si128(m, key_schedule[r]);
+    }
+    m = _mm_aesenclast_si128(m, key_schedule[10]);
+    _mm_storeu_si128(out + i, m);
+  }
+}
+
+VAES void aes128CtrVaes(const __m128i* key_schedule,
+                        long nonce,
+                        long counter,
+                        std::size_t nblocks,
+                        unsigned char* out) {
+  constexpr std::size_t lanes = PARALLEL_BLOCKS / 2;
+
+  __m256i ks[11];
+  for (std::size_t r = 0; r < 11; ++r) {
+    ks[r] = _mm256_broadcastsi128_si256(key_schedule[r]);
+  }
+
+  auto* p = reinterpret_cast<__m256i*>(out);
+  std::size_t i = 0;
+  for (; i + PARALLEL_BLOCKS <= nblocks; i += PARALLEL_BLOCKS) {
+    __m256i m[lanes];
+    for (std::size_t j = 0; j < lanes; ++j) {
+      const long c = counter + i + 2 * j;
+      m[j] = _mm256_set_epi64x(nonce, c + 1, nonce, c);
+      m[j] = _mm256_xor_si256(m[j], ks[0]);
+    }
+    for (std::size_t r = 1; r < 10; ++r) {
+      for (std::size_t j = 0; j < lanes; ++j) {
+        m[j] = _mm256_aesenc_epi128(m[j], ks[r]);
+      }
+    }
+    for (std::size_t j = 0; j < lanes; ++j) {
+      m[j] = _mm256_aesenclast_epi128(m[j], ks[10]);
+      _mm256_storeu_si256(p + i / 2 + j, m[j]);
+    }
+  }
+
+  if (i < nblocks) {
+    aes128Ctr(key_schedule,
+              nonce,
+              counter + i,
+              nblocks - i,
+              out + i * BLOCK_SIZE);
+  }
+}
+
+VAES void aes128EncryptVaes(const __m128i* key_schedule,
+                            const __m128i* in,
+                            __m128i* out,
+                            std::size_t nblocks) {
+  constexpr std::size_t lanes = PARALLEL_BLOCKS / 2;
+
+  __m256i ks[11];
+  for (std::size_t r = 0; r < 11; ++r) {
+    ks[r] = _mm256_broadcastsi128_si256(key_schedule[r]);
+  }
+
+  const auto* p_in = reinterpret_cast<const __m256i*>(in);
+  auto* p_out = reinterpret_cast<__m256i*>(out);
+  std::size_t i = 0;
+  for (; i + PARALLEL_BLOCKS <= nblocks; i += PARALLEL_BLOCKS) {
+    __m256i m[lanes];
+    for (std::size_t j = 0; j < lanes; ++j) {
+      m[j] = _mm256_xor_si256(_mm256_loadu_si256(p_in + i / 2 + j), ks[0]);
+    }
+    for (std::size_t r = 1; r < 10; ++r) {
+      for (std::size_t j = 0; j < lanes; ++j) {
+        m[j] = _mm256_aesenc_epi128(m[j], ks[r]);
+      }
+    }
+    for (std::size_t j = 0; j < lanes; ++j) {
+      m[j] = _mm256_aesenclast_epi128(m[j], ks[10]);
+      _mm256_storeu_si256(p_out + i / 2 + j, m[j]);
+    }
+  }
+
+  if (i < nblocks) {
+    aes128Encrypt(key_schedule, in + i, out + i, nblocks - i);
+  }
+}
+
+// Software AES, used when AES-NI is not available.
+
+constexpr std::array<unsigned char, 256> SBOX = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b,
+    0xfe, 0xd7, 0xab, 0x76, 0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0,
+    0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0, 0xb7, 0xfd, 0x93, 0x26,
+    0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2,
+    0xeb, 0x27, 0xb2, 0x75, 0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0,
+    0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84, 0x53, 0xd1, 0x00, 0xed,
+    0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f,
+    0x50, 0x3c, 0x9f, 0xa8, 0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5,
+    0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2, 0xcd, 0x0c, 0x13, 0xec,
+    0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14,
+    0xde, 0x5e, 0x0b, 0xdb, 0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c,
+    0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79, 0xe7, 0xc8, 0x37, 0x6d,
+    0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f,
+    0x4b, 0xbd, 0x8b, 0x8a, 0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e,
+    0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e, 0xe1, 0xf8, 0x98, 0x11,
+    0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f,
+    0xb0, 0x54, 0xbb, 0x16};
+
+unsigned char xtime(unsigned char x) {
+  return (x << 1) ^ ((x >> 7) * 0x1B);
+}
+
+void softLoadKey(const unsigned char* enc_key, __m128i* key_schedule) {
+  unsigned char rk[11 * BLOCK_SIZE];
+  std::copy(enc_key, enc_key + BLOCK_SIZE, rk);
+
+  unsigned char rcon = 0x01;
+  for (std::size_t i = BLOCK_SIZE; i < sizeof(rk); i += 4) {
+    unsigned char t[4] = {rk[i - 4], rk[i - 3], rk[i - 2], rk[i - 1]};
+    if (i % BLOCK_SIZE == 0) {
+      const unsigned char t0 = t[0];
+      t[0] = SBOX[t[1]] ^ rcon;
+      t[1] = SBOX[t[2]];
+      t[2] = SBOX[t[3]];
+      t[3] = SBOX[t0];
+      rcon = xtime(rcon);
+    }
+    for (std::size_t j = 0; j < 4; ++j) {
+      rk[i + j] = rk[i + j - BLOCK_SIZE] ^ t[j];
+    }
+  }
+
+  std::memcpy(key_schedule, rk, sizeof(rk));
+}
+
+void softEncryptBlock(const unsigned char* rk, unsigned char* s) {
+  for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+    s[i] ^= rk[i];
+  }
+
+  for (std::size_t r = 1; r <= 10; ++r) {
+    // SubBytes and ShiftRows. The state is stored column by column.
+    unsigned char t[BLOCK_SIZE];
+    for (std::size_t c = 0; c < 4; ++c) {
+      for (std::size_t row = 0; row < 4; ++row) {
+        t[c * 4 + row] = SBOX[s[((c + row) % 4) * 4 + row]];
+      }
+    }
+
+    // MixColumns, except in the last round.
+    if (r < 10) {
+      for (std::size_t c = 0; c < 4; ++c) {
+        unsigned char* a = t + c * 4;
+        const unsigned char a0 = a[0];
+        const unsigned char all = a[0] ^ a[1] ^ a[2] ^ a[3];
+        a[0] ^= all ^ xtime(a[0] ^ a[1]);
+        a[1] ^= all ^ xtime(a[1] ^ a[2]);
+        a[2] ^= all ^ xtime(a[2] ^ a[3]);
+        a[3] ^= all ^ xtime(a[3] ^ a0);
+      }
+    }
+
+    for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+      s[i] = t[i] ^ rk[r * BLOCK_SIZE + i];
+    }
+  }
+}
+
+void softCtr(const __m128i* key_schedule,
+             long nonce,
+             long counter,
+             std::size_t nblocks,
+             unsigned char* out) {
+  const auto* rk = reinterpret_cast<const unsigned char*>(key_schedule);
+  for (std::size_t i = 0; i < nblocks; ++i) {
+    auto* block = out + i * BLOCK_SIZE;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(block),
+                     createMask(nonce, counter + i));
+    softEncryptBlock(rk, block);
+  }
+}
+
+void softEncrypt(const __m128i* key_schedule,
+                 const __m128i* in,
+                 __m128i* out,
+                 std::size_t nblocks) {
+  const auto* rk = reinterpret_cast<const unsigned char*>(key_schedule);
+  for (std::size_t i = 0; i < nblocks; ++i) {
+    unsigned char block[BLOCK_SIZE];
+    auto* b = reinterpret_cast<__m128i*>(block);
+    _mm_storeu_si128(b, _mm_loadu_si128(in + i));
+    softEncryptBlock(rk, block);
+    _mm_storeu_si128(out + i, _mm_loadu_si128(b));
+  }
+}
+
+}  // namespace
+
+scl::util::AES::AES(const unsigned char* key) {
+  if (cpu::features().aes) {
+    aes128LoadKey(key, m_round_keys);
+  } else {
+    softLoadKey(key, m_round_keys);
+  }
+}
+
+void scl::util::AES::encrypt(const BlockType* in,
+                             BlockType* out,
+                             std::size_t nblocks) const {
+  const auto& features = cpu::features();
+  if (features.vaes) {
+    aes128EncryptVaes(m_round_keys, in, out, nblocks);
+  } else if (features.aes) {
+    aes128Encrypt(m_round_keys, in, out, nblocks);
+  } else {
+    softEncrypt(m_round_keys, in, out, nblocks);
+  }
+}
+
+void scl::util::AES::ctr(long nonce,
+                         long counter,
+                         std::size_t nblocks,
+                         unsigned char* out) const {
+  const auto& features = cpu::features();
+  if (features.vaes) {
+    aes128CtrVaes(m_round_keys, nonce, counter, nblocks, out);
+  } else if (features.aes) {
+    aes128Ctr(m_round_keys, nonce, counter, nblocks, out);
+  } else {
+    softCtr(m_round_keys, nonce, counter, nblocks, out);
+  }
+}
@@ -0,0 +1,92 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/util/arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace scl;
+
+namespace {
+
+// alignment of chunks obtained from upstream.
+constexpr std::size_t CHUNK_ALIGNMENT = alignof(std::max_align_t);
+
+}  // namespace
+
+util::Arena::Arena(std::size_t initial_size,
+                   std::pmr::memory_resource* upstream)
+    : m_upstream(upstream) {
+  addChunk(std::max<std::size_t>(initial_size, CHUNK_ALIGNMENT));
+}
+
+util::Arena::~Arena() {
+  releaseChunks();
+}
+
+std::size_t util::Arena::capacity() const {
+  std::size_t cap = 0;
+  for (const auto& chunk : m_chunks) {
+    cap += chunk.size;
+  }
+  return cap;
+}
+
+void util::Arena::reset() {
+  // replace all chunks by a single one, if more than one was needed.
+  if (m_chunks.size() > 1) {
+    const auto size = capacity();
+    releaseChunks();
+    addChunk(size);
+  }
+
+  m_ptr = m_chunks.front().data;
+  m_end = m_ptr + m_chunks.front().size;
+  m_allocated = 0;
+}
+
+void* util::Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+  auto p = reinterpret_cast<std::uintptr_t>(m_ptr);
+  auto aligned = (p + alignment - 1) & ~(alignment - 1);
+
+  if (aligned + bytes > reinterpret_cast<std::uintptr_t>(m_end)) {
+    const auto last = m_chunks.back().size;
+    addChunk(std::max(2 * last, bytes + alignment));
+    p = reinterpret_cast<std::uintptr_t>(m_ptr);
+    aligned = (p + alignment - 1) & ~(alignment - 1);
+  }
+
+  m_ptr = reinterpret_cast<std::byte*>(aligned + bytes);
+  m_allocated += bytes;
+  return reinterpret_cast<void*>(aligned);
+}
+
+void util::Arena::addChunk(std::size_t size) {
+  auto* data =
+      static_cast<std::byte*>(m_upstream->allocate(size, CHUNK_ALIGNMENT));
+  m_chunks.push_back({data, size});
+  m_ptr = data;
+  m_end = data + size;
+}
+
+void util::Arena::releaseChunks() {
+  for (const auto& chunk : m_chunks) {
+    m_upstream->deallocate(chunk.data, chunk.size, CHUNK_ALIGNMENT);
+  }
+  m_chunks.clear();
+}
@@ -0,0 +1,155 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/util/bitmap.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include <immintrin.h>
+
+#include "scl/util/cpu.h"
+
+using namespace scl;
+
+#define AVX2 __attribute__((target("avx2")))
+#define POPCNT __attribute__((target("popcnt")))
+
+namespace {
+
+// number of 64-bit words in an AVX2 register.
+constexpr std::size_t WORDS = sizeof(__m256i) / sizeof(std::uint64_t);
+
+enum class Op { AND, OR, XOR };
+
+template <Op OP>
+std::uint64_t op64(std::uint64_t a, std::uint64_t b) {
+  if constexpr (OP == Op::AND) {
+    return a & b;
+  } else if constexpr (OP == Op::OR) {
+    return a | b;
+  } else {
+    return a ^ b;
+  }
+}
+
+template <Op OP>
+AVX2 __m256i op256(__m256i a, __m256i b) {
+  if constexpr (OP == Op::AND) {
+    return _mm256_and_si256(a, b);
+  } else if constexpr (OP == Op::OR) {
+    return _mm256_or_si256(a, b);
+  } else {
+    return _mm256_xor_si256(a, b);
+  }
+}
+
+template <Op OP>
+void apply(std::uint64_t* dst, const std::uint64_t* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] = op64<OP>(dst[i], src[i]);
+  }
+}
+
+template <Op OP>
+AVX2 void apply256(std::uint64_t* dst,
+                   const std::uint64_t* src,
+                   std::size_t n) {
+  std::size_t i = 0;
+  for (; i + WORDS <= n; i += WORDS) {
+    auto* d = reinterpret_cast<__m256i*>(dst + i);
+    const auto* s = reinterpret_cast<const __m256i*>(src + i);
+    const auto r = op256<OP>(_mm256_loadu_si256(d), _mm256_loadu_si256(s));
+    _mm256_storeu_si256(d, r);
+  }
+  for (; i < n; ++i) {
+    dst[i] = op64<OP>(dst[i], src[i]);
+  }
+}
+
+template <Op OP>
+void dispatch(std::uint64_t* dst, const std::uint64_t* src, std::size_t n) {
+  if (util::cpu::features().avx2) {
+    apply256<OP>(dst, src, n);
+  } else {
+    apply<OP>(dst, src, n);
+  }
+}
+
+AVX2 void not256(std::uint64_t* dst, std::size_t n) {
+  const auto ones = _mm256_set1_epi64x(-1);
+  std::size_t i = 0;
+  for (; i + WORDS <= n; i += WORDS) {
+    auto* d = reinterpret_cast<__m256i*>(dst + i);
+    _mm256_storeu_si256(d, _mm256_xor_si256(_mm256_loadu_si256(d), ones));
+  }
+  for (; i < n; ++i) {
+    dst[i] = ~dst[i];
+  }
+}
+
+POPCNT std::size_t countPopcnt(const std::uint64_t* src, std::size_t n) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    count += _mm_popcnt_u64(src[i]);
+  }
+  return count;
+}
+
+}  // namespace
+
+void util::details::bitmapAnd(std::uint64_t* dst,
+                              const std::uint64_t* src,
+                              std::size_t n) {
+  dispatch<Op::AND>(dst, src, n);
+}
+
+void util::details::bitmapOr(std::uint64_t* dst,
+                             const std::uint64_t* src,
+                             std::size_t n) {
+  dispatch<Op::OR>(dst, src, n);
+}
+
+void util::details::bitmapXor(std::uint64_t* dst,
+                              const std::uint64_t* src,
+                              std::size_t n) {
+  dispatch<Op::XOR>(dst, src, n);
+}
+
+void util::details::bitmapNot(std::uint64_t* dst, std::size_t n) {
+  if (cpu::features().avx2) {
+    not256(dst, n);
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      dst[i] = ~dst[i];
+    }
+  }
+}
+
+std::size_t util::details::bitmapCount(const std::uint64_t* src,
+                                       std::size_t n) {
+  if (cpu::features().popcnt) {
+    return countPopcnt(src, n);
+  }
+
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    count += std::popcount(src[i]);
+  }
+  return count;
+}
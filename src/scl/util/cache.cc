@@ -0,0 +1,179 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/util/cache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+
+#include "scl/util/digest.h"
+#include "scl/util/sha3.h"
+
+using namespace scl;
+
+namespace {
+
+// Distinguishes temporary files written by concurrent calls to store() in the
+// same process.
+std::atomic<std::uint64_t> tmp_counter{0};
+
+constexpr char MAGIC[8] = {'S', 'C', 'L', 'C', 'A', 'C', 'H', 'E'};
+
+// File header. The key follows the header, and the payload follows the key.
+struct Header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t key_size;
+  std::uint64_t payload_size;
+  std::uint64_t checksum;
+};
+
+// Checksum of a payload. This is meant to catch truncated or corrupted files
+// without costing much compared to the deserialization that follows, and is
+// therefore not a cryptographic hash.
+std::uint64_t checksum(const unsigned char* data, std::size_t size) {
+  constexpr std::uint64_t PRIME = 0x9E3779B97F4A7C15;
+  std::uint64_t h = size;
+  std::size_t i = 0;
+  for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+    std::uint64_t w;
+    std::memcpy(&w, data + i, sizeof(w));
+    h = (h ^ w) * PRIME;
+    h ^= h >> 29;
+  }
+  for (; i < size; ++i) {
+    h = (h ^ data[i]) * PRIME;
+  }
+  return h ^ (h >> 32);
+}
+
+}  // namespace
+
+util::PrecomputationCache::Mapping::~Mapping() {
+  ::munmap(const_cast<unsigned char*>(m_base), m_length);
+}
+
+util::PrecomputationCache::PrecomputationCache(std::filesystem::path directory)
+    : m_directory(std::move(directory)) {
+  std::error_code ec;
+  std::filesystem::create_directories(m_directory, ec);
+}
+
+std::filesystem::path util::PrecomputationCache::path(
+    const std::string& key) const {
+  Sha3<256> hash;
+  hash.update(std::string_view(key));
+  const auto digest = hash.finalize();
+  return m_directory / (digestToString(digest).substr(0, 32) + ".bin");
+}
+
+std::unique_ptr<util::PrecomputationCache::Mapping>
+util::PrecomputationCache::load(const std::string& key) const {
+  const auto file = path(key);
+  const int fd = ::open(file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 ||
+      static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+    ::close(fd);
+    return nullptr;
+  }
+
+  const auto length = static_cast<std::size_t>(st.st_size);
+  void* base = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    return nullptr;
+  }
+
+  // the Mapping unmaps the file when any of the checks below fail.
+  const auto* bytes = static_cast<const unsigned char*>(base);
+  std::unique_ptr<Mapping> mapping(
+      new Mapping(bytes, length, sizeof(Header) + key.size(), 0));
+
+  Header header;
+  std::memcpy(&header, bytes, sizeof(header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != VERSION || header.key_size != key.size() ||
+      length < mapping->m_offset ||
+      header.payload_size != length - mapping->m_offset ||
+      std::memcmp(bytes + sizeof(Header), key.data(), key.size()) != 0) {
+    return nullptr;
+  }
+
+  mapping->m_size = header.payload_size;
+  if (checksum(mapping->data(), mapping->size()) != header.checksum) {
+    return nullptr;
+  }
+  return mapping;
+}
+
+bool util::PrecomputationCache::store(const std::string& key,
+                                      const unsigned char* data,
+                                      std::size_t size) const {
+  Header header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.key_size = static_cast<std::uint32_t>(key.size());
+  header.payload_size = size;
+  header.checksum = checksum(data, size);
+
+  // written to a temporary file first, so that other processes and threads
+  // never see a partially written file.
+  const auto file = path(key);
+  auto tmp = file;
+  tmp += ".tmp" + std::to_string(::getpid()) + "." +
+         std::to_string(tmp_counter.fetch_add(1, std::memory_order_relaxed));
+
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(key.data(), static_cast<std::streamsize>(key.size()));
+    out.write(reinterpret_cast<const char*>(data),
+              static_cast<std::streamsize>(size));
+    out.close();
+    if (!out) {
+      std::error_code ec;
+      std::filesystem::remove(tmp, ec);
+      return false;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp, file, ec);
+  if (ec) {
+    std::filesystem::remove(tmp, ec);
+    return false;
+  }
+  return true;
+}
+
+void util::PrecomputationCache::erase(const std::string& key) const {
+  std::error_code ec;
+  std::filesystem::remove(path(key), ec);
+}
@@ -0,0 +1,89 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/util/cpu.h"
+
+#include <cpuid.h>
+
+using namespace scl;
+
+namespace {
+
+// Check if the OS saves the register state given by mask on context switches.
+bool osSupports(unsigned mask) {
+  unsigned lo;
+  unsigned hi;
+  __asm__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  return (lo & mask) == mask;
+}
+
+util::cpu::Features& current() {
+  static util::cpu::Features f = util::cpu::detect();
+  return f;
+}
+
+}  // namespace
+
+util::cpu::Features util::cpu::detect() {
+  Features f;
+
+  unsigned a;
+  unsigned b;
+  unsigned c;
+  unsigned d;
+
+  if (__get_cpuid(1, &a, &b, &c, &d) == 0) {
+    return f;
+  }
+
+  f.popcnt = (c & bit_POPCNT) != 0;
+  f.aes = (c & bit_AES) != 0;
+  f.pclmul = (c & bit_PCLMUL) != 0;
+
+  // AVX registers are only usable if the OS saves them (XMM and YMM state),
+  // and likewise for the AVX-512 registers (opmask, ZMM_Hi256, Hi16_ZMM).
+  const bool osxsave = (c & bit_OSXSAVE) != 0;
+  const bool ymm = osxsave && osSupports(0x06);
+  const bool zmm = osxsave && osSupports(0xE6);
+
+  if (__get_cpuid_count(7, 0, &a, &b, &c, &d) == 0) {
+    return f;
+  }
+
+  f.sha = (b & bit_SHA) != 0;
+  f.avx2 = ymm && (b & bit_AVX2) != 0;
+  f.vaes = f.avx2 && f.aes && (c & bit_VAES) != 0;
+  f.avx512f = zmm && (b & bit_AVX512F) != 0;
+
+  return f;
+}
+
+const util::cpu::Features& util::cpu::features() {
+  return current();
+}
+
+void util::cpu::restrict(const Features& features) {
+  const auto supported = detect();
+  auto& f = current();
+  f.popcnt = features.popcnt && supported.popcnt;
+  f.aes = features.aes && supported.aes;
+  f.vaes = features.vaes && supported.vaes;
+  f.pclmul = features.pclmul && supported.pclmul;
+  f.sha = features.sha && supported.sha;
+  f.avx2 = features.avx2 && supported.avx2;
+  f.avx512f = features.avx512f && supported.avx512f;
+}
@@ -0,0 +1,129 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/util/histogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+using namespace scl;
+
+util::Histogram::Histogram(std::size_t precision) : m_precision(precision) {
+  if (precision == 0 || precision > MAX_PRECISION) {
+    throw std::invalid_argument("invalid histogram precision");
+  }
+}
+
+// Values below 2m, where m = 2^precision, get their own bucket. A larger
+// value v is put in bucket e*m + (v >> e), where e = bit_width(v) - 1 -
+// precision. Since (v >> e) is in [m, 2m), the buckets for each e are
+// consecutive.
+std::size_t util::Histogram::indexOf(std::uint64_t value) const {
+  const std::uint64_t m = 1ULL << m_precision;
+  if (value < 2 * m) {
+    return value;
+  }
+  const std::size_t e = std::bit_width(value) - 1 - m_precision;
+  return e * m + (value >> e);
+}
+
+std::uint64_t util::Histogram::highestValueIn(std::size_t index) const {
+  const std::uint64_t m = 1ULL << m_precision;
+  if (index < 2 * m) {
+    return index;
+  }
+  const std::size_t e = index / m - 1;
+  const std::uint64_t sub = index - e * m;
+  // wraps around to the largest 64-bit value for the very last bucket.
+  return ((sub + 1) << e) - 1;
+}
+
+void util::Histogram::update(std::uint64_t count,
+                             long double mean,
+                             long double m2) {
+  // Chan et al.'s method for combining the mean and variance of two sets.
+  const long double n = m_count + count;
+  const long double delta = mean - m_mean;
+  m_mean += delta * count / n;
+  m_m2 += m2 + delta * delta * m_count * count / n;
+  m_count += count;
+}
+
+void util::Histogram::record(std::uint64_t value, std::uint64_t count) {
+  if (count == 0) {
+    return;
+  }
+
+  const std::size_t index = indexOf(value);
+  if (index >= m_counts.size()) {
+    m_counts.resize(index + 1);
+  }
+  m_counts[index] += count;
+
+  m_min = empty() ? value : std::min(m_min, value);
+  m_max = std::max(m_max, value);
+  update(count, value, 0);
+}
+
+void util::Histogram::merge(const Histogram& other) {
+  if (other.m_precision != m_precision) {
+    throw std::invalid_argument(
+        "cannot merge histograms of different precision");
+  }
+  if (other.empty()) {
+    return;
+  }
+
+  if (other.m_counts.size() > m_counts.size()) {
+    m_counts.resize(other.m_counts.size());
+  }
+  for (std::size_t i = 0; i < other.m_counts.size(); ++i) {
+    m_counts[i] += other.m_counts[i];
+  }
+
+  m_min = empty() ? other.m_min : std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+  update(other.m_count, other.m_mean, other.m_m2);
+}
+
+std::uint64_t util::Histogram::percentile(double p) const {
+  if (p < 0 || p > 100) {
+    throw std::invalid_argument("percentile must be in the range [0, 100]");
+  }
+  if (empty()) {
+    return 0;
+  }
+
+  const auto rank = std::max<std::uint64_t>(
+      1,
+      static_cast<std::uint64_t>(std::ceil(p / 100.0 * m_count)));
+
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < m_counts.size(); ++i) {
+    seen += m_counts[i];
+    if (seen >= rank) {
+      return std::min(highestValueIn(i), m_max);
+    }
+  }
+  return m_max;
+}
+
+long double util::Histogram::stddev() const {
+  return std::sqrt(var());
+}
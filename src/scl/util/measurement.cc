@@ -17,7 +17,9 @@
 
 #include "scl/util/measurement.h"
 
+#include <chrono>
 #include <cmath>
+#include <cstdint>
 
 #include "scl/util/time.h"
 
@@ -78,3 +80,69 @@ std::ostream& util::operator<<(std::ostream& os,
 
   return os;
 }
+
+template <>
+std::uint64_t util::StreamingMeasurement<long double>::toValue(
+    const long double& sample) {
+  return sample <= 0 ? 0 : static_cast<std::uint64_t>(std::llround(sample));
+}
+
+template <>
+long double util::StreamingMeasurement<long double>::fromValue(
+    long double value) {
+  return value;
+}
+
+template <>
+std::uint64_t util::StreamingMeasurement<util::Time::Duration>::toValue(
+    const util::Time::Duration& sample) {
+  return sample.count() <= 0 ? 0 : sample.count();
+}
+
+template <>
+util::Time::Duration
+util::StreamingMeasurement<util::Time::Duration>::fromValue(long double value) {
+  std::chrono::duration<long double, util::Time::Duration::period> w(value);
+  return std::chrono::duration_cast<util::Time::Duration>(w);
+}
+
+namespace {
+
+template <typename T, typename F>
+void writePercentiles(std::ostream& os,
+                      const util::StreamingMeasurement<T>& measurement,
+                      F convert) {
+  os << "\"min\": " << convert(measurement.min()) << ", "
+     << "\"p50\": " << convert(measurement.percentile(50)) << ", "
+     << "\"p90\": " << convert(measurement.percentile(90)) << ", "
+     << "\"p99\": " << convert(measurement.percentile(99)) << ", "
+     << "\"p999\": " << convert(measurement.percentile(99.9)) << ", "
+     << "\"max\": " << convert(measurement.max()) << ", "
+     << "\"count\": " << measurement.size();
+}
+
+}  // namespace
+
+std::ostream& util::operator<<(
+    std::ostream& os,
+    const util::StreamingTimeMeasurement& measurement) {
+  os << "{"
+     << "\"mean\": " << util::timeToMillis(measurement.mean()) << ", "
+     << "\"unit\": \"ms\", "
+     << "\"std_dev\": " << util::timeToMillis(measurement.stddev()) << ", ";
+  writePercentiles(os, measurement, [](util::Time::Duration d) {
+    return util::timeToMillis(d);
+  });
+  return os << "}";
+}
+
+std::ostream& util::operator<<(
+    std::ostream& os,
+    const util::StreamingDataMeasurement& measurement) {
+  os << "{"
+     << "\"mean\": " << measurement.mean() << ", "
+     << "\"unit\": \"B\", "
+     << "\"std_dev\": " << measurement.stddev() << ", ";
+  writePercentiles(os, measurement, [](long double v) { return v; });
+  return os << "}";
+}
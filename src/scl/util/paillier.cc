@@ -0,0 +1,268 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/util/paillier.h"
+
+#include <stdexcept>
+
+#include "scl/math/prime.h"
+#include "scl/util/cache.h"
+#include "scl/util/parallel.h"
+
+using namespace scl;
+
+using Number = math::Number;
+
+namespace {
+
+// Exponents are processed WINDOW bits at a time when using the fixed-base
+// table, which then has 2^WINDOW - 1 entries per window.
+constexpr std::size_t WINDOW = 4;
+constexpr std::size_t ENTRIES = (1 << WINDOW) - 1;
+
+// Uniformly random non-negative number of at most bits bits.
+Number randomBits(std::size_t bits, util::PRG& prg) {
+  // Number::random may return fewer bits than asked for, so ask for a few
+  // more and mask.
+  const auto r = Number::random(bits + 8, prg);
+  const auto mask = (Number(1) << static_cast<int>(bits)) - Number(1);
+  return (r < Number(0) ? -r : r) & mask;
+}
+
+// Split n elements into threads chunks on the global ThreadPool. 0 uses one
+// chunk per thread of the pool, counting the caller.
+util::Parallel chunks(std::size_t n, std::size_t threads) {
+  if (threads == 0) {
+    threads = util::ThreadPool::global().workers() + 1;
+  }
+  return {(n + threads - 1) / threads, nullptr};
+}
+
+// L(x) = (x - 1) / d, as defined in the Paillier paper.
+Number lFunction(const Number& x, const Number& d) {
+  return (x - Number(1)) / d;
+}
+
+}  // namespace
+
+struct util::Paillier::PublicKey::Table {
+  // entries[i * ENTRIES + j - 1] = hn^(j * 2^(WINDOW * i)) mod n^2.
+  std::vector<Number> entries;
+  std::size_t windows;
+};
+
+util::Paillier::PublicKey::PublicKey(const Number& n, const Number& hn)
+    : m_n(n), m_n2(n * n), m_hn(hn) {}
+
+namespace {
+
+// Compute the entries of the fixed-base table for hn modulo n2.
+std::vector<Number> tableEntries(const Number& hn,
+                                 const Number& n2,
+                                 std::size_t windows) {
+  std::vector<Number> entries;
+  entries.reserve(windows * ENTRIES);
+
+  auto base = hn;
+  for (std::size_t i = 0; i < windows; ++i) {
+    auto power = base;
+    entries.emplace_back(power);
+    for (std::size_t j = 1; j < ENTRIES; ++j) {
+      math::mulMod(power, power, base, n2);
+      entries.emplace_back(power);
+    }
+    math::mulMod(base, power, base, n2);
+  }
+  return entries;
+}
+
+}  // namespace
+
+void util::Paillier::PublicKey::precompute() {
+  auto table = std::make_shared<Table>();
+  table->windows = (randomnessBits() + WINDOW - 1) / WINDOW;
+  table->entries = tableEntries(m_hn, m_n2, table->windows);
+  m_table = std::move(table);
+}
+
+void util::Paillier::PublicKey::precompute(PrecomputationCache& cache) {
+  auto table = std::make_shared<Table>();
+  table->windows = (randomnessBits() + WINDOW - 1) / WINDOW;
+
+  const auto key = "paillier/table/" + std::to_string(WINDOW) + "/" +
+                   m_n.toString() + "/" + m_hn.toString();
+  table->entries = cache.get<std::vector<Number>>(key, [&]() {
+    return tableEntries(m_hn, m_n2, table->windows);
+  });
+
+  // a cached table is only used if it has the expected shape.
+  if (table->entries.size() != table->windows * ENTRIES) {
+    table->entries = tableEntries(m_hn, m_n2, table->windows);
+  }
+  m_table = std::move(table);
+}
+
+util::Paillier::SecretKey::SecretKey(const Number& p,
+                                     const Number& q,
+                                     const Number& hn)
+    : m_pk(p * q, hn), m_p(p), m_q(q) {
+  if (p == q) {
+    throw std::invalid_argument("p and q must be different");
+  }
+
+  m_p2 = p * p;
+  m_q2 = q * q;
+  m_p_minus_one = p - Number(1);
+  m_q_minus_one = q - Number(1);
+
+  // h_p = L_p(g^(p - 1) mod p^2)^(-1) mod p, with g = n + 1, and likewise for
+  // h_q. See Section 7 of the Paillier paper.
+  const auto g = m_pk.n() + Number(1);
+  m_hp = math::modInverse(
+      lFunction(math::modExp(g, m_p_minus_one, m_p2), p) % p,
+      p);
+  m_hq = math::modInverse(
+      lFunction(math::modExp(g, m_q_minus_one, m_q2), q) % q,
+      q);
+  m_q_inv = math::modInverse(q, p);
+}
+
+util::Paillier::SecretKey util::Paillier::generate(std::size_t bits,
+                                                   PRG& prg,
+                                                   std::size_t threads) {
+  const auto [n, p, q] = math::generateRSAModulus(bits, prg, threads);
+
+  // h = -x^2 mod n for a random x, which generates the subgroup of Jacobi
+  // symbol 1 with overwhelming probability.
+  const auto x = randomBits(n.bitSize() + 64, prg) % n;
+  const auto h = n - (x * x) % n;
+  const auto hn = math::modExp(h, n, n * n);
+
+  return SecretKey(p, q, hn);
+}
+
+namespace {
+
+// Compute pk.hn()^alpha mod n^2, using the fixed-base table if the key has
+// one.
+template <typename TABLE>
+Number randomness(const util::Paillier::PublicKey& pk,
+                  const TABLE* table,
+                  const Number& alpha) {
+  Number r;
+  if (table == nullptr) {
+    math::modExp(r, pk.hn(), alpha, pk.n2());
+    return r;
+  }
+
+  r = Number(1);
+  r.reserve(2 * pk.n2().bitSize());
+  for (std::size_t i = 0; i < table->windows; ++i) {
+    std::size_t digit = 0;
+    for (std::size_t b = 0; b < WINDOW; ++b) {
+      digit |= static_cast<std::size_t>(alpha.testBit(i * WINDOW + b)) << b;
+    }
+    if (digit != 0) {
+      math::mulMod(r, r, table->entries[i * ENTRIES + digit - 1], pk.n2());
+    }
+  }
+  return r;
+}
+
+}  // namespace
+
+util::Paillier::Ciphertext util::Paillier::encrypt(const PublicKey& pk,
+                                                   const Number& m,
+                                                   PRG& prg) {
+  const auto alpha = randomBits(pk.randomnessBits(), prg);
+  auto c = randomness(pk, pk.m_table.get(), alpha);
+
+  // g^m = (1 + n)^m = 1 + m * n mod n^2.
+  const auto gm = (m % pk.n()) * pk.n() + Number(1);
+  math::mulMod(c, c, gm, pk.n2());
+  return {std::move(c)};
+}
+
+std::vector<util::Paillier::Ciphertext> util::Paillier::encrypt(
+    const PublicKey& pk,
+    const std::vector<Number>& ms,
+    PRG& prg,
+    std::size_t threads) {
+  std::vector<Number> alphas;
+  alphas.reserve(ms.size());
+  for (std::size_t i = 0; i < ms.size(); ++i) {
+    alphas.emplace_back(randomBits(pk.randomnessBits(), prg));
+  }
+
+  std::vector<Ciphertext> cs(ms.size());
+  const auto policy = chunks(ms.size(), threads);
+  util::parallelFor(ms.size(), policy, [&](std::size_t b, std::size_t e) {
+    for (std::size_t i = b; i < e; ++i) {
+      auto c = randomness(pk, pk.m_table.get(), alphas[i]);
+      const auto gm = (ms[i] % pk.n()) * pk.n() + Number(1);
+      math::mulMod(c, c, gm, pk.n2());
+      cs[i].value = std::move(c);
+    }
+  });
+  return cs;
+}
+
+Number util::Paillier::decrypt(const SecretKey& sk, const Ciphertext& c) {
+  // m_p = L_p(c^(p - 1) mod p^2) * h_p mod p, and likewise for m_q.
+  Number t;
+  math::modExp(t, c.value % sk.m_p2, sk.m_p_minus_one, sk.m_p2);
+  Number mp;
+  math::mulMod(mp, lFunction(t, sk.m_p), sk.m_hp, sk.m_p);
+
+  math::modExp(t, c.value % sk.m_q2, sk.m_q_minus_one, sk.m_q2);
+  Number mq;
+  math::mulMod(mq, lFunction(t, sk.m_q), sk.m_hq, sk.m_q);
+
+  // m = m_q + q * ((m_p - m_q) * q^(-1) mod p).
+  math::subtract(t, mp, mq);
+  math::mulMod(t, t, sk.m_q_inv, sk.m_p);
+  return mq + t * sk.m_q;
+}
+
+std::vector<Number> util::Paillier::decrypt(const SecretKey& sk,
+                                            const std::vector<Ciphertext>& cs,
+                                            std::size_t threads) {
+  std::vector<Number> ms(cs.size());
+  const auto policy = chunks(cs.size(), threads);
+  util::parallelFor(cs.size(), policy, [&](std::size_t b, std::size_t e) {
+    for (std::size_t i = b; i < e; ++i) {
+      ms[i] = decrypt(sk, cs[i]);
+    }
+  });
+  return ms;
+}
+
+util::Paillier::Ciphertext util::Paillier::add(const PublicKey& pk,
+                                               const Ciphertext& a,
+                                               const Ciphertext& b) {
+  Ciphertext c;
+  math::mulMod(c.value, a.value, b.value, pk.n2());
+  return c;
+}
+
+util::Paillier::Ciphertext util::Paillier::scalarMultiply(const PublicKey& pk,
+                                                          const Ciphertext& c,
+                                                          const Number& k) {
+  Ciphertext r;
+  math::modExp(r.value, c.value, k % pk.n(), pk.n2());
+  return r;
+}
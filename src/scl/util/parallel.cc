@@ -0,0 +1,130 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/util/parallel.h"
+
+#include <atomic>
+#include <exception>
+
+using namespace scl;
+
+struct util::ThreadPool::Batch {
+  const std::function<void(std::size_t)>* task;
+  std::size_t tasks;
+  std::atomic<std::size_t> next = 0;
+  std::atomic<std::size_t> done = 0;
+
+  std::mutex mutex;
+  std::condition_variable finished;
+  std::exception_ptr error;
+
+  // Run the next task of this batch, if there is one left.
+  bool runOne() {
+    const auto i = next.fetch_add(1);
+    if (i >= tasks) {
+      return false;
+    }
+
+    try {
+      (*task)(i);
+    } catch (...) {
+      std::scoped_lock lock(mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+
+    if (done.fetch_add(1) + 1 == tasks) {
+      std::scoped_lock lock(mutex);
+      finished.notify_all();
+    }
+    return true;
+  }
+};
+
+util::ThreadPool& util::ThreadPool::global() {
+  static ThreadPool pool(
+      std::max(1U, std::thread::hardware_concurrency()) - 1);
+  return pool;
+}
+
+util::ThreadPool::ThreadPool(std::size_t workers) {
+  m_workers.reserve(workers);
+  for (std::size_t i = 0; i < workers; ++i) {
+    m_workers.emplace_back([this]() { work(); });
+  }
+}
+
+util::ThreadPool::~ThreadPool() {
+  {
+    std::scoped_lock lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  for (auto& w : m_workers) {
+    w.join();
+  }
+}
+
+void util::ThreadPool::run(std::size_t tasks,
+                           const std::function<void(std::size_t)>& task) {
+  if (tasks == 0) {
+    return;
+  }
+
+  auto batch = std::make_shared<Batch>();
+  batch->task = &task;
+  batch->tasks = tasks;
+
+  if (tasks > 1 && !m_workers.empty()) {
+    {
+      std::scoped_lock lock(m_mutex);
+      m_batches.emplace_back(batch);
+    }
+    m_cv.notify_all();
+  }
+
+  while (batch->runOne()) {
+  }
+
+  std::unique_lock lock(batch->mutex);
+  batch->finished.wait(lock, [&]() { return batch->done == tasks; });
+  if (batch->error) {
+    std::rethrow_exception(batch->error);
+  }
+}
+
+void util::ThreadPool::work() {
+  std::unique_lock lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [this]() { return m_stop || !m_batches.empty(); });
+    if (m_stop) {
+      return;
+    }
+
+    // the batch stays queued until some thread finds it has no tasks left,
+    // so that every idle worker gets to help with it.
+    auto batch = m_batches.front();
+    lock.unlock();
+    while (batch->runOne()) {
+    }
+    lock.lock();
+    if (!m_batches.empty() && m_batches.front() == batch) {
+      m_batches.pop_front();
+    }
+  }
+}
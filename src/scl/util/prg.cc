@@ -18,72 +18,11 @@
 #include "scl/util/prg.h"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <string>
 
-#include <emmintrin.h>
-#include <wmmintrin.h>
-#include <xmmintrin.h>
-
-/**
- * PRG implementation based on AES-CTR with code from
- * https://github.com/sebastien-riou/aes-brute-force
- */
-
-#define BLOCK_SIZE sizeof(__m128i)
-
-#define DO_ENC_BLOCK(m, k)                  \
-  do {                                      \
-    (m) = _mm_xor_si128(m, (k)[0]);         \
-    (m) = _mm_aesenc_si128(m, (k)[1]);      \
-    (m) = _mm_aesenc_si128(m, (k)[2]);      \
-    (m) = _mm_aesenc_si128(m, (k)[3]);      \
-    (m) = _mm_aesenc_si128(m, (k)[4]);      \
-    (m) = _mm_aesenc_si128(m, (k)[5]);      \
-    (m) = _mm_aesenc_si128(m, (k)[6]);      \
-    (m) = _mm_aesenc_si128(m, (k)[7]);      \
-    (m) = _mm_aesenc_si128(m, (k)[8]);      \
-    (m) = _mm_aesenc_si128(m, (k)[9]);      \
-    (m) = _mm_aesenclast_si128(m, (k)[10]); \
-  } while (0)
-
-#define AES_128_KEY_EXP(k, rcon) \
-  aes128KeyExpansion(k, _mm_aeskeygenassist_si128(k, rcon))
-
-namespace {
-
-auto aes128KeyExpansion(__m128i key, __m128i keygened) {
-  keygened = _mm_shuffle_epi32(keygened, _MM_SHUFFLE(3, 3, 3, 3));
-  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
-  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
-  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
-  return _mm_xor_si128(key, keygened);
-}
-
-void aes128LoadKey(const unsigned char* enc_key, __m128i* key_schedule) {
-  const auto* k = reinterpret_cast<const __m128i*>(enc_key);
-  key_schedule[0] = _mm_loadu_si128(k);
-  key_schedule[1] = AES_128_KEY_EXP(key_schedule[0], 0x01);
-  key_schedule[2] = AES_128_KEY_EXP(key_schedule[1], 0x02);
-  key_schedule[3] = AES_128_KEY_EXP(key_schedule[2], 0x04);
-  key_schedule[4] = AES_128_KEY_EXP(key_schedule[3], 0x08);
-  key_schedule[5] = AES_128_KEY_EXP(key_schedule[4], 0x10);
-  key_schedule[6] = AES_128_KEY_EXP(key_schedule[5], 0x20);
-  key_schedule[7] = AES_128_KEY_EXP(key_schedule[6], 0x40);
-  key_schedule[8] = AES_128_KEY_EXP(key_schedule[7], 0x80);
-  key_schedule[9] = AES_128_KEY_EXP(key_schedule[8], 0x1B);
-  key_schedule[10] = AES_128_KEY_EXP(key_schedule[9], 0x36);
-}
-
-void aes128Enc(const __m128i* key_schedule, __m128i m, unsigned char* ct) {
-  DO_ENC_BLOCK(m, key_schedule);
-  _mm_storeu_si128(reinterpret_cast<__m128i*>(ct), m);
-}
-
-auto createMask(long counter) {
-  return _mm_set_epi64x(PRG_NONCE, counter);
-}
-
-}  // namespace
+#include "scl/util/parallel.h"
 
 scl::util::PRG scl::util::PRG::create(const unsigned char* seed,
                                       std::size_t seed_len) {
@@ -95,9 +34,7 @@ scl::util::PRG scl::util::PRG::create(const unsigned char* seed,
       std::copy(seed, seed + seed_len, s.begin());
     }
   }
-  PRG prg(s);
-  prg.init();
-  return prg;
+  return PRG(s);
 }
 
 scl::util::PRG scl::util::PRG::create() {
@@ -108,16 +45,13 @@ scl::util::PRG scl::util::PRG::create(const std::string& seed) {
   return PRG::create((const unsigned char*)seed.c_str(), seed.length());
 }
 
-void scl::util::PRG::update() {
-  m_counter += 1;
-}
-
-void scl::util::PRG::init() {
-  aes128LoadKey(m_seed.data(), m_state);
+scl::util::PRG scl::util::PRG::fork() {
+  std::array<unsigned char, PRG::seedSize()> seed;
+  next(seed.data(), seed.size());
+  return PRG::create(seed.data(), seed.size());
 }
 
 void scl::util::PRG::reset() {
-  init();
   m_counter = PRG_INITIAL_COUNTER;
 }
 
@@ -126,21 +60,38 @@ void scl::util::PRG::next(unsigned char* buffer, size_t n) {
     return;
   }
 
-  auto nblocks = n / BLOCK_SIZE;
-
-  if ((n % BLOCK_SIZE) != 0) {
-    nblocks++;
+  // full blocks are written directly to buffer, and only a partial last block
+  // goes through a temporary.
+  const auto nblocks = n / BLOCK_SIZE;
+  m_aes.ctr(PRG_NONCE, m_counter, nblocks, buffer);
+  m_counter += static_cast<long>(nblocks);
+
+  const auto rest = n % BLOCK_SIZE;
+  if (rest != 0) {
+    unsigned char last[BLOCK_SIZE];
+    m_aes.ctr(PRG_NONCE, m_counter, 1, last);
+    m_counter++;
+    std::copy(last, last + rest, buffer + nblocks * BLOCK_SIZE);
   }
+}
 
-  auto mask = createMask(m_counter);
-  auto out = std::make_unique<unsigned char[]>(nblocks * BLOCK_SIZE);
-  auto* p = out.get();
-  for (size_t i = 0; i < nblocks; i++) {
-    aes128Enc(m_state, mask, p);
-    update();
-    mask = createMask(m_counter);
-    p += BLOCK_SIZE;
+void scl::util::PRG::next(unsigned char* buffer,
+                          std::size_t n,
+                          const Parallel& policy) {
+  // block i of the output only depends on the counter, so chunks of whole
+  // blocks can be generated independently.
+  const auto nblocks = n / BLOCK_SIZE;
+  const auto counter = m_counter;
+  parallelFor(nblocks, policy, [&](std::size_t begin, std::size_t end) {
+    m_aes.ctr(PRG_NONCE,
+              counter + static_cast<long>(begin),
+              end - begin,
+              buffer + begin * BLOCK_SIZE);
+  });
+  m_counter += static_cast<long>(nblocks);
+
+  const auto rest = n % BLOCK_SIZE;
+  if (rest != 0) {
+    next(buffer + nblocks * BLOCK_SIZE, rest);
   }
-
-  std::copy(out.get(), out.get() + n, buffer);
 }
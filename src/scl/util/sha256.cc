@@ -20,12 +20,33 @@
 #include <algorithm>
 #include <cstdint>
 
+#include <immintrin.h>
+
+#include "scl/util/cpu.h"
+
 /**
  * SHA-256 implementation based on https://github.com/System-Glitch/SHA256.
+ *
+ * If the CPU supports the SHA extensions, blocks are instead processed with
+ * code based on https://github.com/noloader/SHA-Intrinsics.
  */
 
 namespace {
 
+// round constants.
+alignas(16) constexpr std::array<uint32_t, 64> K = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
 auto rotR(uint32_t x, unsigned n) {
   return (x >> n) | (x << (32 - n));
 }
@@ -63,22 +84,68 @@ auto choose(uint32_t x, uint32_t y, uint32_t z) {
   return (x & y) ^ (~x & z);
 }
 
+__attribute__((target("sha,sse4.1"))) void transformSha(
+    std::array<uint32_t, 8>& state,
+    const std::array<unsigned char, 64>& chunk) {
+  // shuffles the bytes of each 32-bit word from big to little endian.
+  const auto mask =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  // the SHA instructions keep the state as ABEF and CDGH.
+  auto tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+  auto state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+  tmp = _mm_shuffle_epi32(tmp, 0xB1);
+  state1 = _mm_shuffle_epi32(state1, 0x1B);
+  auto state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+  const auto abef = state0;
+  const auto cdgh = state1;
+
+  __m128i w[4];
+  for (std::size_t i = 0; i < 4; ++i) {
+    const auto* p = reinterpret_cast<const __m128i*>(chunk.data() + 16 * i);
+    w[i] = _mm_shuffle_epi8(_mm_loadu_si128(p), mask);
+  }
+
+  // each iteration performs four rounds.
+  for (std::size_t i = 0; i < 16; ++i) {
+    if (i >= 4) {
+      auto& m = w[i % 4];
+      const auto& m1 = w[(i + 1) % 4];
+      const auto& m2 = w[(i + 2) % 4];
+      const auto& m3 = w[(i + 3) % 4];
+      m = _mm_sha256msg1_epu32(m, m1);
+      m = _mm_add_epi32(m, _mm_alignr_epi8(m3, m2, 4));
+      m = _mm_sha256msg2_epu32(m, m3);
+    }
+
+    const auto* k = reinterpret_cast<const __m128i*>(K.data() + 4 * i);
+    auto msg = _mm_add_epi32(w[i % 4], _mm_load_si128(k));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+    msg = _mm_shuffle_epi32(msg, 0x0E);
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+  }
+
+  state0 = _mm_add_epi32(state0, abef);
+  state1 = _mm_add_epi32(state1, cdgh);
+
+  tmp = _mm_shuffle_epi32(state0, 0x1B);
+  state1 = _mm_shuffle_epi32(state1, 0xB1);
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+  state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
 }  // namespace
 
 void scl::util::Sha256::transform() {
-  // round constants.
-  static constexpr std::array<uint32_t, 64> k = {
-      0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
-      0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
-      0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
-      0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-      0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
-      0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
-      0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
-      0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-      0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
-      0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
-      0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+  if (cpu::features().sha) {
+    transformSha(m_state, m_chunk);
+    return;
+  }
 
   const auto m = split(m_chunk);
   auto s = m_state;
@@ -90,7 +157,7 @@ void scl::util::Sha256::transform() {
     const auto xor_a = rotR(s[0], 2) ^ rotR(s[0], 13) ^ rotR(s[0], 22);
     const auto xor_e = rotR(s[4], 6) ^ rotR(s[4], 11) ^ rotR(s[4], 25);
 
-    const auto sum = m[i] + k[i] + s[7] + chs + xor_e;
+    const auto sum = m[i] + K[i] + s[7] + chs + xor_e;
 
     const auto new_a = xor_a + maj + sum;
     const auto new_e = s[3] + sum;
@@ -0,0 +1,163 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/util/trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+using namespace scl;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// All buffers ever created, together with a reference point used when
+// converting timestamps to time.
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<util::trace::Buffer>> buffers;
+  std::uint64_t start_ticks = util::trace::now();
+  Clock::time_point start_time = Clock::now();
+};
+
+Registry& registry() {
+  static Registry r;
+  return r;
+}
+
+std::atomic<std::uint64_t> g_async_id = 1;
+
+// Number of timestamp ticks per microsecond.
+long double ticksPerMicro(const Registry& r) {
+#if defined(__x86_64__) || defined(__i386__)
+  // measure the TSC frequency against the steady clock. Make sure some time
+  // has passed since the reference point, as the estimate is otherwise poor.
+  using namespace std::chrono_literals;
+  while (Clock::now() - r.start_time < 10ms) {
+  }
+  const auto ticks = util::trace::now() - r.start_ticks;
+  const auto time = Clock::now() - r.start_time;
+  const auto micros =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() / 1e3L;
+  return ticks / micros;
+#else
+  (void)r;
+  return 1e3L;
+#endif
+}
+
+// Index of the oldest event that is still held by a buffer.
+std::uint64_t oldest(std::uint64_t pushed) {
+  constexpr auto capacity = util::trace::Buffer::CAPACITY;
+  return pushed > capacity ? pushed - capacity : 0;
+}
+
+void writeCommon(std::ostream& stream,
+                 const util::trace::Event& event,
+                 const char* phase,
+                 long double ts,
+                 std::size_t tid) {
+  stream << "{\"name\": \"" << event.name << "\", "
+         << "\"cat\": \"" << event.category << "\", "
+         << "\"ph\": \"" << phase << "\", "
+         << "\"ts\": " << ts << ", "
+         << "\"pid\": 0, "
+         << "\"tid\": " << tid;
+}
+
+}  // namespace
+
+util::trace::Buffer& util::trace::threadBuffer() {
+  thread_local std::shared_ptr<Buffer> buffer = []() {
+    auto b = std::make_shared<Buffer>();
+    auto& r = registry();
+    std::scoped_lock lock(r.mutex);
+    r.buffers.emplace_back(b);
+    return b;
+  }();
+  return *buffer;
+}
+
+std::uint64_t util::trace::nextAsyncId() noexcept {
+  return g_async_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+void util::trace::writeChromeTrace(std::ostream& stream) {
+  auto& r = registry();
+  std::scoped_lock lock(r.mutex);
+
+  const auto ticks_per_us = ticksPerMicro(r);
+
+  // spans may have begun before the registry was created, so use the earliest
+  // timestamp as the origin.
+  auto origin = r.start_ticks;
+  for (const auto& buffer : r.buffers) {
+    const auto pushed = buffer->pushed();
+    const auto first = oldest(pushed);
+    for (auto i = first; i < pushed; ++i) {
+      origin = std::min(origin, buffer->at(i).begin);
+    }
+  }
+
+  const auto toMicros = [&](std::uint64_t ticks) {
+    return (ticks - origin) / ticks_per_us;
+  };
+
+  const auto flags = stream.flags();
+  stream << std::fixed;
+  stream << "{\"traceEvents\": [";
+
+  bool first_event = true;
+  for (std::size_t tid = 0; tid < r.buffers.size(); ++tid) {
+    const auto& buffer = r.buffers[tid];
+    const auto pushed = buffer->pushed();
+    const auto first = oldest(pushed);
+
+    for (auto i = first; i < pushed; ++i) {
+      const auto& event = buffer->at(i);
+      stream << (first_event ? "\n" : ",\n");
+      first_event = false;
+
+      if (event.id == 0) {
+        writeCommon(stream, event, "X", toMicros(event.begin), tid);
+        stream << ", \"dur\": " << toMicros(event.end) - toMicros(event.begin)
+               << "}";
+      } else {
+        writeCommon(stream, event, "b", toMicros(event.begin), tid);
+        stream << ", \"id\": " << event.id << "},\n";
+        writeCommon(stream, event, "e", toMicros(event.end), tid);
+        stream << ", \"id\": " << event.id << "}";
+      }
+    }
+  }
+
+  stream << "\n], \"displayTimeUnit\": \"ns\"}\n";
+  stream.flags(flags);
+}
+
+void util::trace::clear() {
+  auto& r = registry();
+  std::scoped_lock lock(r.mutex);
+  for (auto& buffer : r.buffers) {
+    buffer->clear();
+  }
+}
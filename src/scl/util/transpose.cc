@@ -0,0 +1,267 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scl/util/transpose.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include <immintrin.h>
+
+#include "scl/util/cpu.h"
+
+using namespace scl;
+
+#define AVX2 __attribute__((target("avx2")))
+
+namespace {
+
+// Size of the tiles that large matrices are split into. 512 bits is 64 bytes,
+// i.e., a cache line of each row that a tile reads and writes.
+constexpr std::size_t TILE = 512;
+
+// Number of byte columns in a block.
+constexpr std::size_t BLOCK_BYTES = 16;
+
+// Register i holds byte column REVERSED[i] after transposeBytes. See below.
+constexpr std::size_t REVERSED[16] =
+    {0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15};
+
+// Transpose 16 x 16 bytes in x, so that x[REVERSED[j]] holds byte j of each
+// of the original registers. Each round interleaves pairs of registers, with a
+// unit that doubles from 1 to 8 bytes.
+void transposeBytes(__m128i* x) {
+  __m128i y[16];
+  for (std::size_t i = 0; i < 8; ++i) {
+    y[i] = _mm_unpacklo_epi8(x[2 * i], x[2 * i + 1]);
+    y[i + 8] = _mm_unpackhi_epi8(x[2 * i], x[2 * i + 1]);
+  }
+  for (std::size_t i = 0; i < 8; ++i) {
+    x[i] = _mm_unpacklo_epi16(y[2 * i], y[2 * i + 1]);
+    x[i + 8] = _mm_unpackhi_epi16(y[2 * i], y[2 * i + 1]);
+  }
+  for (std::size_t i = 0; i < 8; ++i) {
+    y[i] = _mm_unpacklo_epi32(x[2 * i], x[2 * i + 1]);
+    y[i + 8] = _mm_unpackhi_epi32(x[2 * i], x[2 * i + 1]);
+  }
+  for (std::size_t i = 0; i < 8; ++i) {
+    x[i] = _mm_unpacklo_epi64(y[2 * i], y[2 * i + 1]);
+    x[i + 8] = _mm_unpackhi_epi64(y[2 * i], y[2 * i + 1]);
+  }
+}
+
+AVX2 void transposeBytes(__m256i* x) {
+  __m256i y[16];
+  for (std::size_t i = 0; i < 8; ++i) {
+    y[i] = _mm256_unpacklo_epi8(x[2 * i], x[2 * i + 1]);
+    y[i + 8] = _mm256_unpackhi_epi8(x[2 * i], x[2 * i + 1]);
+  }
+  for (std::size_t i = 0; i < 8; ++i) {
+    x[i] = _mm256_unpacklo_epi16(y[2 * i], y[2 * i + 1]);
+    x[i + 8] = _mm256_unpackhi_epi16(y[2 * i], y[2 * i + 1]);
+  }
+  for (std::size_t i = 0; i < 8; ++i) {
+    y[i] = _mm256_unpacklo_epi32(x[2 * i], x[2 * i + 1]);
+    y[i + 8] = _mm256_unpackhi_epi32(x[2 * i], x[2 * i + 1]);
+  }
+  for (std::size_t i = 0; i < 8; ++i) {
+    x[i] = _mm256_unpacklo_epi64(y[2 * i], y[2 * i + 1]);
+    x[i + 8] = _mm256_unpackhi_epi64(y[2 * i], y[2 * i + 1]);
+  }
+}
+
+// Arguments shared by the kernels below.
+struct Matrix {
+  const unsigned char* in;
+  std::size_t in_stride;
+  unsigned char* out;
+  std::size_t out_stride;
+
+  const unsigned char* row(std::size_t r, std::size_t byte) const {
+    return in + r * in_stride + byte;
+  }
+
+  unsigned char* column(std::size_t c, std::size_t r) const {
+    return out + c * out_stride + r / 8;
+  }
+};
+
+// Transpose rows [r, r + 16) and byte columns [c, c + 16).
+void block16(const Matrix& m, std::size_t r, std::size_t c) {
+  __m128i x[16];
+  for (std::size_t i = 0; i < 16; ++i) {
+    x[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m.row(r + i, c)));
+  }
+  transposeBytes(x);
+
+  for (std::size_t i = 0; i < 16; ++i) {
+    const auto col = 8 * (c + REVERSED[i]);
+    auto v = x[i];
+    for (std::size_t b = 8; b-- > 0;) {
+      const auto bits = static_cast<std::uint16_t>(_mm_movemask_epi8(v));
+      std::memcpy(m.column(col + b, r), &bits, sizeof(bits));
+      v = _mm_slli_epi64(v, 1);
+    }
+  }
+}
+
+// Transpose rows [r, r + 32) and byte columns [c, c + 16). The lower lanes
+// hold the first 16 rows and the upper lanes the last 16.
+AVX2 void block32(const Matrix& m, std::size_t r, std::size_t c) {
+  __m256i x[16];
+  for (std::size_t i = 0; i < 16; ++i) {
+    const auto* lo = reinterpret_cast<const __m128i*>(m.row(r + i, c));
+    const auto* hi = reinterpret_cast<const __m128i*>(m.row(r + i + 16, c));
+    x[i] = _mm256_set_m128i(_mm_loadu_si128(hi), _mm_loadu_si128(lo));
+  }
+  transposeBytes(x);
+
+  for (std::size_t i = 0; i < 16; ++i) {
+    const auto col = 8 * (c + REVERSED[i]);
+    auto v = x[i];
+    for (std::size_t b = 8; b-- > 0;) {
+      const auto bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(v));
+      std::memcpy(m.column(col + b, r), &bits, sizeof(bits));
+      v = _mm256_slli_epi64(v, 1);
+    }
+  }
+}
+
+// Transpose rows [r, r + 16) and a single byte column c.
+void gather16(const Matrix& m, std::size_t r, std::size_t c) {
+  alignas(16) unsigned char column[16];
+  for (std::size_t i = 0; i < 16; ++i) {
+    column[i] = *m.row(r + i, c);
+  }
+
+  auto v = _mm_load_si128(reinterpret_cast<const __m128i*>(column));
+  for (std::size_t b = 8; b-- > 0;) {
+    const auto bits = static_cast<std::uint16_t>(_mm_movemask_epi8(v));
+    std::memcpy(m.column(8 * c + b, r), &bits, sizeof(bits));
+    v = _mm_slli_epi64(v, 1);
+  }
+}
+
+// Transpose rows [r0, r1) and columns [c0, c1) one bit at a time. r0 must be
+// a multiple of 8.
+void scalar(const Matrix& m,
+            std::size_t r0,
+            std::size_t r1,
+            std::size_t c0,
+            std::size_t c1) {
+  for (std::size_t c = c0; c < c1; ++c) {
+    for (std::size_t r = r0; r < r1; r += 8) {
+      unsigned char byte = 0;
+      for (std::size_t i = 0; i < std::min<std::size_t>(8, r1 - r); ++i) {
+        const auto bit = (*m.row(r + i, c / 8) >> (c % 8)) & 1;
+        byte |= static_cast<unsigned char>(bit << i);
+      }
+      *m.column(c, r) = byte;
+    }
+  }
+}
+
+// Apply a block kernel to rows [r0, r1) and byte columns [0, bytes), tile by
+// tile. r1 - r0 must be a multiple of STEP and bytes a multiple of 16.
+template <std::size_t STEP, typename KERNEL>
+void tiled(const Matrix& m,
+           std::size_t r0,
+           std::size_t r1,
+           std::size_t bytes,
+           KERNEL kernel) {
+  for (std::size_t rt = r0; rt < r1; rt += TILE) {
+    const auto rt_end = std::min(r1, rt + TILE);
+    for (std::size_t ct = 0; ct < bytes; ct += TILE / 8) {
+      const auto ct_end = std::min(bytes, ct + TILE / 8);
+      for (std::size_t r = rt; r < rt_end; r += STEP) {
+        for (std::size_t c = ct; c < ct_end; c += BLOCK_BYTES) {
+          kernel(m, r, c);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void util::transposeBits(const unsigned char* in,
+                         std::size_t in_stride,
+                         unsigned char* out,
+                         std::size_t out_stride,
+                         std::size_t rows,
+                         std::size_t cols) {
+  const Matrix m{in, in_stride, out, out_stride};
+
+  // rows [0, rows16) and byte columns [0, blocks) are handled by the block
+  // kernels, and rows [0, rows32) by the AVX2 kernel if it is available.
+  const auto rows16 = rows / 16 * 16;
+  const auto rows32 = cpu::features().avx2 ? rows / 32 * 32 : 0;
+  const auto bytes = cols / 8;
+  const auto blocks = bytes / BLOCK_BYTES * BLOCK_BYTES;
+
+  tiled<32>(m, 0, rows32, blocks, block32);
+  tiled<16>(m, rows32, rows16, blocks, block16);
+
+  for (std::size_t r = 0; r < rows16; r += 16) {
+    for (std::size_t c = blocks; c < bytes; ++c) {
+      gather16(m, r, c);
+    }
+  }
+
+  scalar(m, 0, rows16, 8 * bytes, cols);
+  scalar(m, rows16, rows, 0, cols);
+}
+
+std::vector<util::Bitmap> util::transposeBits(const std::vector<Bitmap>& rows) {
+  if (rows.empty()) {
+    return {};
+  }
+
+  const auto cols = rows.front().size();
+  for (const auto& row : rows) {
+    if (row.size() != cols) {
+      throw std::invalid_argument("rows must have the same size");
+    }
+  }
+
+  // the rows are not contiguous, so they are copied to and from buffers.
+  const auto in_stride =
+      rows.front().numberOfBlocks() * sizeof(Bitmap::BlockType);
+  const auto out_stride = (rows.size() + 7) / 8;
+  std::vector<unsigned char> in(rows.size() * in_stride);
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    std::memcpy(in.data() + i * in_stride, rows[i].data(), in_stride);
+  }
+  std::vector<unsigned char> out(cols * out_stride);
+
+  transposeBits(in.data(),
+                in_stride,
+                out.data(),
+                out_stride,
+                rows.size(),
+                cols);
+
+  std::vector<Bitmap> columns;
+  columns.reserve(cols);
+  for (std::size_t c = 0; c < cols; ++c) {
+    auto& column = columns.emplace_back(rows.size());
+    std::memcpy(column.data(), out.data() + c * out_stride, out_stride);
+  }
+  return columns;
+}
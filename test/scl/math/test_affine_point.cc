@@ -0,0 +1,140 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_exception.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "scl/math/affine_point.h"
+#include "scl/math/curves/secp256k1.h"
+#include "scl/math/ec.h"
+#include "scl/math/vector.h"
+#include "scl/serialization/serializer.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+using Curve = math::EC<math::ec::Secp256k1>;
+using Affine = math::AffinePoint<math::ec::Secp256k1>;
+using Scalar = Curve::ScalarField;
+
+namespace {
+
+Curve randomPoint(util::PRG& prg) {
+  return Curve::generator() * Scalar::random(prg);
+}
+
+}  // namespace
+
+TEST_CASE("AffinePoint defs", "[math][ec]") {
+  REQUIRE(Affine::byteSize() == Curve::byteSize(false));
+  REQUIRE(sizeof(Affine) == 2 * sizeof(Curve::Field));
+
+  const Affine inf;
+  REQUIRE(inf.isPointAtInfinity());
+  REQUIRE(inf.toPoint().isPointAtInfinity());
+  REQUIRE(Affine(Curve()) == inf);
+  REQUIRE(inf.toString() == "EC{POINT_AT_INFINITY}");
+
+  const Affine g(Curve::generator());
+  REQUIRE_FALSE(g.isPointAtInfinity());
+  REQUIRE(g.toPoint() == Curve::generator());
+  REQUIRE(g.toString() == Curve::generator().toString());
+  REQUIRE(g != inf);
+
+  REQUIRE(Affine::fromAffine(g.x(), g.y()) == g);
+  REQUIRE_THROWS_MATCHES(
+      Affine::fromAffine(g.x(), g.x()),
+      std::invalid_argument,
+      Catch::Matchers::Message("provided (x, y) not on curve"));
+}
+
+TEST_CASE("AffinePoint addMixed", "[math][ec]") {
+  auto prg = util::PRG::create("test affine add");
+
+  const auto p = randomPoint(prg);
+  const auto q = randomPoint(prg);
+  const Affine qa(q);
+
+  REQUIRE(p + qa == p + q);
+  auto r = p;
+  r += qa;
+  REQUIRE(r == p + q);
+  REQUIRE(Curve(p).addMixed(Affine()) == p);
+
+  // special cases: adding to infinity, doubling and adding the inverse.
+  REQUIRE(Curve() + qa == q);
+  REQUIRE(q + qa == q + q);
+  REQUIRE((-q + qa).isPointAtInfinity());
+}
+
+TEST_CASE("AffinePoint normalize", "[math][ec]") {
+  auto prg = util::PRG::create("test affine normalize");
+
+  std::vector<Curve> points;
+  for (std::size_t i = 0; i < 20; ++i) {
+    points.emplace_back(randomPoint(prg));
+  }
+  points[0] = Curve();
+  points[7] = Curve();
+  points[10] = Curve::generator();
+  points.emplace_back();
+
+  const auto affine = Affine::normalize(points);
+  REQUIRE(affine.size() == points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    REQUIRE(affine[i] == Affine(points[i]));
+    REQUIRE(affine[i].toPoint() == points[i]);
+  }
+
+  REQUIRE(Affine::normalize(math::Vector<Curve>{}).size() == 0);
+  const auto all_inf = Affine::normalize(math::Vector<Curve>(3));
+  REQUIRE(all_inf[2].isPointAtInfinity());
+}
+
+TEST_CASE("AffinePoint serialization", "[math][ec]") {
+  auto prg = util::PRG::create("test affine serialize");
+
+  for (const auto& p : {randomPoint(prg), Curve()}) {
+    const Affine a(p);
+    for (const bool compress : {true, false}) {
+      std::vector<unsigned char> expected(Curve::byteSize(compress));
+      std::vector<unsigned char> actual(Curve::byteSize(compress));
+      p.write(expected.data(), compress);
+      a.write(actual.data(), compress);
+      REQUIRE(actual == expected);
+    }
+
+    using Seri = seri::Serializer<Affine>;
+    std::vector<unsigned char> buf(Seri::sizeOf(a));
+    REQUIRE(Seri::write(a, buf.data()) == Affine::byteSize());
+    Affine b;
+    REQUIRE(Seri::read(b, buf.data()) == Affine::byteSize());
+    REQUIRE(a == b);
+    REQUIRE(Affine::read(buf.data()) == a);
+  }
+
+  const auto v = Affine::normalize({randomPoint(prg), randomPoint(prg)});
+  REQUIRE(v.byteSize() == 2 * Affine::byteSize());
+  using SeriV = seri::Serializer<math::Vector<Affine>>;
+  std::vector<unsigned char> buf(SeriV::sizeOf(v));
+  SeriV::write(v, buf.data());
+  math::Vector<Affine> w;
+  SeriV::read(w, buf.data());
+  REQUIRE(w == v);
+}
@@ -0,0 +1,149 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_exception.hpp>
+#include <stdexcept>
+#include <utility>
+
+#include "scl/math/array.h"
+#include "scl/math/array_vector.h"
+#include "scl/math/fp.h"
+#include "scl/math/vector.h"
+#include "scl/net/packet.h"
+#include "scl/util/arena.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+using FF = math::Fp<61>;
+using Arr = math::Array<FF, 2>;
+using AoS = math::Vector<Arr>;
+using SoA = math::ArrayVector<FF, 2>;
+
+}  // namespace
+
+TEST_CASE("ArrayVector construct", "[math]") {
+  const SoA empty;
+  REQUIRE(empty.empty());
+
+  SoA v(3);
+  REQUIRE(v.size() == 3);
+  REQUIRE(v[0] == Arr::zero());
+
+  v[1] = Arr({FF(1), FF(2)});
+  v[2][1] = FF(5);
+  REQUIRE(v[1] == Arr({FF(1), FF(2)}));
+  REQUIRE(std::as_const(v)[2] == Arr({FF(0), FF(5)}));
+  REQUIRE(v.lane(0) == math::Vector<FF>{FF(0), FF(1), FF(0)});
+  REQUIRE(v.lane(1) == math::Vector<FF>{FF(0), FF(2), FF(5)});
+
+  v[0] = v[1];
+  v[0] += Arr(FF(1));
+  v[2] -= Arr(FF(1));
+  REQUIRE(v[0] == Arr({FF(2), FF(3)}));
+  REQUIRE(v[2] == Arr({FF(-1), FF(4)}));
+  const Arr a = v[0];
+  REQUIRE(a == Arr({FF(2), FF(3)}));
+
+  const SoA lanes({math::Vector<FF>{FF(1), FF(2)},
+                   math::Vector<FF>{FF(3), FF(4)}});
+  REQUIRE(lanes[1] == Arr({FF(2), FF(4)}));
+
+  REQUIRE_THROWS_MATCHES(
+      SoA({math::Vector<FF>{FF(1), FF(2)}, math::Vector<FF>{FF(3)}}),
+      std::invalid_argument,
+      Catch::Matchers::Message("lanes must have the same size"));
+}
+
+TEST_CASE("ArrayVector matches Vector of Arrays", "[math]") {
+  auto prg0 = util::PRG::create("test_array_vector");
+  auto prg1 = util::PRG::create("test_array_vector");
+  const auto x = SoA::random(10, prg0);
+  const auto y = SoA::random(10, prg0);
+  const auto xa = AoS::random(10, prg1);
+  const auto ya = AoS::random(10, prg1);
+
+  REQUIRE(x.toVector() == xa);
+  REQUIRE(SoA(xa) == x);
+  REQUIRE(x.toString() == xa.toString());
+  REQUIRE(x.byteSize() == xa.byteSize());
+
+  REQUIRE(x.add(y).toVector() == xa.add(ya));
+  REQUIRE(x.subtract(y).toVector() == xa.subtract(ya));
+  REQUIRE(x.multiplyEntryWise(y).toVector() == xa.multiplyEntryWise(ya));
+  REQUIRE(x.dot(y) == xa.dot(ya));
+  REQUIRE(x.sum() == xa.sum());
+  REQUIRE(x.scalarMultiply(FF(7)).toVector() == xa.scalarMultiply(FF(7)));
+  REQUIRE(x.subVector(2, 5).toVector() == xa.subVector(2, 5));
+  REQUIRE(x.subVector(3) == x.subVector(0, 3));
+
+  const Arr s({FF(3), FF(4)});
+  const auto xs = x.scalarMultiply(s);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    REQUIRE(xs[i] == Arr({x[i][0] * FF(3), x[i][1] * FF(4)}));
+  }
+
+  auto z = x;
+  z.addInPlace(y).multiplyEntryWiseInPlace(y).subtractInPlace(x);
+  REQUIRE(z.toVector() == xa.add(ya).multiplyEntryWise(ya).subtract(xa));
+  z.scalarMultiplyInPlace(FF(2)).scalarMultiplyInPlace(s);
+  REQUIRE(z.toVector() == xa.add(ya)
+                              .multiplyEntryWise(ya)
+                              .subtract(xa)
+                              .scalarMultiply(FF(2))
+                              .multiplyEntryWise(AoS(std::vector<Arr>(10, s))));
+
+  REQUIRE(x != y);
+  REQUIRE_THROWS_MATCHES(x.add(y.subVector(3)),
+                         std::invalid_argument,
+                         Catch::Matchers::Message("Vec sizes mismatch"));
+}
+
+TEST_CASE("ArrayVector serialization", "[math]") {
+  auto prg = util::PRG::create("test_array_vector serialization");
+  const auto x = SoA::random(20, prg);
+
+  net::Packet packet;
+  packet << x;
+  packet << x.toVector();
+  REQUIRE(packet.size() == 2 * seri::Serializer<SoA>::sizeOf(x));
+
+  // the two are written in the same format.
+  const auto y = packet.read<AoS>();
+  const auto z = packet.read<SoA>();
+  REQUIRE(y == x.toVector());
+  REQUIRE(z == x);
+}
+
+TEST_CASE("ArrayVector memory resource", "[math]") {
+  util::Arena arena;
+  auto prg = util::PRG::create("test_array_vector arena");
+
+  const auto x = SoA::random(5, prg, &arena);
+  const auto y = SoA::random(5, prg);
+  REQUIRE(x.resource() == &arena);
+  REQUIRE(x.lane(1).resource() == &arena);
+  REQUIRE(y.resource() == std::pmr::get_default_resource());
+  REQUIRE(x.add(y).resource() == &arena);
+  REQUIRE(x.subVector(2).lane(1).resource() == &arena);
+  REQUIRE(SoA(y, &arena).resource() == &arena);
+  REQUIRE(SoA(x).resource() == std::pmr::get_default_resource());
+}
@@ -367,3 +367,70 @@ TEST_CASE("Number RSA example", "[math]") {
   const auto ptxt = math::modExp(ctxt, d, n);
   REQUIRE(ptxt == msg);
 }
+
+TEST_CASE("Number move", "[math]") {
+  auto prg = util::PRG::create("Number move");
+  const auto x = Number::random(300, prg);
+
+  Number y(x);
+  Number z(std::move(y));
+  REQUIRE(z == x);
+  // moved-from numbers are 0 and can be reused.
+  REQUIRE(y == Number(0));
+  y = Number(5);
+  REQUIRE(y == Number(5));
+
+  Number w;
+  w = std::move(z);
+  REQUIRE(w == x);
+
+  // operators on temporaries reuse the temporary.
+  REQUIRE(Number(x) + x == x + x);
+  REQUIRE(Number(x) - Number(1) == x - Number(1));
+  REQUIRE(Number(x) * x == x * x);
+  REQUIRE((x * x) % Number(1000) == Number(x * x) % Number(1000));
+}
+
+TEST_CASE("Number in-place operations", "[math]") {
+  auto prg = util::PRG::create("Number in-place operations");
+  REPEAT {
+    const auto a = Number::random(200, prg);
+    const auto b = Number::random(200, prg);
+    const auto m = Number::randomPrime(128, prg);
+
+    Number out;
+    math::add(out, a, b);
+    REQUIRE(out == a + b);
+    math::subtract(out, a, b);
+    REQUIRE(out == a - b);
+    math::multiply(out, a, b);
+    REQUIRE(out == a * b);
+    math::mulMod(out, a, b, m);
+    REQUIRE(out == (a * b) % m);
+    math::modExp(out, a, b * b, m);
+    REQUIRE(out == math::modExp(a, b * b, m));
+
+    // output aliasing an input.
+    auto c = a;
+    math::add(c, c, b);
+    REQUIRE(c == a + b);
+    c = a;
+    math::mulMod(c, c, c, m);
+    REQUIRE(c == (a * a) % m);
+    c = a;
+    math::modExp(c, c, Number(3), m);
+    REQUIRE(c == (a * a * a) % m);
+  }
+}
+
+TEST_CASE("Number reserve", "[math]") {
+  Number x(1234);
+  x.reserve(1024);
+  REQUIRE(x == Number(1234));
+  x <<= 1000;
+  REQUIRE(x == Number(1234) << 1000);
+  x >>= -8;
+  REQUIRE(x == Number(1234) << 1008);
+  x >>= 1008;
+  REQUIRE(x == Number(1234));
+}
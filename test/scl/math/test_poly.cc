@@ -18,6 +18,8 @@
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_exception.hpp>
+#include <array>
+#include <span>
 #include <stdexcept>
 
 #include "../math/fields.h"
@@ -27,6 +29,20 @@
 
 using namespace scl;
 
+namespace {
+
+// Random polynomial of degree n - 1.
+template <typename FF>
+math::Polynomial<FF> randomPolynomial(std::size_t n, util::PRG& prg) {
+  auto c = math::Vector<FF>::random(n, prg);
+  if (c[n - 1] == FF(0)) {
+    c[n - 1] = FF(1);
+  }
+  return math::Polynomial<FF>::create(c);
+}
+
+}  // namespace
+
 TEMPLATE_TEST_CASE("Polynomial construct", "[ss][math]", FIELD_DEFS) {
   using FF = TestType;
 
@@ -180,3 +196,131 @@ TEMPLATE_TEST_CASE("Polynomial division", "[math][ss]", FIELD_DEFS) {
   auto v = b.multiply(qr[0]).add(qr[1]);
   REQUIRE(v == a);
 }
+
+TEMPLATE_TEST_CASE("Polynomial multiplication large",
+                   "[math][ss]",
+                   FIELD_DEFS) {
+  using FF = TestType;
+  auto prg = util::PRG::create("test poly multiply large");
+
+  // balanced and unbalanced operands above the Karatsuba threshold.
+  for (const auto [n, m] : {std::array<std::size_t, 2>{100, 100},
+                            std::array<std::size_t, 2>{77, 64},
+                            std::array<std::size_t, 2>{200, 33},
+                            std::array<std::size_t, 2>{40, 5}}) {
+    const auto p = randomPolynomial<FF>(n, prg);
+    const auto q = randomPolynomial<FF>(m, prg);
+    const auto pq = p.multiply(q);
+    REQUIRE(pq.degree() == p.degree() + q.degree());
+    for (int i = 0; i < 3; ++i) {
+      const auto x = FF::random(prg);
+      REQUIRE(pq.evaluate(x) == p.evaluate(x) * q.evaluate(x));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Polynomial division large", "[math][ss]", FIELD_DEFS) {
+  using FF = TestType;
+  auto prg = util::PRG::create("test poly divide large");
+
+  // small divisor, small quotient and the Newton iteration path.
+  for (const auto [n, m] : {std::array<std::size_t, 2>{300, 10},
+                            std::array<std::size_t, 2>{300, 290},
+                            std::array<std::size_t, 2>{1100, 520}}) {
+    const auto a = randomPolynomial<FF>(n, prg);
+    const auto b = randomPolynomial<FF>(m, prg);
+    const auto qr = a.divide(b);
+    REQUIRE(qr[0].degree() == a.degree() - b.degree());
+    REQUIRE((qr[1].isZero() || qr[1].degree() < b.degree()));
+    REQUIRE(b.multiply(qr[0]).add(qr[1]) == a);
+  }
+
+  const auto a = randomPolynomial<FF>(5, prg);
+  const auto b = randomPolynomial<FF>(9, prg);
+  const auto qr = a.divide(b);
+  REQUIRE(qr[0].isZero());
+  REQUIRE(qr[1] == a);
+}
+
+TEMPLATE_TEST_CASE("PolynomialDivisor", "[math][ss]", FIELD_DEFS) {
+  using FF = TestType;
+  auto prg = util::PRG::create("test poly divisor");
+
+  const auto b = randomPolynomial<FF>(20, prg);
+  const math::PolynomialDivisor<FF> divisor(b, 100);
+  REQUIRE(divisor.divisor() == b);
+  REQUIRE(divisor.maxDegree() == 100);
+
+  for (const std::size_t n : {1, 20, 21, 50, 101}) {
+    const auto a = randomPolynomial<FF>(n, prg);
+    const auto qr = divisor.divide(a);
+    REQUIRE(qr == a.divide(b));
+  }
+
+  // dividing by a constant leaves no remainder.
+  const math::PolynomialDivisor<FF> constant(math::Polynomial<FF>(FF(3)), 10);
+  const auto a = randomPolynomial<FF>(10, prg);
+  const auto qr = constant.divide(a);
+  REQUIRE(qr[1].isZero());
+  REQUIRE(qr[0].multiply(FF(3)) == a);
+
+  const auto too_large =
+      randomPolynomial<FF>(102, prg);
+  REQUIRE_THROWS_MATCHES(divisor.divide(too_large),
+                         std::invalid_argument,
+                         Catch::Matchers::Message("dividend degree too large"));
+  REQUIRE_THROWS_MATCHES(
+      math::PolynomialDivisor<FF>(math::Polynomial<FF>(), 10),
+      std::invalid_argument,
+      Catch::Matchers::Message("division by 0"));
+}
+
+TEMPLATE_TEST_CASE("Polynomial in-place arithmetic",
+                   "[math][ss]",
+                   FIELD_DEFS) {
+  using FF = TestType;
+  auto prg = util::PRG::create("test poly in-place");
+
+  const auto p = randomPolynomial<FF>(10, prg);
+  const auto q = randomPolynomial<FF>(5, prg);
+
+  auto r = p;
+  REQUIRE(r.addInPlace(q) == p.add(q));
+  REQUIRE(r.subtractInPlace(q) == p);
+  REQUIRE(r.subtractInPlace(p).isZero());
+  REQUIRE(r.degree() == 0);
+  REQUIRE(r.addInPlace(p) == p);
+
+  // leading terms that cancel are removed.
+  auto s = q;
+  s.subtractInPlace(q.add(FF(1)));
+  REQUIRE(s == math::Polynomial<FF>(-FF(1)));
+
+  REQUIRE(p.scalarMultiply(FF(2)) == p.add(p));
+  REQUIRE(p.scalarMultiply(FF(0)).isZero());
+  auto t = q;
+  REQUIRE(t.scalarMultiplyInPlace(FF(3)) == q.add(q).add(q));
+
+  math::Polynomial<FF> out;
+  REQUIRE(p.multiplyInto(out, q) == p.multiply(q));
+  REQUIRE(q.multiplyInto(out, q) == q.multiply(q));
+  auto u = p;
+  REQUIRE(u.multiplyInto(u, q) == p.multiply(q));
+  auto v = q;
+  REQUIRE(p.multiplyInto(v, v) == p.multiply(q));
+  REQUIRE(p.multiplyInto(out, math::Polynomial<FF>()).isZero());
+}
+
+TEMPLATE_TEST_CASE("Polynomial evaluate span", "[math][ss]", FIELD_DEFS) {
+  using FF = TestType;
+  auto prg = util::PRG::create("test poly evaluate span");
+
+  const auto c = math::Vector<FF>::random(8, prg);
+  const auto x = FF::random(prg);
+  const std::span<const FF> span(c.data(), c.size());
+  REQUIRE(math::evaluatePolynomial(span, x) ==
+          math::Polynomial<FF>::create(c).evaluate(x));
+  REQUIRE(math::evaluatePolynomial(span.subspan(0, 3), x) ==
+          c[0] + c[1] * x + c[2] * x * x);
+  REQUIRE(math::evaluatePolynomial(span.subspan(0, 0), x) == FF(0));
+}
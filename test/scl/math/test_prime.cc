@@ -0,0 +1,143 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "scl/math/number.h"
+#include "scl/math/prime.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+using Number = math::Number;
+
+namespace {
+
+const auto M61 = (Number(1) << 61) - Number(1);
+const auto M127 = (Number(1) << 127) - Number(1);
+
+std::vector<unsigned char> bytes(util::PRG& prg) {
+  std::vector<unsigned char> buf(16);
+  prg.next(buf);
+  return buf;
+}
+
+}  // namespace
+
+TEST_CASE("Prime isProbablePrime", "[math]") {
+  auto prg = util::PRG::create("test isProbablePrime");
+
+  REQUIRE_FALSE(math::isProbablePrime(Number(-7), prg));
+  REQUIRE_FALSE(math::isProbablePrime(Number(0), prg));
+  REQUIRE_FALSE(math::isProbablePrime(Number(1), prg));
+  REQUIRE(math::isProbablePrime(Number(2), prg));
+  REQUIRE(math::isProbablePrime(Number(3), prg));
+  REQUIRE_FALSE(math::isProbablePrime(Number(4), prg));
+  REQUIRE(math::isProbablePrime(Number(32749), prg));
+  REQUIRE(math::isProbablePrime(Number(65537), prg));
+
+  // Carmichael numbers.
+  REQUIRE_FALSE(math::isProbablePrime(Number(561), prg));
+  REQUIRE_FALSE(math::isProbablePrime(Number(41041), prg));
+
+  REQUIRE(math::isProbablePrime(M61, prg));
+  REQUIRE(math::isProbablePrime(M127, prg));
+  REQUIRE(math::isProbablePrime(M127, prg, 1));
+  REQUIRE_FALSE(math::isProbablePrime(M61 * M127, prg));
+  REQUIRE_FALSE(math::isProbablePrime(M61 * M61, prg));
+}
+
+TEST_CASE("Prime generatePrime", "[math]") {
+  auto prg = util::PRG::create("test generatePrime");
+  for (const std::size_t bits : {32, 33, 64, 100, 256, 521}) {
+    const auto p = math::generatePrime(bits, prg, 1);
+    REQUIRE(p.bitSize() == bits);
+    REQUIRE(p.testBit(bits - 2));
+    REQUIRE(math::isProbablePrime(p, prg));
+  }
+
+  REQUIRE_THROWS_MATCHES(math::generatePrime(31, prg),
+                         std::invalid_argument,
+                         Catch::Matchers::Message(
+                             "primes must be at least 32 bits"));
+}
+
+TEST_CASE("Prime generatePrime deterministic", "[math]") {
+  auto prg0 = util::PRG::create("test generatePrime deterministic");
+  auto prg1 = util::PRG::create("test generatePrime deterministic");
+  REQUIRE(math::generatePrime(256, prg0, 1) ==
+          math::generatePrime(256, prg1, 1));
+
+  // the default uses a single thread, so it is deterministic too.
+  REQUIRE(math::generatePrime(256, prg0) == math::generatePrime(256, prg1));
+  REQUIRE(math::generateSafePrime(64, prg0) ==
+          math::generateSafePrime(64, prg1));
+  REQUIRE(math::generateRSAModulus(128, prg0).n ==
+          math::generateRSAModulus(128, prg1).n);
+  REQUIRE(bytes(prg0) == bytes(prg1));
+}
+
+TEST_CASE("Prime generatePrime threads", "[math]") {
+  auto prg = util::PRG::create("test generatePrime threads");
+  const auto p = math::generatePrime(512, prg, 4);
+  REQUIRE(p.bitSize() == 512);
+  REQUIRE(math::isProbablePrime(p, prg));
+}
+
+TEST_CASE("Prime generateSafePrime", "[math]") {
+  auto prg = util::PRG::create("test generateSafePrime");
+  for (const std::size_t threads : {1, 2}) {
+    const auto p = math::generateSafePrime(128, prg, threads);
+    REQUIRE(p.bitSize() == 128);
+    REQUIRE(math::isProbablePrime(p, prg));
+    REQUIRE(math::isProbablePrime(p >> 1, prg));
+  }
+}
+
+TEST_CASE("Prime generateRSAModulus", "[math]") {
+  auto prg = util::PRG::create("test generateRSAModulus");
+  for (const std::size_t bits : {64, 511, 1024}) {
+    const auto [n, p, q] = math::generateRSAModulus(bits, prg);
+    REQUIRE(n.bitSize() == bits);
+    REQUIRE(n == p * q);
+    REQUIRE(p != q);
+    REQUIRE(math::isProbablePrime(p, prg));
+    REQUIRE(math::isProbablePrime(q, prg));
+  }
+
+  REQUIRE_THROWS_MATCHES(math::generateRSAModulus(63, prg),
+                         std::invalid_argument,
+                         Catch::Matchers::Message(
+                             "RSA modulus must be at least 64 bits"));
+}
+
+TEST_CASE("Prime PRG fork", "[math][util]") {
+  auto prg0 = util::PRG::create("test fork");
+  auto prg1 = util::PRG::create("test fork");
+  auto f0 = prg0.fork();
+  auto f1 = prg1.fork();
+
+  // forking is deterministic and advances the parent.
+  REQUIRE(bytes(f0) == bytes(f1));
+  REQUIRE(bytes(prg0) == bytes(prg1));
+  auto f2 = prg0.fork();
+  auto f3 = prg0.fork();
+  REQUIRE(bytes(f2) != bytes(f3));
+}
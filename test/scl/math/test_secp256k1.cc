@@ -202,6 +202,35 @@ TEST_CASE("Secp256k1 scalar multiplication", "[math][ec]") {
   REQUIRE(n * G == G * n);
 }
 
+TEST_CASE("Secp256k1 scalar multiplication small scalars", "[math][ec]") {
+  auto prg = util::PRG::create("Secp256k1 scalar-mul small");
+
+  // scalar multiplication uses its own formulas internally, so compare it with
+  // repeated addition for both affine and non-affine points.
+  auto affine = randomPoint(prg);
+  affine.normalize();
+  for (const auto& p : {Curve::generator(), randomPoint(prg), affine}) {
+    Curve expected;
+    for (int k = 0; k < 20; ++k) {
+      REQUIRE(p * Scalar(k) == expected);
+      REQUIRE(p * math::Number(k) == expected);
+      REQUIRE(p * Scalar(-k) == -expected);
+      expected += p;
+    }
+  }
+
+  const auto g2 = Curve::generator() * Scalar(2);
+  REQUIRE(g2.toString() ==
+          "EC{"
+          "c6047f9441ed7d6d3045406e95c07cd85c778e4b8cef3ca7abac09b95c709ee5, "
+          "1ae168fea63dc339a3c58419466ceaeef7f632653266d0e1236431a950cfe52a}");
+
+  // the last addition is P + (-P) for both kinds of scalars.
+  const auto ord = math::order<Scalar>();
+  REQUIRE((randomPoint(prg) * ord).isPointAtInfinity());
+  REQUIRE((affine * ord).isPointAtInfinity());
+}
+
 TEST_CASE("Secp256k1 negation special case", "[math][ec]") {
   Curve P;
   P.negate();
@@ -118,7 +118,7 @@ TEST_CASE("Vector incompatible", "[math][la]") {
 }
 
 TEST_CASE("Vector to std::vector", "[math][la]") {
-  auto stl0 = v0.toStlVector();
+  auto stl0 = v0.toStdVector();
   REQUIRE(stl0 == std::vector<FF>{FF(1), FF(2), FF(3)});
 }
 
@@ -204,3 +204,56 @@ TEST_CASE("Z2k truncation", "[math]") {
   REQUIRE(c == a);
   REQUIRE(c == b);
 }
+
+TEST_CASE("Z2k storage size", "[math][ring]") {
+  REQUIRE(sizeof(math::Z2k<1>) == 1);
+  REQUIRE(sizeof(math::Z2k<8>) == 1);
+  REQUIRE(sizeof(math::Z2k<12>) == 2);
+  REQUIRE(sizeof(math::Z2k<32>) == 4);
+  REQUIRE(sizeof(math::Z2k<33>) == 8);
+  REQUIRE(sizeof(math::Z2k<64>) == 8);
+  REQUIRE(sizeof(math::Z2k<65>) == 16);
+}
+
+TEMPLATE_TEST_CASE("Z2k narrow",
+                   "[math][ring]",
+                   math::Z2k<5>,
+                   math::Z2k<8>,
+                   math::Z2k<12>,
+                   math::Z2k<16>,
+                   math::Z2k<32>) {
+  using Ring = TestType;
+  using Wide = math::Z2k<64>;
+  auto prg = util::PRG::create("Z2k narrow");
+
+  // results must agree with arithmetic modulo 2^64 reduced modulo 2^K.
+  const auto reduce = [](const Wide& w) {
+    unsigned char buf[Wide::byteSize()];
+    w.write(buf);
+    return Ring::read(buf);
+  };
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    unsigned char buf_a[Wide::byteSize()] = {0};
+    unsigned char buf_b[Wide::byteSize()] = {0};
+    prg.next(buf_a, Ring::byteSize());
+    prg.next(buf_b, Ring::byteSize());
+    const auto a = Ring::read(buf_a);
+    const auto b = Ring::read(buf_b);
+    const auto wa = Wide::read(buf_a);
+    const auto wb = Wide::read(buf_b);
+
+    REQUIRE(a + b == reduce(wa + wb));
+    REQUIRE(a - b == reduce(wa - wb));
+    REQUIRE(a * b == reduce(wa * wb));
+    REQUIRE(-a == reduce(-wa));
+    if (a.lsb() == 1) {
+      REQUIRE(a.inverse() == reduce(wa.inverse()));
+      REQUIRE(a * a.inverse() == Ring::one());
+    }
+  }
+
+  REQUIRE(Ring(-1) + Ring(1) == Ring::zero());
+  // 8-bit values must not be printed as characters.
+  REQUIRE(Ring(0x1b).toString() == "1b");
+}
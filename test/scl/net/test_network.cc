@@ -79,3 +79,62 @@ TEST_CASE("Network TCP", "[net]") {
   auto w = rt->run(recv(networks[0].party(2)));
   REQUIRE(w == 456);
 }
+
+namespace {
+
+coro::Task<std::vector<net::Network>> connect2(std::size_t port_base) {
+  std::vector<coro::Task<net::Network>> networks;
+  auto conf0 = net::NetworkConfig::localhost(0, 2, port_base);
+  networks.emplace_back(net::Network::create(conf0));
+
+  auto conf1 = net::NetworkConfig::localhost(1, 2, port_base);
+  networks.emplace_back(net::Network::create(conf1));
+
+  co_return co_await coro::batch(std::move(networks));
+}
+
+coro::Task<std::size_t> sendLarge(net::Channel* channel, std::size_t size) {
+  net::Packet p(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    p << static_cast<unsigned char>(i);
+  }
+  co_await channel->send(p);
+  co_return size;
+}
+
+coro::Task<std::size_t> recvLarge(net::Channel* channel) {
+  net::Packet p = co_await channel->recv();
+  for (std::size_t i = 0; i < p.size(); ++i) {
+    if (p.get()[i] != static_cast<unsigned char>(i)) {
+      co_return 0;
+    }
+  }
+  co_return p.size();
+}
+
+coro::Task<std::vector<std::size_t>> exchangeLarge(net::Network& sender,
+                                                   net::Network& receiver,
+                                                   std::size_t size) {
+  std::vector<coro::Task<std::size_t>> tasks;
+  tasks.emplace_back(sendLarge(sender.party(1), size));
+  tasks.emplace_back(recvLarge(receiver.party(0)));
+  co_return co_await coro::batch(std::move(tasks));
+}
+
+}  // namespace
+
+TEST_CASE("Network TCP large packet", "[net]") {
+  auto rt = coro::DefaultRuntime::create();
+
+  // large enough that writes block because the socket buffers fill up.
+  const std::size_t size = 16 * 1024 * 1024;
+
+  auto networks = rt->run(connect2(DEFAULT_PORT_OFFSET + 10));
+  auto sizes = rt->run(exchangeLarge(networks[0], networks[1], size));
+
+  REQUIRE(sizes[0] == size);
+  REQUIRE(sizes[1] == size);
+
+  networks[0].close();
+  networks[1].close();
+}
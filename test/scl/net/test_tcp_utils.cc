@@ -0,0 +1,73 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cerrno>
+#include <system_error>
+
+#include "scl/net/sys_iface.h"
+#include "scl/net/tcp_utils.h"
+
+using namespace scl;
+
+namespace {
+
+// System calls for a socket whose connect fails with the error in error_code.
+struct FailingConnect : net::details::SysIFace {
+  static inline int error_code = 0;
+  static inline int closed = -1;
+
+  static int getError() {
+    return error_code;
+  }
+
+  static int socket(int /* domain */, int /* type */, int /* protocol */) {
+    return 42;
+  }
+
+  static int connect(int /* sockfd */,
+                     const struct sockaddr* /* addr */,
+                     socklen_t /* addrlen */) {
+    return -1;
+  }
+
+  static int close(int fd) {
+    closed = fd;
+    return 0;
+  }
+};
+
+}  // namespace
+
+TEST_CASE("TCP connect refused", "[net]") {
+  FailingConnect::error_code = ECONNREFUSED;
+  FailingConnect::closed = -1;
+
+  const auto s =
+      net::details::connectAsClient<FailingConnect>("127.0.0.1", 1234);
+  REQUIRE(s == -1);
+  REQUIRE(FailingConnect::closed == 42);
+}
+
+TEST_CASE("TCP connect error", "[net]") {
+  FailingConnect::error_code = ENETUNREACH;
+  FailingConnect::closed = -1;
+
+  REQUIRE_THROWS_AS(
+      net::details::connectAsClient<FailingConnect>("127.0.0.1", 1234),
+      std::system_error);
+}
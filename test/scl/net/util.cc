@@ -17,6 +17,12 @@
 
 #include "util.h"
 
+#include <memory>
+#include <utility>
+
+#include "scl/coro/batch.h"
+#include "scl/net/loopback.h"
+
 using namespace scl;
 
 int test_port = SCL_DEFAULT_TEST_PORT;
@@ -31,3 +37,27 @@ bool test::bufferEquals(const unsigned char* a, const unsigned char* b, int n) {
   }
   return n < 0;
 }
+
+std::vector<net::Network> test::createLoopbackNetworks(std::size_t n) {
+  // channels[i][j] is the channel party i uses to talk to party j.
+  std::vector<std::vector<std::shared_ptr<net::Channel>>> channels(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    channels[i].resize(n);
+    channels[i][i] = net::LoopbackChannel::create();
+    for (std::size_t j = 0; j < i; ++j) {
+      auto paired = net::LoopbackChannel::createPaired();
+      channels[j][i] = paired[0];
+      channels[i][j] = paired[1];
+    }
+  }
+
+  std::vector<net::Network> networks;
+  for (std::size_t i = 0; i < n; ++i) {
+    networks.emplace_back(channels[i], i);
+  }
+  return networks;
+}
+
+coro::Task<void> test::runAll(std::vector<coro::Task<void>> tasks) {
+  co_await coro::batch(std::move(tasks));
+}
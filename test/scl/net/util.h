@@ -18,6 +18,12 @@
 #ifndef TEST_SCL_NET_UTIL_H
 #define TEST_SCL_NET_UTIL_H
 
+#include <cstddef>
+#include <vector>
+
+#include "scl/coro/task.h"
+#include "scl/net/network.h"
+
 namespace scl::test {
 
 /**
@@ -42,6 +48,12 @@ int getPort();
  */
 bool bufferEquals(const unsigned char* a, const unsigned char* b, int n);
 
+// Fully connected networks for n parties, using loopback channels.
+std::vector<net::Network> createLoopbackNetworks(std::size_t n);
+
+// Run a number of tasks to completion, e.g., one per party.
+coro::Task<void> runAll(std::vector<coro::Task<void>> tasks);
+
 }  // namespace scl::test
 
 #endif  // TEST_SCL_NET_UTIL_H
@@ -0,0 +1,262 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "../math/fields.h"
+#include "scl/coro/batch.h"
+#include "scl/coro/runtime.h"
+#include "scl/net/loopback.h"
+#include "scl/ot/base_ot.h"
+#include "scl/ot/iknp.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+using Keys = std::vector<std::array<ot::Block, 2>>;
+
+coro::Task<void> both(coro::Task<void> sender, coro::Task<void> receiver) {
+  std::vector<coro::Task<void>> tasks;
+  tasks.emplace_back(std::move(sender));
+  tasks.emplace_back(std::move(receiver));
+  co_await coro::batch(std::move(tasks));
+}
+
+// Run the sender's and the receiver's side of a protocol concurrently.
+void run(coro::Task<void> sender, coro::Task<void> receiver) {
+  auto rt = coro::DefaultRuntime::create();
+  rt->run(both(std::move(sender), std::move(receiver)));
+}
+
+util::Bitmap randomChoices(std::size_t n, util::PRG& prg) {
+  const auto bytes = prg.next(n);
+  util::Bitmap choices(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    choices.set(i, (bytes[i] & 1) == 1);
+  }
+  return choices;
+}
+
+coro::Task<void> baseSend(net::Channel& channel,
+                          std::size_t n,
+                          util::PRG& prg,
+                          Keys& keys) {
+  keys = co_await ot::BaseOT::send(channel, n, prg);
+}
+
+coro::Task<void> baseReceive(net::Channel& channel,
+                             const util::Bitmap& choices,
+                             util::PRG& prg,
+                             std::vector<ot::Block>& keys) {
+  keys = co_await ot::BaseOT::receive(channel, choices, prg);
+}
+
+coro::Task<void> sendRandom(ot::IknpSender& sender,
+                            net::Channel& channel,
+                            std::size_t n,
+                            Keys& keys) {
+  keys = co_await sender.sendRandom(channel, n);
+}
+
+coro::Task<void> receiveRandom(ot::IknpReceiver& receiver,
+                               net::Channel& channel,
+                               const util::Bitmap& choices,
+                               std::vector<ot::Block>& keys) {
+  keys = co_await receiver.receiveRandom(channel, choices);
+}
+
+coro::Task<void> receiveChosen(ot::IknpReceiver& receiver,
+                               net::Channel& channel,
+                               const util::Bitmap& choices,
+                               std::vector<ot::Block>& keys) {
+  keys = co_await receiver.receiveChosen(channel, choices);
+}
+
+template <typename T>
+coro::Task<void> sendCorrelated(ot::IknpSender& sender,
+                                net::Channel& channel,
+                                const math::Vector<T>& deltas,
+                                math::Vector<T>& a) {
+  a = co_await sender.sendCorrelated(channel, deltas);
+}
+
+template <typename T>
+coro::Task<void> receiveCorrelated(ot::IknpReceiver& receiver,
+                                   net::Channel& channel,
+                                   const util::Bitmap& choices,
+                                   math::Vector<T>& b) {
+  b = co_await receiver.template receiveCorrelated<T>(channel, choices);
+}
+
+// A sender and receiver which have run setup.
+struct Extension {
+  std::array<std::shared_ptr<net::Channel>, 2> channels =
+      net::LoopbackChannel::createPaired();
+  ot::IknpSender sender;
+  ot::IknpReceiver receiver;
+
+  Extension() {
+    auto prg0 = util::PRG::create("test iknp sender");
+    auto prg1 = util::PRG::create("test iknp receiver");
+    run(sender.setup(*channels[0], prg0), receiver.setup(*channels[1], prg1));
+  }
+};
+
+}  // namespace
+
+TEST_CASE("OT base OT", "[ot]") {
+  auto channels = net::LoopbackChannel::createPaired();
+  auto prg0 = util::PRG::create("test base ot sender");
+  auto prg1 = util::PRG::create("test base ot receiver");
+  const auto choices = randomChoices(20, prg1);
+
+  Keys sender_keys;
+  std::vector<ot::Block> receiver_keys;
+  run(baseSend(*channels[0], 20, prg0, sender_keys),
+      baseReceive(*channels[1], choices, prg1, receiver_keys));
+
+  REQUIRE(sender_keys.size() == 20);
+  REQUIRE(receiver_keys.size() == 20);
+  for (std::size_t i = 0; i < 20; ++i) {
+    REQUIRE(sender_keys[i][0] != sender_keys[i][1]);
+    REQUIRE(receiver_keys[i] == sender_keys[i][choices.at(i)]);
+  }
+}
+
+TEST_CASE("OT base OT wrong number of OTs", "[ot]") {
+  auto channels = net::LoopbackChannel::createPaired();
+  auto prg = util::PRG::create();
+  Keys sender_keys;
+  std::vector<ot::Block> receiver_keys;
+  REQUIRE_THROWS_MATCHES(
+      run(baseSend(*channels[0], 20, prg, sender_keys),
+          baseReceive(*channels[1], util::Bitmap(19), prg, receiver_keys)),
+      std::runtime_error,
+      Catch::Matchers::Message("unexpected number of base OTs"));
+}
+
+TEST_CASE("OT IKNP random", "[ot]") {
+  Extension ext;
+  auto prg = util::PRG::create("test iknp random");
+
+  Keys previous;
+  for (const std::size_t n : {1, 127, 128, 5000, 10000, 0}) {
+    const auto choices = randomChoices(n, prg);
+    Keys sender_keys;
+    std::vector<ot::Block> receiver_keys;
+    run(sendRandom(ext.sender, *ext.channels[0], n, sender_keys),
+        receiveRandom(ext.receiver, *ext.channels[1], choices, receiver_keys));
+
+    REQUIRE(sender_keys.size() == n);
+    REQUIRE(receiver_keys.size() == n);
+    for (std::size_t i = 0; i < n; ++i) {
+      REQUIRE(sender_keys[i][0] != sender_keys[i][1]);
+      REQUIRE(receiver_keys[i] == sender_keys[i][choices.at(i)]);
+    }
+
+    // keys are fresh in each call.
+    if (!previous.empty() && n > 0) {
+      REQUIRE(previous[0][0] != sender_keys[0][0]);
+    }
+    previous = sender_keys;
+  }
+}
+
+TEST_CASE("OT IKNP chosen", "[ot]") {
+  Extension ext;
+  auto prg = util::PRG::create("test iknp chosen");
+
+  const std::size_t n = 1000;
+  Keys messages(n);
+  for (auto& m : messages) {
+    prg.next(m[0].data(), m[0].size());
+    prg.next(m[1].data(), m[1].size());
+  }
+  const auto choices = randomChoices(n, prg);
+
+  std::vector<ot::Block> received;
+  run(ext.sender.sendChosen(*ext.channels[0], messages),
+      receiveChosen(ext.receiver, *ext.channels[1], choices, received));
+
+  REQUIRE(received.size() == n);
+  for (std::size_t i = 0; i < n; ++i) {
+    REQUIRE(received[i] == messages[i][choices.at(i)]);
+  }
+}
+
+TEMPLATE_TEST_CASE("OT IKNP correlated",
+                   "[ot]",
+                   test::Mersenne61,
+                   test::GF7,
+                   test::Secp256k1_Order) {
+  using T = TestType;
+  Extension ext;
+  auto prg = util::PRG::create("test iknp correlated");
+
+  const std::size_t n = 300;
+  const auto deltas = math::Vector<T>::random(n, prg);
+  const auto choices = randomChoices(n, prg);
+
+  math::Vector<T> a;
+  math::Vector<T> b;
+  run(sendCorrelated(ext.sender, *ext.channels[0], deltas, a),
+      receiveCorrelated(ext.receiver, *ext.channels[1], choices, b));
+
+  REQUIRE(a.size() == n);
+  REQUIRE(b.size() == n);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (choices.at(i)) {
+      REQUIRE(b[i] == a[i] + deltas[i]);
+    } else {
+      REQUIRE(b[i] == a[i]);
+    }
+  }
+}
+
+TEST_CASE("OT IKNP errors", "[ot]") {
+  auto channels = net::LoopbackChannel::createPaired();
+  ot::IknpSender sender;
+  ot::IknpReceiver receiver;
+  auto rt = coro::DefaultRuntime::create();
+
+  REQUIRE_THROWS_MATCHES(
+      rt->run(sender.sendRandom(*channels[0], 10)),
+      std::logic_error,
+      Catch::Matchers::Message("OT extension has not been set up"));
+  REQUIRE_THROWS_MATCHES(
+      rt->run(receiver.receiveRandom(*channels[1], util::Bitmap(10))),
+      std::logic_error,
+      Catch::Matchers::Message("OT extension has not been set up"));
+
+  Extension ext;
+  Keys sender_keys;
+  std::vector<ot::Block> receiver_keys;
+  REQUIRE_THROWS_MATCHES(
+      run(sendRandom(ext.sender, *ext.channels[0], 1000, sender_keys),
+          receiveRandom(ext.receiver,
+                        *ext.channels[1],
+                        util::Bitmap(2000),
+                        receiver_keys)),
+      std::runtime_error,
+      Catch::Matchers::Message("unexpected size of OT extension message"));
+}
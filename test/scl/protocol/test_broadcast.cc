@@ -0,0 +1,135 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../net/util.h"
+#include "scl/coro/runtime.h"
+#include "scl/net/network.h"
+#include "scl/protocol/broadcast.h"
+
+using namespace scl;
+
+namespace {
+
+net::Packet message(std::size_t sender, std::size_t i) {
+  net::Packet packet;
+  for (std::size_t j = 0; j <= i; ++j) {
+    packet << static_cast<int>(sender * 100 + j);
+  }
+  return packet;
+}
+
+// Broadcast count messages from every party, receiving them from the others
+// in an order that depends on the party. Then check the transcripts.
+coro::Task<void> party(net::Network& network,
+                       proto::BroadcastChecker& checker,
+                       std::size_t count,
+                       std::string& error) {
+  const auto n = network.size();
+  const auto id = network.myId();
+  for (std::size_t i = 0; i < count; ++i) {
+    co_await checker.broadcast(network, message(id, i));
+  }
+  for (std::size_t k = 0; k < n; ++k) {
+    const auto sender = (id + k) % n;
+    if (sender == id) {
+      continue;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      auto packet = co_await checker.recv(network, sender);
+      if (packet != message(sender, i)) {
+        error = "wrong message";
+      }
+    }
+  }
+
+  try {
+    co_await checker.check(network);
+  } catch (const std::runtime_error& e) {
+    error = e.what();
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Broadcast check", "[proto]") {
+  const std::size_t n = 4;
+  auto networks = test::createLoopbackNetworks(n);
+  std::vector<proto::BroadcastChecker> checkers(n, proto::BroadcastChecker(n));
+  std::vector<std::string> errors(n);
+  auto rt = coro::DefaultRuntime::create();
+
+  for (const std::size_t count : {5, 0, 1}) {
+    std::vector<coro::Task<void>> parties;
+    for (std::size_t i = 0; i < n; ++i) {
+      parties.emplace_back(party(networks[i], checkers[i], count, errors[i]));
+    }
+    rt->run(test::runAll(std::move(parties)));
+
+    for (std::size_t i = 0; i < n; ++i) {
+      REQUIRE(errors[i].empty());
+      REQUIRE(checkers[i].pending() == 0);
+    }
+  }
+}
+
+TEST_CASE("Broadcast check inconsistent", "[proto]") {
+  const std::size_t n = 3;
+  auto networks = test::createLoopbackNetworks(n);
+  std::vector<proto::BroadcastChecker> checkers(n, proto::BroadcastChecker(n));
+  std::vector<std::string> errors(n);
+  auto rt = coro::DefaultRuntime::create();
+
+  // party 0 sends different messages to party 1 and 2, but records the first.
+  const auto m0 = message(0, 2);
+  const auto m1 = message(0, 3);
+  rt->run(networks[0].party(1)->send(m0));
+  rt->run(networks[0].party(2)->send(m1));
+  checkers[0].record(0, m0);
+  (void)rt->run(checkers[1].recv(networks[1], 0));
+  (void)rt->run(checkers[2].recv(networks[2], 0));
+  REQUIRE(checkers[2].pending() == 1);
+
+  std::vector<coro::Task<void>> parties;
+  for (std::size_t i = 0; i < n; ++i) {
+    parties.emplace_back(party(networks[i], checkers[i], 2, errors[i]));
+  }
+  rt->run(test::runAll(std::move(parties)));
+
+  // party 1 agrees with party 0, but both see that party 2 disagrees.
+  REQUIRE(errors[0] == "inconsistent broadcast from party 0");
+  REQUIRE(errors[1] == "inconsistent broadcast from party 0");
+  REQUIRE(errors[2] == "inconsistent broadcast from party 0");
+
+  // the next phase starts from scratch.
+  for (std::size_t i = 0; i < n; ++i) {
+    errors[i].clear();
+    REQUIRE(checkers[i].pending() == 0);
+  }
+  parties.clear();
+  for (std::size_t i = 0; i < n; ++i) {
+    parties.emplace_back(party(networks[i], checkers[i], 1, errors[i]));
+  }
+  rt->run(test::runAll(std::move(parties)));
+  for (std::size_t i = 0; i < n; ++i) {
+    REQUIRE(errors[i].empty());
+  }
+}
@@ -0,0 +1,143 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_exception.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../net/util.h"
+#include "scl/coro/runtime.h"
+#include "scl/math/fp.h"
+#include "scl/net/network.h"
+#include "scl/protocol/double_sharing.h"
+#include "scl/ss/shamir.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+using FF = math::Fp<61>;
+
+// Generate count double sharings twice with the same generators, and return
+// the shares of each party from the second call.
+std::vector<proto::DoubleSharings<FF>> generate(std::size_t n,
+                                                std::size_t t,
+                                                std::size_t count) {
+  auto networks = test::createLoopbackNetworks(n);
+  std::vector<proto::DoubleSharingGenerator<FF>> gens;
+  std::vector<util::PRG> prgs;
+  for (std::size_t i = 0; i < n; ++i) {
+    gens.emplace_back(n, t);
+    // PRG seeds are truncated to 16 bytes, so keep them short.
+    prgs.emplace_back(util::PRG::create("dealer " + std::to_string(i)));
+  }
+
+  std::vector<proto::DoubleSharings<FF>> out(n);
+  auto rt = coro::DefaultRuntime::create();
+  for (const auto c : {count + 5, count}) {
+    std::vector<coro::Task<void>> parties;
+    for (std::size_t i = 0; i < n; ++i) {
+      parties.emplace_back(gens[i].generate(networks[i], c, prgs[i], out[i]));
+    }
+    rt->run(test::runAll(std::move(parties)));
+  }
+  return out;
+}
+
+// Check that shares is a sharing of degree at most d, and return the secret.
+FF checkDegree(const math::Vector<FF>& shares, std::size_t d) {
+  const auto alphas = math::Vector<FF>::range(1, d + 2);
+  const auto first = shares.subVector(d + 1);
+  for (std::size_t i = d + 1; i < shares.size(); ++i) {
+    const auto y = ss::shamirRecoverP(first, alphas, FF(i + 1));
+    REQUIRE(y == shares[i]);
+  }
+  return ss::shamirRecoverP(first, alphas, FF(0));
+}
+
+}  // namespace
+
+TEST_CASE("Double sharing generator", "[proto]") {
+  for (const auto& [n, t] : {std::pair<std::size_t, std::size_t>{3, 1},
+                             {4, 1},
+                             {7, 3},
+                             {2, 0}}) {
+    for (const std::size_t count : {0, 1, 10, 1001}) {
+      const auto out = generate(n, t, count);
+
+      std::vector<FF> secrets;
+      for (std::size_t k = 0; k < count; ++k) {
+        math::Vector<FF> low(n);
+        math::Vector<FF> high(n);
+        for (std::size_t i = 0; i < n; ++i) {
+          REQUIRE(out[i].size() == count);
+          low[i] = out[i].low[k];
+          high[i] = out[i].high[k];
+        }
+
+        const auto s = checkDegree(low, t);
+        REQUIRE(checkDegree(high, 2 * t) == s);
+        secrets.emplace_back(s);
+      }
+
+      // the secrets are random, so all of them are different with
+      // overwhelming probability.
+      std::sort(secrets.begin(), secrets.end(), [](auto a, auto b) {
+        return a.toString() < b.toString();
+      });
+      REQUIRE(std::adjacent_find(secrets.begin(), secrets.end()) ==
+              secrets.end());
+    }
+  }
+}
+
+TEST_CASE("Double sharing generator errors", "[proto]") {
+  REQUIRE_THROWS_MATCHES(
+      proto::DoubleSharingGenerator<FF>(4, 2),
+      std::invalid_argument,
+      Catch::Matchers::Message("threshold must be less than n / 2"));
+
+  proto::DoubleSharingGenerator<FF> gen(5, 2);
+  REQUIRE(gen.parties() == 5);
+  REQUIRE(gen.threshold() == 2);
+  REQUIRE(gen.rate() == 3);
+
+  auto networks = test::createLoopbackNetworks(3);
+  auto prg = util::PRG::create("test_double_sharing errors");
+  auto rt = coro::DefaultRuntime::create();
+  REQUIRE_THROWS_MATCHES(
+      rt->run(gen.generate(networks[0], 10, prg)),
+      std::invalid_argument,
+      Catch::Matchers::Message("network has the wrong number of parties"));
+
+  // party 1 sends too little.
+  proto::DoubleSharingGenerator<FF> gen3(3, 1);
+  net::Packet packet;
+  packet << FF(1);
+  rt->run(networks[1].party(0)->send(packet));
+  rt->run(networks[2].party(0)->send(packet));
+  REQUIRE_THROWS_MATCHES(
+      rt->run(gen3.generate(networks[0], 10, prg)),
+      std::runtime_error,
+      Catch::Matchers::Message("unexpected size of double sharing message"));
+}
@@ -110,6 +110,41 @@ TEST_CASE("Simulate SendRecv protocol", "[sim]") {
   sim::simulate(std::make_unique<SendRecvManager>(2));
 }
 
+// Protocol where each party exchanges data with the other in several rounds.
+struct SendRecvRounds final : public proto::Protocol {
+  coro::Task<proto::ProtocolResult> run(proto::Env& env) const {
+    for (std::size_t i = 0; i < 10; i++) {
+      net::Packet p;
+      p << i;
+      co_await env.network.other()->send(p);
+      auto r = co_await env.network.other()->recv();
+    }
+
+    co_return proto::ProtocolResult::done();
+  }
+};
+
+TEST_CASE("Simulate SendRecv protocol many rounds", "[sim]") {
+  struct SendRecvRoundsManager final : public sim::Manager {
+    std::vector<std::unique_ptr<proto::Protocol>> protocol() override {
+      std::vector<std::unique_ptr<proto::Protocol>> p;
+      p.emplace_back(std::make_unique<SendRecvRounds>());
+      p.emplace_back(std::make_unique<SendRecvRounds>());
+      return p;
+    }
+
+    void handleSimulatorOutput(std::size_t /* ignored */,
+                               const sim::SimulationTrace& trace) override {
+      // start, begin, 10 x (send, recv), end, stop
+      REQUIRE(trace.size() == 24);
+      REQUIRE(trace[22]->type == sim::EventType::PROTOCOL_END);
+      REQUIRE(trace[23]->type == sim::EventType::STOP);
+    }
+  };
+
+  sim::simulate(std::make_unique<SendRecvRoundsManager>());
+}
+
 struct Sleepy final : public proto::Protocol {
   coro::Task<proto::ProtocolResult> run(proto::Env& /* ignored */) const {
     co_await 100s;
@@ -0,0 +1,220 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory_resource>
+
+#include "../math/fields.h"
+#include "scl/math/matrix.h"
+#include "scl/math/poly.h"
+#include "scl/math/vector.h"
+#include "scl/net/packet.h"
+#include "scl/util/arena.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+using FF = test::Mersenne61;
+
+// Memory resource which counts the allocations made through it.
+class CountingResource final : public std::pmr::memory_resource {
+ public:
+  std::size_t allocations = 0;
+  std::size_t outstanding = 0;
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    allocations++;
+    outstanding++;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p,
+                     std::size_t bytes,
+                     std::size_t alignment) override {
+    outstanding--;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+bool owns(const std::byte* begin, std::size_t size, const void* p) {
+  const auto* q = static_cast<const std::byte*>(p);
+  return q >= begin && q < begin + size;
+}
+
+}  // namespace
+
+TEST_CASE("Arena allocate", "[util]") {
+  CountingResource upstream;
+  {
+    util::Arena arena(64, &upstream);
+    REQUIRE(upstream.allocations == 1);
+    REQUIRE(arena.capacity() == 64);
+
+    auto* p0 = arena.allocate(3, 1);
+    auto* p1 = arena.allocate(8, 8);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(p1) % 8 == 0);
+    REQUIRE(static_cast<std::byte*>(p1) - static_cast<std::byte*>(p0) == 8);
+    REQUIRE(arena.allocated() == 11);
+
+    // does not fit in the first chunk.
+    (void)arena.allocate(100, 16);
+    REQUIRE(upstream.allocations == 2);
+    REQUIRE(arena.capacity() > 64 + 100);
+
+    // deallocation is a no-op.
+    arena.deallocate(p0, 3, 1);
+    REQUIRE(arena.allocated() == 111);
+  }
+  REQUIRE(upstream.outstanding == 0);
+}
+
+TEST_CASE("Arena reset", "[util]") {
+  CountingResource upstream;
+  util::Arena arena(16, &upstream);
+
+  for (std::size_t i = 0; i < 10; ++i) {
+    (void)arena.allocate(200, 8);
+  }
+  const auto cap = arena.capacity();
+  REQUIRE(upstream.outstanding > 1);
+
+  arena.reset();
+  REQUIRE(arena.allocated() == 0);
+  REQUIRE(arena.capacity() == cap);
+  REQUIRE(upstream.outstanding == 1);
+
+  // the same allocations now fit in the single coalesced chunk.
+  const auto allocations = upstream.allocations;
+  for (std::size_t i = 0; i < 10; ++i) {
+    (void)arena.allocate(200, 8);
+  }
+  REQUIRE(upstream.allocations == allocations);
+
+  REQUIRE(arena.is_equal(arena));
+  util::Arena other;
+  REQUIRE_FALSE(arena.is_equal(other));
+}
+
+TEST_CASE("Arena Vector", "[util][math]") {
+  CountingResource upstream;
+  util::Arena arena(1 << 12, &upstream);
+  auto prg = util::PRG::create("test_arena");
+
+  const auto x = math::Vector<FF>::random(10, prg, &arena);
+  const auto y = math::Vector<FF>::random(10, prg);
+  REQUIRE(x.resource() == &arena);
+  REQUIRE(x.container().get_allocator().resource() == &arena);
+  REQUIRE(y.resource() == std::pmr::get_default_resource());
+
+  const auto z = x.add(y).multiplyEntryWise(y).subVector(2, 5);
+  REQUIRE(z.resource() == &arena);
+  REQUIRE(y.add(x).resource() == std::pmr::get_default_resource());
+  REQUIRE(z[0] == (x[2] + y[2]) * y[2]);
+
+  // copies do not use the arena, moves do.
+  const auto copy = z;
+  REQUIRE(copy.resource() == std::pmr::get_default_resource());
+  REQUIRE(copy == z);
+  math::Vector<FF> moved(math::Vector<FF>(5, &arena));
+  REQUIRE(moved.resource() == &arena);
+  math::Vector<FF> copy_in_arena(y, &arena);
+  REQUIRE(copy_in_arena.resource() == &arena);
+  REQUIRE(copy_in_arena == y);
+
+  REQUIRE(upstream.allocations == 1);
+}
+
+TEST_CASE("Arena Matrix", "[util][math]") {
+  util::Arena arena;
+  auto prg = util::PRG::create("test_arena");
+
+  const auto a = math::Matrix<FF>::random(3, 4, prg, &arena);
+  const auto b = math::Matrix<FF>::random(4, 2, prg);
+  REQUIRE(a.resource() == &arena);
+
+  const auto c = a.multiply(b);
+  REQUIRE(c.resource() == &arena);
+  REQUIRE(c.equals(a.multiply(math::Matrix<FF>(b, &arena))));
+  REQUIRE(a.transpose().resource() == &arena);
+  REQUIRE(a.add(a).resource() == &arena);
+  REQUIRE(a.scalarMultiply(FF(2)).equals(a.add(a)));
+
+  const auto v = math::Vector<FF>::random(4, prg);
+  REQUIRE(a.multiply(v).resource() == &arena);
+
+  math::Matrix<FF> d(2, 2, &arena);
+  REQUIRE(d.resource() == &arena);
+  REQUIRE(math::Matrix<FF>(c).resource() == std::pmr::get_default_resource());
+}
+
+TEST_CASE("Arena Polynomial", "[util][math]") {
+  util::Arena arena;
+
+  const math::Vector<FF> c0({FF(1), FF(2), FF(3)});
+  const math::Vector<FF> c1({FF(4), FF(5)});
+  const auto p = math::Polynomial<FF>::create(math::Vector<FF>(c0, &arena));
+  const auto q = math::Polynomial<FF>::create(c1);
+  REQUIRE(p.resource() == &arena);
+  REQUIRE(q.resource() == std::pmr::get_default_resource());
+
+  const auto pq = p.multiply(q);
+  REQUIRE(pq.resource() == &arena);
+  REQUIRE(pq == math::Polynomial<FF>::create(c0).multiply(q));
+  REQUIRE(p.add(q).resource() == &arena);
+  REQUIRE(p.subtract(q).resource() == &arena);
+
+  const auto [d, r] = pq.divide(q);
+  REQUIRE(d.resource() == &arena);
+  REQUIRE(r.resource() == &arena);
+  REQUIRE(d == p);
+  REQUIRE(r.isZero());
+}
+
+TEST_CASE("Arena Packet", "[util][net]") {
+  util::Arena arena(1 << 12);
+  const auto* begin = static_cast<const std::byte*>(arena.allocate(1, 1));
+
+  net::Packet p(8, &arena);
+  REQUIRE(p.resource() == &arena);
+  REQUIRE(owns(begin, 1 << 12, p.get()));
+
+  for (int i = 0; i < 100; ++i) {
+    p << i;
+  }
+  REQUIRE(owns(begin, 1 << 12, p.get()));
+  for (int i = 0; i < 100; ++i) {
+    REQUIRE(p.read<int>() == i);
+  }
+
+  const net::Packet copy = p;
+  REQUIRE(copy.resource() == std::pmr::get_default_resource());
+  REQUIRE(copy == p);
+
+  net::Packet moved = std::move(p);
+  REQUIRE(moved.resource() == &arena);
+  REQUIRE(moved == copy);
+  REQUIRE(p.size() == 0);
+}
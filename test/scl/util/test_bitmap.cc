@@ -16,21 +16,32 @@
  */
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_exception.hpp>
 #include <sstream>
+#include <stdexcept>
+#include <vector>
 
 #include "scl/serialization/serializer.h"
 #include "scl/util/bitmap.h"
+#include "scl/util/cpu.h"
+#include "scl/util/prg.h"
 
 using namespace scl;
 
 TEST_CASE("Bitmap construct", "[util]") {
   util::Bitmap bm(10);
-  REQUIRE(bm.numberOfBlocks() == 2);
+  REQUIRE(bm.size() == 10);
+  REQUIRE(bm.numberOfBlocks() == 1);
   REQUIRE(bm.count() == 0);
 
   util::Bitmap bm0;
+  REQUIRE(bm0.size() == 0);
   REQUIRE(bm0.numberOfBlocks() == 1);
   REQUIRE(bm0.count() == 0);
+
+  util::Bitmap bm1(129);
+  REQUIRE(bm1.numberOfBlocks() == 3);
 }
 
 TEST_CASE("Bitmap get/set", "[util]") {
@@ -121,6 +132,103 @@ TEST_CASE("Bitmap NEG", "[util]") {
   REQUIRE(bm.at(0) == false);
   REQUIRE(bm.at(4) == false);
   REQUIRE(bm.at(5) == true);
+
+  // bits past the end are not flipped.
+  REQUIRE(bm.count() == 8);
+  REQUIRE(~bm == bm0);
+}
+
+TEST_CASE("Bitmap in-place operators", "[util]") {
+  util::Bitmap bm0(10);
+  util::Bitmap bm1(10);
+
+  bm0.set(1, true);
+  bm0.set(2, true);
+  bm1.set(2, true);
+  bm1.set(3, true);
+
+  auto bm = bm0;
+  bm &= bm1;
+  REQUIRE(bm == (bm0 & bm1));
+  bm = bm0;
+  bm |= bm1;
+  REQUIRE(bm == (bm0 | bm1));
+  bm = bm0;
+  bm ^= bm1;
+  REQUIRE(bm == (bm0 ^ bm1));
+  bm.flip();
+  REQUIRE(bm == ~(bm0 ^ bm1));
+
+  util::Bitmap bm2(11);
+  REQUIRE_THROWS_MATCHES(
+      bm0 &= bm2,
+      std::logic_error,
+      Catch::Matchers::Message("bitmaps are different sizes"));
+}
+
+TEST_CASE("Bitmap findNextSet", "[util]") {
+  util::Bitmap bm(200);
+  REQUIRE(bm.findNextSet(0) == 200);
+
+  bm.set(0, true);
+  bm.set(63, true);
+  bm.set(64, true);
+  bm.set(199, true);
+
+  std::vector<std::size_t> set;
+  for (auto i = bm.findNextSet(0); i < bm.size(); i = bm.findNextSet(i + 1)) {
+    set.emplace_back(i);
+  }
+  REQUIRE(set == std::vector<std::size_t>{0, 63, 64, 199});
+
+  REQUIRE(bm.findNextSet(65) == 199);
+  REQUIRE(bm.findNextSet(200) == 200);
+  REQUIRE(bm.findNextSet(1000) == 200);
+}
+
+TEST_CASE("Bitmap large", "[util]") {
+  const auto detected = util::cpu::detect();
+
+  // sizes that cover both full AVX2 registers and the remaining words.
+  const std::size_t n = 1000;
+  auto prg = util::PRG::create("bitmap large");
+  const auto r0 = prg.next(n);
+  const auto r1 = prg.next(n);
+
+  std::vector<bool> v0(n);
+  std::vector<bool> v1(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    v0[i] = r0[i] & 1;
+    v1[i] = r1[i] & 1;
+  }
+  const auto bm0 = util::Bitmap::fromStdVecBool(v0);
+  const auto bm1 = util::Bitmap::fromStdVecBool(v1);
+
+  for (const bool simd : {false, true}) {
+    auto f = detected;
+    f.avx2 = simd;
+    f.popcnt = simd;
+    util::cpu::restrict(f);
+
+    std::size_t count = 0;
+    bool ok = true;
+    const auto bm_and = bm0 & bm1;
+    const auto bm_or = bm0 | bm1;
+    const auto bm_xor = bm0 ^ bm1;
+    const auto bm_not = ~bm0;
+    for (std::size_t i = 0; i < n; ++i) {
+      count += v0[i];
+      ok &= bm_and.at(i) == (v0[i] && v1[i]);
+      ok &= bm_or.at(i) == (v0[i] || v1[i]);
+      ok &= bm_xor.at(i) == (v0[i] != v1[i]);
+      ok &= bm_not.at(i) == !v0[i];
+    }
+    REQUIRE(ok);
+    REQUIRE(bm0.count() == count);
+    REQUIRE(bm_not.count() == n - count);
+  }
+
+  util::cpu::restrict(detected);
 }
 
 TEST_CASE("Bitmap equal", "[util]") {
@@ -142,7 +250,7 @@ TEST_CASE("Bitmap print", "[util]") {
 
   std::stringstream ss;
   ss << bm;
-  REQUIRE(ss.str() == "0000010000000010");
+  REQUIRE(ss.str() == "0010000001");
 }
 
 TEST_CASE("Bitmap serialization", "[util]") {
@@ -152,8 +260,6 @@ TEST_CASE("Bitmap serialization", "[util]") {
   bm.set(2, true);
   bm.set(5, true);
 
-  REQUIRE(bm.numberOfBlocks() == 2);
-
   constexpr std::size_t overhead = sizeof(seri::StlVecSizeType);
   unsigned char buf[2 + overhead];
 
@@ -166,3 +272,23 @@ TEST_CASE("Bitmap serialization", "[util]") {
 
   REQUIRE(b == bm);
 }
+
+TEST_CASE("Bitmap serialization large", "[util]") {
+  util::Bitmap bm(300);
+  bm.set(0, true);
+  bm.set(100, true);
+  bm.set(299, true);
+
+  constexpr std::size_t overhead = sizeof(seri::StlVecSizeType);
+  const auto size = seri::Serializer<util::Bitmap>::sizeOf(bm);
+  REQUIRE(size == 38 + overhead);
+
+  std::vector<unsigned char> buf(size);
+  seri::Serializer<util::Bitmap>::write(bm, buf.data());
+
+  util::Bitmap b;
+  REQUIRE(seri::Serializer<util::Bitmap>::read(b, buf.data()) == size);
+  REQUIRE(b == bm);
+  REQUIRE(b.size() == 300);
+  REQUIRE(b.count() == 3);
+}
@@ -0,0 +1,218 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../math/fields.h"
+#include "scl/math/matrix.h"
+#include "scl/util/cache.h"
+#include "scl/util/paillier.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+using FF = test::Mersenne61;
+
+// Fresh directory for a test, removed again when the test ends.
+struct TempDir {
+  std::filesystem::path path;
+
+  explicit TempDir(const std::string& name)
+      : path(std::filesystem::temp_directory_path() / name) {
+    std::filesystem::remove_all(path);
+  }
+
+  ~TempDir() {
+    std::filesystem::remove_all(path);
+  }
+};
+
+}  // namespace
+
+TEST_CASE("PrecomputationCache get", "[util]") {
+  TempDir dir("scl_test_cache_get");
+  util::PrecomputationCache cache(dir.path);
+  REQUIRE(std::filesystem::is_directory(dir.path));
+
+  std::size_t computed = 0;
+  const auto compute = [&]() {
+    computed++;
+    return math::Matrix<FF>::hyperInvertible(5, 4);
+  };
+
+  const auto m0 = cache.get<math::Matrix<FF>>("hyperInvertible/5/4", compute);
+  const auto m1 = cache.get<math::Matrix<FF>>("hyperInvertible/5/4", compute);
+  REQUIRE(computed == 1);
+  REQUIRE(cache.hits() == 1);
+  REQUIRE(cache.misses() == 1);
+  REQUIRE(m0.equals(m1));
+
+  // other processes see the same file.
+  util::PrecomputationCache other(dir.path);
+  const auto m2 = other.get<math::Matrix<FF>>("hyperInvertible/5/4", compute);
+  REQUIRE(computed == 1);
+  REQUIRE(m2.equals(m0));
+
+  // keys are distinct per type.
+  const auto v = cache.get<math::Vector<FF>>("hyperInvertible/5/4", [] {
+    return math::Vector<FF>{FF(1), FF(2)};
+  });
+  REQUIRE(v.size() == 2);
+  REQUIRE(cache.misses() == 2);
+}
+
+TEST_CASE("PrecomputationCache load and store", "[util]") {
+  TempDir dir("scl_test_cache_load");
+  util::PrecomputationCache cache(dir.path);
+
+  REQUIRE(cache.load("key") == nullptr);
+
+  const std::vector<unsigned char> data = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  REQUIRE(cache.store("key", data.data(), data.size()));
+  auto mapping = cache.load("key");
+  REQUIRE(mapping != nullptr);
+  REQUIRE(std::vector<unsigned char>(mapping->data(),
+                                     mapping->data() + mapping->size()) ==
+          data);
+
+  REQUIRE(cache.store("empty", nullptr, 0));
+  REQUIRE(cache.load("empty") != nullptr);
+  REQUIRE(cache.load("empty")->size() == 0);
+
+  cache.erase("key");
+  REQUIRE(cache.load("key") == nullptr);
+  REQUIRE_FALSE(std::filesystem::exists(cache.path("key")));
+}
+
+TEST_CASE("PrecomputationCache concurrent store", "[util]") {
+  TempDir dir("scl_test_cache_concurrent");
+  util::PrecomputationCache cache(dir.path);
+
+  constexpr std::size_t THREADS = 4;
+  constexpr std::size_t STORES = 50;
+  std::vector<std::vector<unsigned char>> data;
+  for (std::size_t t = 0; t < THREADS; ++t) {
+    data.emplace_back(4096, static_cast<unsigned char>(t));
+  }
+
+  std::vector<std::thread> threads;
+  std::vector<std::size_t> stored(THREADS, 0);
+  for (std::size_t t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&, t] {
+      for (std::size_t i = 0; i < STORES; ++i) {
+        stored[t] += cache.store("key", data[t].data(), data[t].size());
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (const auto s : stored) {
+    REQUIRE(s == STORES);
+  }
+  auto mapping = cache.load("key");
+  REQUIRE(mapping != nullptr);
+  const std::vector<unsigned char> loaded(mapping->data(),
+                                          mapping->data() + mapping->size());
+  REQUIRE(loaded == data[loaded[0]]);
+
+  // no temporary files are left behind.
+  std::size_t files = 0;
+  for (const auto& entry :
+       std::filesystem::recursive_directory_iterator(dir.path)) {
+    files += entry.is_regular_file();
+  }
+  REQUIRE(files == 1);
+}
+
+TEST_CASE("PrecomputationCache invalid files", "[util]") {
+  TempDir dir("scl_test_cache_invalid");
+  util::PrecomputationCache cache(dir.path);
+
+  const std::vector<unsigned char> data(100, 42);
+  REQUIRE(cache.store("key", data.data(), data.size()));
+  const auto file = cache.path("key");
+
+  SECTION("corrupted payload") {
+    std::fstream f(file, std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(-1, std::ios::end);
+    f.put(0);
+    f.close();
+    REQUIRE(cache.load("key") == nullptr);
+  }
+
+  SECTION("truncated") {
+    std::filesystem::resize_file(file, std::filesystem::file_size(file) - 1);
+    REQUIRE(cache.load("key") == nullptr);
+    std::filesystem::resize_file(file, 10);
+    REQUIRE(cache.load("key") == nullptr);
+  }
+
+  SECTION("other version") {
+    std::fstream f(file, std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(8);
+    f.put(static_cast<char>(util::PrecomputationCache::VERSION + 1));
+    f.close();
+    REQUIRE(cache.load("key") == nullptr);
+  }
+
+  SECTION("recomputed") {
+    using T = std::vector<int>;
+    const auto compute = [] { return T{1, 2, 3}; };
+    const auto v = cache.get<T>("vec", compute);
+    const auto vec_file = cache.path(std::string(typeid(T).name()) + "/vec");
+    std::filesystem::resize_file(vec_file, 40);
+
+    REQUIRE(cache.get<T>("vec", compute) == v);
+    REQUIRE(cache.misses() == 2);
+
+    // the recomputed object was stored again.
+    REQUIRE(cache.get<T>("vec", [] { return T{}; }) == v);
+    REQUIRE(cache.hits() == 1);
+  }
+}
+
+TEST_CASE("PrecomputationCache Paillier", "[util]") {
+  TempDir dir("scl_test_cache_paillier");
+  util::PrecomputationCache cache(dir.path);
+
+  auto prg = util::PRG::create("test_cache");
+  const auto sk = util::Paillier::generate(512, prg, 1);
+
+  auto pk0 = sk.publicKey();
+  pk0.precompute(cache);
+  auto pk1 = sk.publicKey();
+  pk1.precompute(cache);
+  REQUIRE(pk1.hasPrecomputation());
+  REQUIRE(cache.hits() == 1);
+
+  auto prg0 = util::PRG::create("test_cache encrypt");
+  auto prg1 = util::PRG::create("test_cache encrypt");
+  const math::Number m(1234);
+  const auto c0 = util::Paillier::encrypt(pk0, m, prg0);
+  const auto c1 = util::Paillier::encrypt(pk1, m, prg1);
+  REQUIRE(c0 == c1);
+  REQUIRE(util::Paillier::decrypt(sk, c1) == m);
+}
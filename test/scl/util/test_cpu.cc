@@ -0,0 +1,143 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+#include "scl/util/aes.h"
+#include "scl/util/cpu.h"
+#include "scl/util/prg.h"
+#include "scl/util/sha256.h"
+
+using namespace scl;
+
+namespace {
+
+// All combinations of the features that util::AES and util::Sha256 use.
+std::vector<util::cpu::Features> featureSets() {
+  std::vector<util::cpu::Features> sets;
+  for (const bool aes : {false, true}) {
+    for (const bool vaes : {false, true}) {
+      for (const bool sha : {false, true}) {
+        util::cpu::Features f = util::cpu::detect();
+        f.aes = aes;
+        f.vaes = vaes;
+        f.sha = sha;
+        sets.emplace_back(f);
+      }
+    }
+  }
+  return sets;
+}
+
+}  // namespace
+
+TEST_CASE("CPU features detect", "[misc]") {
+  const auto detected = util::cpu::detect();
+
+  // VAES is only used together with AES-NI and AVX2.
+  if (detected.vaes) {
+    REQUIRE(detected.aes);
+    REQUIRE(detected.avx2);
+  }
+
+  util::cpu::restrict({});
+  const auto& f = util::cpu::features();
+  REQUIRE_FALSE(f.aes);
+  REQUIRE_FALSE(f.vaes);
+  REQUIRE_FALSE(f.sha);
+  REQUIRE_FALSE(f.avx2);
+
+  util::cpu::restrict(detected);
+  REQUIRE(f.aes == detected.aes);
+  REQUIRE(f.vaes == detected.vaes);
+  REQUIRE(f.sha == detected.sha);
+  REQUIRE(f.avx2 == detected.avx2);
+}
+
+TEST_CASE("CPU features PRG implementations agree", "[misc]") {
+  const auto detected = util::cpu::detect();
+
+  util::cpu::restrict({});
+  auto prg = util::PRG::create("0123456789abcdef");
+  const auto expected = prg.next(1000);
+
+  for (const auto& f : featureSets()) {
+    util::cpu::restrict(f);
+    auto prg0 = util::PRG::create("0123456789abcdef");
+    REQUIRE(prg0.next(1000) == expected);
+
+    // a number of blocks that is not a multiple of the number of blocks
+    // encrypted in parallel.
+    prg0.reset();
+    auto bytes = prg0.next(48);
+    const auto rest = prg0.next(1000 - 48);
+    bytes.insert(bytes.end(), rest.begin(), rest.end());
+    REQUIRE(bytes == expected);
+  }
+
+  util::cpu::restrict(detected);
+}
+
+TEST_CASE("CPU features AES implementations agree", "[misc]") {
+  const auto detected = util::cpu::detect();
+
+  const unsigned char key[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14};
+  constexpr std::size_t n = 21;
+  __m128i blocks[n];
+  for (std::size_t i = 0; i < n; ++i) {
+    blocks[i] = _mm_set_epi64x(static_cast<long>(i), static_cast<long>(3 * i));
+  }
+
+  util::cpu::restrict({});
+  __m128i expected[n];
+  util::AES(key).encrypt(blocks, expected, n);
+
+  for (const auto& f : featureSets()) {
+    util::cpu::restrict(f);
+    __m128i actual[n];
+    std::copy(blocks, blocks + n, actual);
+    util::AES(key).encrypt(actual, actual, n);
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto eq = _mm_cmpeq_epi8(actual[i], expected[i]);
+      REQUIRE(_mm_movemask_epi8(eq) == 0xFFFF);
+    }
+  }
+
+  util::cpu::restrict(detected);
+}
+
+TEST_CASE("CPU features Sha256 implementations agree", "[misc]") {
+  const auto detected = util::cpu::detect();
+
+  std::vector<unsigned char> data(1000);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<unsigned char>(i * 7);
+  }
+
+  util::cpu::restrict({});
+  const auto expected = util::Sha256{}.update(data).finalize();
+
+  for (const auto& f : featureSets()) {
+    util::cpu::restrict(f);
+    REQUIRE(util::Sha256{}.update(data).finalize() == expected);
+  }
+
+  util::cpu::restrict(detected);
+}
@@ -0,0 +1,160 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_exception.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cstdint>
+#include <stdexcept>
+
+#include "scl/util/histogram.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+TEST_CASE("Histogram empty", "[util]") {
+  util::Histogram h;
+  REQUIRE(h.empty());
+  REQUIRE(h.count() == 0);
+  REQUIRE(h.min() == 0);
+  REQUIRE(h.max() == 0);
+  REQUIRE(h.mean() == 0);
+  REQUIRE(h.stddev() == 0);
+  REQUIRE(h.percentile(50) == 0);
+}
+
+TEST_CASE("Histogram invalid arguments", "[util]") {
+  REQUIRE_THROWS_MATCHES(
+      util::Histogram(0),
+      std::invalid_argument,
+      Catch::Matchers::Message("invalid histogram precision"));
+  REQUIRE_THROWS_AS(util::Histogram(util::Histogram::MAX_PRECISION + 1),
+                    std::invalid_argument);
+
+  util::Histogram h;
+  REQUIRE_THROWS_MATCHES(
+      h.percentile(101),
+      std::invalid_argument,
+      Catch::Matchers::Message("percentile must be in the range [0, 100]"));
+  REQUIRE_THROWS_AS(h.percentile(-1), std::invalid_argument);
+
+  util::Histogram g(3);
+  REQUIRE_THROWS_MATCHES(
+      h.merge(g),
+      std::invalid_argument,
+      Catch::Matchers::Message(
+          "cannot merge histograms of different precision"));
+}
+
+TEST_CASE("Histogram small values are exact", "[util]") {
+  util::Histogram h(4);
+
+  // values below 2^5 have their own bucket when the precision is 4.
+  for (std::uint64_t v = 1; v <= 20; ++v) {
+    h.record(v);
+  }
+
+  REQUIRE(h.count() == 20);
+  REQUIRE(h.min() == 1);
+  REQUIRE(h.max() == 20);
+  REQUIRE(h.mean() == 10.5);
+  REQUIRE(h.percentile(0) == 1);
+  REQUIRE(h.percentile(50) == 10);
+  REQUIRE(h.percentile(90) == 18);
+  REQUIRE(h.percentile(100) == 20);
+}
+
+TEST_CASE("Histogram relative error", "[util]") {
+  const std::size_t precision = 7;
+  util::Histogram h(precision);
+
+  // 1, 2, ..., 100000 recorded in reverse order.
+  const std::uint64_t n = 100000;
+  for (std::uint64_t v = n; v > 0; --v) {
+    h.record(v);
+  }
+
+  REQUIRE(h.count() == n);
+  REQUIRE(h.min() == 1);
+  REQUIRE(h.max() == n);
+
+  for (const double p : {1.0, 25.0, 50.0, 90.0, 99.0, 99.9}) {
+    const auto exact = static_cast<std::uint64_t>(p / 100 * n);
+    const auto v = h.percentile(p);
+    REQUIRE(v >= exact);
+    REQUIRE(v - exact <= (exact >> precision));
+  }
+}
+
+TEST_CASE("Histogram large values", "[util]") {
+  util::Histogram h;
+  const std::uint64_t big = ~std::uint64_t(0);
+  h.record(big);
+  h.record(1);
+
+  REQUIRE(h.max() == big);
+  REQUIRE(h.percentile(100) == big);
+  REQUIRE(h.percentile(50) == 1);
+}
+
+TEST_CASE("Histogram record count", "[util]") {
+  util::Histogram h;
+  h.record(10, 3);
+  h.record(20, 0);
+  h.record(20);
+
+  REQUIRE(h.count() == 4);
+  REQUIRE(h.mean() == 12.5);
+  REQUIRE(h.var() == 25);
+  REQUIRE(h.stddev() == 5);
+  REQUIRE(h.percentile(75) == 10);
+  REQUIRE(h.percentile(76) == 20);
+}
+
+TEST_CASE("Histogram merge", "[util]") {
+  auto prg = util::PRG::create("histogram merge");
+
+  util::Histogram all;
+  util::Histogram h0;
+  util::Histogram h1;
+
+  for (std::size_t i = 0; i < 1000; ++i) {
+    unsigned char buf[3];
+    prg.next(buf, sizeof(buf));
+    const std::uint64_t v = buf[0] | (buf[1] << 8) | (buf[2] << 16);
+
+    all.record(v);
+    (i % 3 == 0 ? h0 : h1).record(v);
+  }
+
+  util::Histogram empty;
+  h0.merge(empty);
+  empty.merge(h0);
+  REQUIRE(empty.count() == h0.count());
+  REQUIRE(empty.min() == h0.min());
+
+  h0.merge(h1);
+
+  REQUIRE(h0.count() == all.count());
+  REQUIRE(h0.min() == all.min());
+  REQUIRE(h0.max() == all.max());
+  REQUIRE_THAT(h0.mean(), Catch::Matchers::WithinRel(all.mean(), 1e-9));
+  REQUIRE_THAT(h0.stddev(), Catch::Matchers::WithinRel(all.stddev(), 1e-9));
+  for (const double p : {0.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+    REQUIRE(h0.percentile(p) == all.percentile(p));
+  }
+}
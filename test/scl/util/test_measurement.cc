@@ -118,3 +118,82 @@ TEST_CASE("Measurement median", "[util]") {
   REQUIRE(dm.median() == 282.5);
   REQUIRE(tm.median() == 282.5s);
 }
+
+TEST_CASE("Measurement median unsorted", "[util]") {
+  util::DataMeasurement dm;
+  dm.addSample(9);
+  dm.addSample(1);
+  dm.addSample(5);
+
+  REQUIRE(dm.median() == 5);
+  // median does not reorder the samples.
+  REQUIRE(dm.samples() == std::vector<long double>{9, 1, 5});
+
+  dm.addSample(2);
+  REQUIRE(dm.median() == 3.5);
+
+  util::TimeMeasurement tm;
+  tm.addSample(10s);
+  tm.addSample(40s);
+  tm.addSample(20s);
+  tm.addSample(30s);
+  tm.addSample(1s);
+  REQUIRE(tm.median() == 20s);
+}
+
+TEST_CASE("StreamingMeasurement percentiles", "[util]") {
+  util::StreamingTimeMeasurement tm;
+  REQUIRE(tm.empty());
+  REQUIRE(tm.median() == 0s);
+
+  for (int i = 1000; i > 0; --i) {
+    tm.addSample(std::chrono::milliseconds(i));
+  }
+
+  REQUIRE(tm.size() == 1000);
+  REQUIRE(tm.min() == 1ms);
+  REQUIRE(tm.max() == 1000ms);
+  REQUIRE(tm.mean() == 500.5ms);
+  REQUIRE_THAT(util::timeToMillis(tm.median()),
+               Catch::Matchers::WithinRel(500.0, 0.01));
+  REQUIRE_THAT(util::timeToMillis(tm.percentile(99)),
+               Catch::Matchers::WithinRel(990.0, 0.01));
+  REQUIRE_THAT(util::timeToMillis(tm.percentile(99.9)),
+               Catch::Matchers::WithinRel(999.0, 0.01));
+}
+
+TEST_CASE("StreamingMeasurement merge", "[util]") {
+  util::StreamingDataMeasurement dm0;
+  util::StreamingDataMeasurement dm1;
+  dm0.addSample(123.42);
+  dm1.addSample(555.21);
+  dm0.merge(dm1);
+
+  REQUIRE(dm0.size() == 2);
+  REQUIRE(dm0.min() == 123);
+  REQUIRE(dm0.max() == 555);
+  REQUIRE(dm0.mean() == 339);
+  REQUIRE_THAT(dm0.stddev(), Catch::Matchers::WithinRel(305.47, 0.001));
+}
+
+TEST_CASE("StreamingMeasurement to string", "[util]") {
+  util::StreamingDataMeasurement dm;
+  dm.addSample(100);
+
+  std::stringstream ss;
+  ss << dm;
+  REQUIRE(ss.str() ==
+          "{\"mean\": 100, \"unit\": \"B\", \"std_dev\": 0, \"min\": 100, "
+          "\"p50\": 100, \"p90\": 100, \"p99\": 100, \"p999\": 100, "
+          "\"max\": 100, \"count\": 1}");
+
+  util::StreamingTimeMeasurement tm;
+  tm.addSample(2ms);
+
+  ss.str("");
+  ss << tm;
+  REQUIRE(ss.str() ==
+          "{\"mean\": 2, \"unit\": \"ms\", \"std_dev\": 0, \"min\": 2, "
+          "\"p50\": 2, \"p90\": 2, \"p99\": 2, \"p999\": 2, \"max\": 2, "
+          "\"count\": 1}");
+}
@@ -0,0 +1,152 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_exception.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "scl/net/packet.h"
+#include "scl/util/paillier.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+using Number = math::Number;
+using Paillier = util::Paillier;
+
+namespace {
+
+// keys are a bit expensive to generate, so use a single one for most tests.
+const Paillier::SecretKey& testKey() {
+  static const auto sk = [] {
+    auto prg = util::PRG::create("test paillier key");
+    return Paillier::generate(512, prg);
+  }();
+  return sk;
+}
+
+}  // namespace
+
+TEST_CASE("Paillier keygen", "[util]") {
+  const auto& sk = testKey();
+  const auto& pk = sk.publicKey();
+  REQUIRE(pk.n().bitSize() == 512);
+  REQUIRE(sk.p().bitSize() == 256);
+  REQUIRE(sk.q().bitSize() == 256);
+  REQUIRE(sk.p() * sk.q() == pk.n());
+  REQUIRE(pk.n2() == pk.n() * pk.n());
+  REQUIRE_FALSE(pk.hasPrecomputation());
+
+  REQUIRE_THROWS_MATCHES(
+      Paillier::SecretKey(sk.p(), sk.p(), pk.hn()),
+      std::invalid_argument,
+      Catch::Matchers::Message("p and q must be different"));
+}
+
+TEST_CASE("Paillier encrypt decrypt", "[util]") {
+  auto prg = util::PRG::create("test paillier encrypt");
+  const auto& sk = testKey();
+  auto pk = sk.publicKey();
+
+  const auto m = Number::random(400, prg) % pk.n();
+  const auto c0 = Paillier::encrypt(pk, m, prg);
+  const auto c1 = Paillier::encrypt(pk, m, prg);
+  REQUIRE_FALSE(c0 == c1);
+  REQUIRE(Paillier::decrypt(sk, c0) == m);
+  REQUIRE(Paillier::decrypt(sk, c1) == m);
+
+  REQUIRE(Paillier::decrypt(sk, Paillier::encrypt(pk, Number(0), prg)) ==
+          Number(0));
+  REQUIRE(Paillier::decrypt(sk, Paillier::encrypt(pk, Number(-1), prg)) ==
+          pk.n() - Number(1));
+
+  // the precomputed table gives the same ciphertexts.
+  auto prg0 = util::PRG::create("precompute");
+  auto prg1 = util::PRG::create("precompute");
+  const auto c2 = Paillier::encrypt(pk, m, prg0);
+  pk.precompute();
+  REQUIRE(pk.hasPrecomputation());
+  const auto c3 = Paillier::encrypt(pk, m, prg1);
+  REQUIRE(c2 == c3);
+  REQUIRE(Paillier::decrypt(sk, c3) == m);
+}
+
+TEST_CASE("Paillier homomorphism", "[util]") {
+  auto prg = util::PRG::create("test paillier homomorphism");
+  const auto& sk = testKey();
+  const auto& pk = sk.publicKey();
+
+  const auto a = Number::random(300, prg) % pk.n();
+  const auto b = Number::random(300, prg) % pk.n();
+  const auto k = Number::random(100, prg);
+  const auto ca = Paillier::encrypt(pk, a, prg);
+  const auto cb = Paillier::encrypt(pk, b, prg);
+
+  REQUIRE(Paillier::decrypt(sk, Paillier::add(pk, ca, cb)) ==
+          (a + b) % pk.n());
+  REQUIRE(Paillier::decrypt(sk, Paillier::scalarMultiply(pk, ca, k)) ==
+          (a * k) % pk.n());
+
+  // a * k + b, as in OLE.
+  const auto ole = Paillier::add(pk, Paillier::scalarMultiply(pk, ca, k), cb);
+  REQUIRE(Paillier::decrypt(sk, ole) == (a * k + b) % pk.n());
+}
+
+TEST_CASE("Paillier batch", "[util]") {
+  const auto& sk = testKey();
+  auto pk = sk.publicKey();
+  pk.precompute();
+
+  std::vector<Number> ms;
+  for (int i = 0; i < 20; ++i) {
+    ms.emplace_back(i * 1000);
+  }
+
+  auto prg0 = util::PRG::create("batch");
+  auto prg1 = util::PRG::create("batch");
+  const auto cs = Paillier::encrypt(pk, ms, prg0, 4);
+  REQUIRE(cs.size() == ms.size());
+  for (std::size_t i = 0; i < ms.size(); ++i) {
+    REQUIRE(cs[i] == Paillier::encrypt(pk, ms[i], prg1));
+  }
+
+  REQUIRE(Paillier::decrypt(sk, cs, 3) == ms);
+  REQUIRE(Paillier::decrypt(sk, cs, 0) == ms);
+  REQUIRE(Paillier::decrypt(sk, std::vector<Paillier::Ciphertext>{}).empty());
+}
+
+TEST_CASE("Paillier serialization", "[util]") {
+  auto prg = util::PRG::create("test paillier serialization");
+  const auto& sk = testKey();
+  const auto& pk = sk.publicKey();
+  const auto c = Paillier::encrypt(pk, Number(1234), prg);
+
+  net::Packet packet;
+  packet << pk << sk << c;
+
+  const auto pk_read = packet.read<Paillier::PublicKey>();
+  const auto sk_read = packet.read<Paillier::SecretKey>();
+  const auto c_read = packet.read<Paillier::Ciphertext>();
+  REQUIRE(packet.remaining() == 0);
+
+  REQUIRE(pk_read == pk);
+  REQUIRE(sk_read.publicKey() == pk);
+  REQUIRE(sk_read.p() == sk.p());
+  REQUIRE(c_read == c);
+  REQUIRE(Paillier::decrypt(sk_read, c_read) == Number(1234));
+}
@@ -0,0 +1,159 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_exception.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../math/fields.h"
+#include "scl/math/matrix.h"
+#include "scl/math/vector.h"
+#include "scl/util/parallel.h"
+#include "scl/util/prg.h"
+
+using namespace scl;
+
+namespace {
+
+using FF = test::Mersenne61;
+
+}  // namespace
+
+TEST_CASE("ThreadPool run", "[util]") {
+  util::ThreadPool pool(3);
+  REQUIRE(pool.workers() == 3);
+
+  std::vector<int> hits(1000, 0);
+  pool.run(hits.size(), [&](std::size_t i) { hits[i]++; });
+  REQUIRE(hits == std::vector<int>(1000, 1));
+
+  // tasks may start batches of their own.
+  std::atomic<std::size_t> count = 0;
+  pool.run(8, [&](std::size_t) {
+    pool.run(8, [&](std::size_t) { count++; });
+  });
+  REQUIRE(count == 64);
+
+  util::ThreadPool empty(0);
+  count = 0;
+  empty.run(10, [&](std::size_t) { count++; });
+  REQUIRE(count == 10);
+}
+
+TEST_CASE("ThreadPool exception", "[util]") {
+  util::ThreadPool pool(2);
+  std::atomic<std::size_t> count = 0;
+  REQUIRE_THROWS_MATCHES(pool.run(100,
+                                  [&](std::size_t i) {
+                                    count++;
+                                    if (i == 10) {
+                                      throw std::runtime_error("task");
+                                    }
+                                  }),
+                         std::runtime_error,
+                         Catch::Matchers::Message("task"));
+  REQUIRE(count == 100);
+}
+
+TEST_CASE("parallelFor and parallelReduce", "[util]") {
+  util::ThreadPool pool(3);
+  const util::Parallel policy{.grain = 7, .pool = &pool};
+
+  std::vector<std::size_t> v(100);
+  util::parallelFor(v.size(), policy, [&](std::size_t b, std::size_t e) {
+    REQUIRE(e - b <= 7);
+    for (auto i = b; i < e; ++i) {
+      v[i] = i;
+    }
+  });
+
+  // partial results are combined in chunk order.
+  const auto order = util::parallelReduce<std::string>(
+      v.size(),
+      policy,
+      [&](std::size_t b, std::size_t e) {
+        std::string r;
+        for (auto i = b; i < e; ++i) {
+          r += std::to_string(v[i]) + ",";
+        }
+        return r;
+      });
+  std::string expected;
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    expected += std::to_string(i) + ",";
+  }
+  REQUIRE(order == expected);
+
+  const auto none = util::parallelReduce<int>(
+      0,
+      policy,
+      [](std::size_t b, std::size_t e) { return static_cast<int>(e - b); });
+  REQUIRE(none == 0);
+}
+
+TEST_CASE("PRG parallel", "[util]") {
+  util::ThreadPool pool(3);
+  const util::Parallel policy{.grain = 5, .pool = &pool};
+
+  auto prg0 = util::PRG::create("test_parallel");
+  auto prg1 = util::PRG::create("test_parallel");
+  std::vector<unsigned char> a(1000);
+  std::vector<unsigned char> b(1000);
+  prg0.next(a.data(), 3);
+  prg1.next(b.data(), 3);
+  prg0.next(a.data() + 3, a.size() - 3);
+  prg1.next(b.data() + 3, b.size() - 3, policy);
+  REQUIRE(a == b);
+  REQUIRE(prg0.next(16) == prg1.next(16));
+}
+
+TEST_CASE("Vector parallel", "[util][math]") {
+  util::ThreadPool pool(3);
+  const util::Parallel policy{.grain = 10, .pool = &pool};
+
+  auto prg0 = util::PRG::create("test_parallel");
+  auto prg1 = util::PRG::create("test_parallel");
+  const auto x = math::Vector<FF>::random(1001, prg0);
+  REQUIRE(math::Vector<FF>::random(1001, prg1, policy) == x);
+  const auto y = math::Vector<FF>::random(1001, prg0);
+
+  REQUIRE(x.add(y, policy) == x.add(y));
+  REQUIRE(x.subtract(y, policy) == x.subtract(y));
+  REQUIRE(x.multiplyEntryWise(y, policy) == x.multiplyEntryWise(y));
+  REQUIRE(x.dot(y, policy) == x.dot(y));
+  REQUIRE(x.add(y, util::par) == x.add(y));
+
+  const math::Vector<FF> z(5);
+  REQUIRE_THROWS_AS(x.add(z, policy), std::invalid_argument);
+  REQUIRE_THROWS_AS(x.dot(z, policy), std::invalid_argument);
+}
+
+TEST_CASE("Matrix parallel", "[util][math]") {
+  util::ThreadPool pool(3);
+  const util::Parallel policy{.grain = 30, .pool = &pool};
+
+  auto prg = util::PRG::create("test_parallel");
+  const auto a = math::Matrix<FF>::random(50, 13, prg);
+  const auto v = math::Vector<FF>::random(13, prg);
+  REQUIRE(a.multiply(v, policy) == a.multiply(v));
+
+  const auto w = math::Vector<FF>::random(12, prg);
+  REQUIRE_THROWS_AS(a.multiply(w, policy), std::invalid_argument);
+}
@@ -23,6 +23,7 @@
 #include <iostream>
 #include <stdexcept>
 
+#include "scl/util/aes.h"
 #include "scl/util/prg.h"
 
 using namespace scl;
@@ -123,3 +124,30 @@ TEST_CASE("PRG truncate seed on create", "[misc]") {
 
   REQUIRE(bytes0 == bytes1);
 }
+
+TEST_CASE("AES known answer", "[misc]") {
+  // FIPS-197, Appendix C.1.
+  unsigned char key[16];
+  unsigned char pt[16];
+  for (unsigned char i = 0; i < 16; ++i) {
+    key[i] = i;
+    pt[i] = static_cast<unsigned char>(i * 0x11);
+  }
+  const unsigned char expected[16] = {0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b,
+                                      0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80,
+                                      0x70, 0xb4, 0xc5, 0x5a};
+
+  const util::AES aes(key);
+
+  // enough blocks for the parallel code paths, and encrypting in-place.
+  __m128i blocks[19];
+  for (auto& b : blocks) {
+    b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pt));
+  }
+  aes.encrypt(blocks, blocks, 19);
+  for (const auto& b : blocks) {
+    unsigned char ct[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(ct), b);
+    REQUIRE(std::memcmp(ct, expected, 16) == 0);
+  }
+}
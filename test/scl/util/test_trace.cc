@@ -0,0 +1,118 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "scl/util/trace.h"
+
+using namespace scl;
+
+namespace {
+
+std::string chromeTrace() {
+  std::stringstream ss;
+  util::trace::writeChromeTrace(ss);
+  return ss.str();
+}
+
+std::size_t count(const std::string& str, const std::string& what) {
+  std::size_t n = 0;
+  for (auto p = str.find(what); p != std::string::npos;
+       p = str.find(what, p + 1)) {
+    n++;
+  }
+  return n;
+}
+
+}  // namespace
+
+TEST_CASE("Trace spans", "[util]") {
+  util::trace::clear();
+  {
+    util::trace::Span span("test", "sync");
+    util::trace::AsyncSpan async_span("test", "async");
+  }
+
+  const auto trace = chromeTrace();
+  REQUIRE(trace.starts_with("{\"traceEvents\": ["));
+  REQUIRE(trace.ends_with("], \"displayTimeUnit\": \"ns\"}\n"));
+  REQUIRE(count(trace, R"("name": "sync", "cat": "test", "ph": "X")") == 1);
+  REQUIRE(count(trace, R"("name": "async", "cat": "test", "ph": "b")") == 1);
+  REQUIRE(count(trace, R"("name": "async", "cat": "test", "ph": "e")") == 1);
+  REQUIRE(count(trace, R"("dur": )") == 1);
+
+  util::trace::clear();
+  REQUIRE(chromeTrace() ==
+          "{\"traceEvents\": [\n], \"displayTimeUnit\": \"ns\"}\n");
+}
+
+TEST_CASE("Trace async ids", "[util]") {
+  const auto id0 = util::trace::nextAsyncId();
+  const auto id1 = util::trace::nextAsyncId();
+  REQUIRE(id0 != 0);
+  REQUIRE(id1 > id0);
+}
+
+TEST_CASE("Trace threads", "[util]") {
+  util::trace::clear();
+  std::thread thread([]() { util::trace::Span span("test", "thread"); });
+  thread.join();
+  { util::trace::Span span("test", "main"); }
+
+  // events recorded by a thread survive the thread.
+  const auto trace = chromeTrace();
+  REQUIRE(count(trace, "\"name\": \"thread\"") == 1);
+  REQUIRE(count(trace, "\"name\": \"main\"") == 1);
+  util::trace::clear();
+}
+
+TEST_CASE("Trace ring buffer", "[util]") {
+  util::trace::clear();
+  auto& buffer = util::trace::threadBuffer();
+
+  const std::size_t n = util::trace::Buffer::CAPACITY + 10;
+  for (std::size_t i = 0; i < n; ++i) {
+    buffer.push({"test", "event", i, i + 1, 0});
+  }
+
+  REQUIRE(buffer.pushed() == n);
+  // the oldest events were overwritten.
+  REQUIRE(buffer.at(0).begin == util::trace::Buffer::CAPACITY);
+  REQUIRE(buffer.at(n - 1).begin == n - 1);
+  REQUIRE(count(chromeTrace(), "\"ph\": \"X\"") ==
+          util::trace::Buffer::CAPACITY);
+  util::trace::clear();
+}
+
+TEST_CASE("Trace macros", "[util]") {
+  util::trace::clear();
+  auto& buffer = util::trace::threadBuffer();
+  {
+    SCL_TRACE_SPAN("test", "macro");
+    SCL_TRACE_ASYNC_SPAN("test", "macro async");
+  }
+
+#ifdef SCL_ENABLE_TRACING
+  REQUIRE(buffer.pushed() == 2);
+#else
+  REQUIRE(buffer.pushed() == 0);
+#endif
+}
@@ -0,0 +1,152 @@
+/* SCL --- Secure Computation Library
+ * Copyright (C) 2024 Anders Dalskov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_exception.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "scl/util/bitmap.h"
+#include "scl/util/cpu.h"
+#include "scl/util/prg.h"
+#include "scl/util/transpose.h"
+
+using namespace scl;
+
+namespace {
+
+bool bit(const unsigned char* row, std::size_t j) {
+  return ((row[j / 8] >> (j % 8)) & 1) == 1;
+}
+
+// Check that out is the transpose of in, and that the padding bits of out are
+// 0.
+bool isTranspose(const std::vector<unsigned char>& in,
+                 std::size_t in_stride,
+                 const std::vector<unsigned char>& out,
+                 std::size_t out_stride,
+                 std::size_t rows,
+                 std::size_t cols) {
+  bool ok = true;
+  for (std::size_t c = 0; c < cols; ++c) {
+    const auto* column = out.data() + c * out_stride;
+    for (std::size_t r = 0; r < rows; ++r) {
+      ok &= bit(column, r) == bit(in.data() + r * in_stride, c);
+    }
+    for (std::size_t r = rows; r < (rows + 7) / 8 * 8; ++r) {
+      ok &= !bit(column, r);
+    }
+  }
+  return ok;
+}
+
+}  // namespace
+
+TEST_CASE("Transpose bits", "[util]") {
+  const auto detected = util::cpu::detect();
+  auto prg = util::PRG::create("test_transpose");
+
+  const std::vector<std::pair<std::size_t, std::size_t>> sizes = {
+      {128, 128},
+      {128, 4096},
+      {4096, 128},
+      {1024, 1024},
+      {32, 8},
+      {16, 128},
+      {48, 136},
+      {7, 9},
+      {1, 1},
+      {0, 10},
+      {10, 0},
+      {130, 1000},
+      {600, 700},
+  };
+
+  for (const auto& [rows, cols] : sizes) {
+    // rows of the input have a few bytes of padding that must not be read.
+    const auto in_stride = (cols + 7) / 8 + 3;
+    const auto out_stride = (rows + 7) / 8;
+    const auto in = prg.next(rows * in_stride);
+
+    for (const bool avx2 : {false, true}) {
+      auto f = detected;
+      f.avx2 = avx2;
+      util::cpu::restrict(f);
+
+      std::vector<unsigned char> out(cols * out_stride, 0xFF);
+      util::transposeBits(in.data(),
+                          in_stride,
+                          out.data(),
+                          out_stride,
+                          rows,
+                          cols);
+      REQUIRE(isTranspose(in, in_stride, out, out_stride, rows, cols));
+    }
+  }
+
+  util::cpu::restrict(detected);
+}
+
+TEST_CASE("Transpose bits twice", "[util]") {
+  auto prg = util::PRG::create("test_transpose twice");
+  const std::size_t rows = 256;
+  const std::size_t cols = 384;
+
+  const auto in = prg.next(rows * cols / 8);
+  std::vector<unsigned char> out(rows * cols / 8);
+  std::vector<unsigned char> back(rows * cols / 8);
+  util::transposeBits(in.data(), cols / 8, out.data(), rows / 8, rows, cols);
+  util::transposeBits(out.data(), rows / 8, back.data(), cols / 8, cols, rows);
+  REQUIRE(back == in);
+}
+
+TEST_CASE("Transpose bitmaps", "[util]") {
+  auto prg = util::PRG::create("test_transpose bitmaps");
+  const std::size_t n = 100;
+  const std::size_t m = 70;
+
+  std::vector<util::Bitmap> rows;
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto bits = prg.next(m);
+    auto& row = rows.emplace_back(m);
+    for (std::size_t j = 0; j < m; ++j) {
+      row.set(j, bits[j] & 1);
+    }
+  }
+
+  const auto columns = util::transposeBits(rows);
+  REQUIRE(columns.size() == m);
+  bool ok = true;
+  for (std::size_t j = 0; j < m; ++j) {
+    ok &= columns[j].size() == n;
+    for (std::size_t i = 0; i < n; ++i) {
+      ok &= columns[j].at(i) == rows[i].at(j);
+    }
+  }
+  REQUIRE(ok);
+  REQUIRE(util::transposeBits(columns) == rows);
+
+  REQUIRE(util::transposeBits(std::vector<util::Bitmap>{}).empty());
+
+  rows.back() = util::Bitmap(m + 1);
+  REQUIRE_THROWS_MATCHES(
+      util::transposeBits(rows),
+      std::invalid_argument,
+      Catch::Matchers::Message("rows must have the same size"));
+}